@@ -2,6 +2,7 @@
 
 // C library API
 const ffi = require('ffi-napi');
+const ref = require('ref-napi');
 
 // Express App (Routes)
 const express = require("express");
@@ -52,6 +53,7 @@ app.post('/upload', function(req, res) {
     if(err) {
       return res.status(500).send(err);
     }
+    fs.rmSync('uploads/' + uploadFile.name + '.journal', { force: true }); // the edits of the file that was replaced
 
     res.redirect('/');
   });
@@ -61,6 +63,15 @@ app.post('/upload', function(req, res) {
 app.get('/uploads/:name', function(req , res){
   fs.stat('uploads/' + req.params.name, function(err, stat) {
     if(err == null) {
+      // the edits still in the journal are written into the file first, so the file sent has them
+      if (fs.existsSync('uploads/' + req.params.name + '.journal') && !sharedLib.compactJournal('uploads/' + req.params.name)) {
+        console.log("Could not write the journal into " + req.params.name + ", the file is sent without its edits");
+      }
+      // .svgz files are sent as they are, the browser decompresses them
+      if (isGzipFile('uploads/' + req.params.name)) {
+        res.set('Content-Encoding', 'gzip');
+        res.type('image/svg+xml');
+      }
       res.sendFile(path.join(__dirname+'/uploads/' + req.params.name));
     } else {
       console.log('Error in file downloading route: '+err);
@@ -80,17 +91,262 @@ let sharedLib = ffi.Library('./libsvgparser', {
   'getCircsJSON' : [ 'string', [ 'string'] ],
   'getPathsJSON' : [ 'string', [ 'string'] ],
   'getGroupsJSON' : [ 'string', [ 'string'] ],
+  'getRectsJSONRange' : [ 'string', [ 'string', 'int', 'int' ] ],
+  'getCircsJSONRange' : [ 'string', [ 'string', 'int', 'int' ] ],
+  'getPathsJSONRange' : [ 'string', [ 'string', 'int', 'int' ] ],
+  'getGroupsJSONRange' : [ 'string', [ 'string', 'int', 'int' ] ],
+  'getLinesJSON' : [ 'string', [ 'string'] ],
+  'getEllipsesJSON' : [ 'string', [ 'string'] ],
+  'getPolylinesJSON' : [ 'string', [ 'string'] ],
+  'getPolygonsJSON' : [ 'string', [ 'string'] ],
   'getAttributesJSON' : [ 'string', [ 'string', 'string', 'int'] ],
+  'getAttributesAtPathJSON' : [ 'string', [ 'string', 'string' ] ],
+  'queryRegionJSON' : [ 'string', [ 'string', 'float', 'float', 'float', 'float' ] ],
+  'hitTestJSON' : [ 'string', [ 'string', 'float', 'float' ] ],
+  'selectCount' : [ 'int', [ 'string', 'string' ] ],
+  'selectJSON' : [ 'string', [ 'string', 'string' ] ],
+  'getShapesBinary' : [ 'pointer', [ 'string' ] ],
+  'freeBinary' : [ 'void', [ 'pointer' ] ],
   'changeTitle' : [ 'bool', [ 'string', 'string' ] ],
   'changeDescr' : [ 'bool', [ 'string', 'string' ] ],
   'scaleRectangles' : [ 'bool', [ 'string', 'float' ] ],
   'scaleCircles' : [ 'bool', [ 'string', 'float' ] ],
+  'scalePaths' : [ 'bool', [ 'string', 'float' ] ],
+  'scalePrimitives' : [ 'bool', [ 'string', 'string', 'float' ] ],
+  'transformComponents' : [ 'bool', [ 'string', 'float', 'float', 'float', 'float' ] ],
   'setNewAttributes' : [ 'bool', [ 'string', 'string', 'int', 'string', 'string' ] ],
+  'setNewAttributesAtPath' : [ 'bool', [ 'string', 'string', 'string', 'string' ] ],
+  'addShapeAtPath' : [ 'bool', [ 'string', 'string', 'string' ] ],
   'createFile' : [ 'bool', [ 'string', 'string' ] ],
   'addCircle' : [ 'bool', [ 'string', 'string' ] ],
-  'addRectangle' : [ 'bool', [ 'string', 'string' ] ]
+  'addRectangle' : [ 'bool', [ 'string', 'string' ] ],
+  'addShapesJSON' : [ 'bool', [ 'string', 'string' ] ],
+  'applyEditsJSON' : [ 'bool', [ 'string', 'string' ] ],
+  'journalEditsJSON' : [ 'int', [ 'string', 'string' ] ],
+  'compactJournal' : [ 'bool', [ 'string' ] ],
+  'getJournalJSON' : [ 'string', [ 'string' ] ],
+  'setWriteDurability' : [ 'void', [ 'int' ] ],
+  'syncSVGWrites' : [ 'bool', [ ] ],
+  'setCompressionLevel' : [ 'void', [ 'int' ] ],
+  'setDefaultWriteOptions' : [ 'void', [ 'bool', 'int', 'bool' ] ],
+  'svgOpen' : [ 'int', [ 'string' ] ],
+  'svgFlush' : [ 'bool', [ 'int' ] ],
+  'svgFlushSessions' : [ 'bool', [ ] ],
+  'svgClose' : [ 'bool', [ 'int' ] ],
+  'svgRevert' : [ 'bool', [ 'int' ] ],
+  'svgSweepSessions' : [ 'void', [ ] ],
+  'svgGetJSON' : [ 'string', [ 'int' ] ],
+  'svgGetTitle' : [ 'string', [ 'int' ] ],
+  'svgGetDescr' : [ 'string', [ 'int' ] ],
+  'svgGetComponentsJSON' : [ 'string', [ 'int', 'string', 'int', 'int' ] ],
+  'svgGetAttributesJSON' : [ 'string', [ 'int', 'string', 'int' ] ],
+  'svgSetTitle' : [ 'bool', [ 'int', 'string' ] ],
+  'svgSetDescr' : [ 'bool', [ 'int', 'string' ] ],
+  'svgSetAttribute' : [ 'bool', [ 'int', 'string', 'int', 'string', 'string' ] ],
+  'svgSetAttributeAtPath' : [ 'bool', [ 'int', 'string', 'string', 'string' ] ],
+  'svgAddShapesJSON' : [ 'bool', [ 'int', 'string' ] ],
+  'svgApplyEditsJSON' : [ 'bool', [ 'int', 'string' ] ],
+  'svgJournalEditsJSON' : [ 'bool', [ 'int', 'string' ] ],
+  'svgScale' : [ 'bool', [ 'int', 'string', 'float' ] ],
+  'svgTransform' : [ 'bool', [ 'int', 'float', 'float', 'float', 'float' ] ],
+  'svgQueryRegionJSON' : [ 'string', [ 'int', 'float', 'float', 'float', 'float' ] ],
+  'svgHitTestJSON' : [ 'string', [ 'int', 'float', 'float' ] ],
+  'svgSelectCount' : [ 'int', [ 'int', 'string' ] ],
+  'svgNumShapesWithArea' : [ 'int', [ 'int', 'string', 'float' ] ],
+  'svgNumPathsWithData' : [ 'int', [ 'int', 'string' ] ],
+  'svgSelectJSON' : [ 'string', [ 'int', 'string' ] ]
+});
+
+// Durability of the file writes, see writeDurability in parser/include/SVGParser.h
+// 0 none, 1 batched, 2 fsync each file (default), 3 also fsync the directory
+if (process.env.SVG_WRITE_DURABILITY !== undefined){
+  sharedLib.setWriteDurability(parseInt(process.env.SVG_WRITE_DURABILITY));
+}
+
+// zlib level for the .svgz files written, 0 (fastest) to 9 (smallest)
+if (process.env.SVG_COMPRESSION_LEVEL !== undefined){
+  sharedLib.setCompressionLevel(parseInt(process.env.SVG_COMPRESSION_LEVEL));
+}
+
+// files are written as small as possible: no indent, the fewest digits that keep every number, and no default attributes
+// SVG_PRETTY_PRINT keeps the indent and the default attributes, SVG_PRECISION sets the digits after the point
+const prettyPrint = (process.env.SVG_PRETTY_PRINT !== undefined);
+const precision = (process.env.SVG_PRECISION !== undefined) ? parseInt(process.env.SVG_PRECISION) : -1;
+sharedLib.setDefaultWriteOptions(prettyPrint, precision, !prettyPrint);
+
+// sync the writes still waiting in the batched mode before the server stops
+process.on('exit', function(){
+  sharedLib.svgFlushSessions();
+  sharedLib.syncSVGWrites();
+});
+
+// open files that are not used for a while are written and freed, see parser/include/SVGSession.h
+setInterval(function(){
+  sharedLib.svgSweepSessions();
+}, 60000).unref();
+
+// the batched writes are only synced at the next write, so the last ones are synced here after SVG_SYNC_BATCH_SECONDS
+const SVG_SYNC_BATCH_SECONDS = 5;
+setInterval(function(){
+  sharedLib.syncSVGWrites();
+}, SVG_SYNC_BATCH_SECONDS * 1000).unref();
+process.on('SIGINT', function(){
+  process.exit(130);
+});
+process.on('SIGTERM', function(){
+  process.exit(143);
 });
 
+// Layout of the binary shapes buffer, must match parser/include/SVGBinary.h
+const SVG_BIN_MAGIC = 0x42475653;
+const SVG_BIN_VERSION = 2;
+const SVG_BIN_VERSION_FIELD = 1;
+const SVG_BIN_HEADER_SIZE = 68;
+
+// reads a NUL terminated string from the string table
+function binaryString(buffer, strings, offset){
+  let start = strings + offset;
+  let end = buffer.indexOf(0, start);
+  return buffer.toString('utf8', start, end);
+}
+
+// floats are stored with single precision, so drop the digits that only come from the conversion to a double
+function binaryFloat(buffer, offset){
+  return Number(buffer.readFloatLE(offset).toPrecision(7));
+}
+
+// reads the box of a group like the bounds of groupToJSON, with 2 digits after the point, null when it has none
+function binaryBounds(buffer, offset){
+  if (isNaN(buffer.readFloatLE(offset))){
+    return null;
+  }
+  return {
+    x: Number(buffer.readFloatLE(offset).toFixed(2)),
+    y: Number(buffer.readFloatLE(offset + 4).toFixed(2)),
+    w: Number(buffer.readFloatLE(offset + 8).toFixed(2)),
+    h: Number(buffer.readFloatLE(offset + 12).toFixed(2))
+  };
+}
+
+// reads the first attribute and number of attributes of a shape into a list of {name, value}
+function binaryAttrList(buffer, info, attrs, strings){
+  let first = buffer.readUInt32LE(info + 4);
+  let numAttr = buffer.readUInt32LE(info + 8);
+  let otherAttributes = [];
+  for (let i = first; i < first + numAttr; ++i){
+    otherAttributes.push({
+      name: binaryString(buffer, strings, buffer.readUInt32LE(attrs + i * 8)),
+      value: binaryString(buffer, strings, buffer.readUInt32LE(attrs + i * 8 + 4))
+    });
+  }
+  return otherAttributes;
+}
+
+// decodes the buffer from getShapesBinary into the same objects as the get...JSON functions
+// null if it is not a shapes buffer, or is one of a version this does not read
+function decodeShapesBinary(buffer){
+
+  if (buffer.length < SVG_BIN_HEADER_SIZE || buffer.readUInt32LE(0) != SVG_BIN_MAGIC){
+    return null;
+  }
+  if (buffer.readUInt32LE(SVG_BIN_VERSION_FIELD * 4) != SVG_BIN_VERSION){
+    console.log("Shapes buffer of version " + buffer.readUInt32LE(SVG_BIN_VERSION_FIELD * 4) + ", only version " + SVG_BIN_VERSION + " is read");
+    return null;
+  }
+
+  let header = [];
+  for (let i = 0; i < SVG_BIN_HEADER_SIZE / 4; ++i){
+    header.push(buffer.readUInt32LE(i * 4));
+  }
+  let [, , , numRects, numCircs, numPaths, numGroups, , rectGeometry, circGeometry, groupGeometry, rectInfo, circInfo, pathInfo, groupInfo, attrs, strings] = header;
+  let shapes = { rectangles: [], circles: [], paths: [], groups: [] };
+
+  for (let i = 0; i < numRects; ++i){
+    let geometry = rectGeometry + i * 16;
+    let info = rectInfo + i * 12;
+    let otherAttributes = binaryAttrList(buffer, info, attrs, strings);
+    shapes.rectangles.push({
+      x: binaryFloat(buffer, geometry),
+      y: binaryFloat(buffer, geometry + 4),
+      w: binaryFloat(buffer, geometry + 8),
+      h: binaryFloat(buffer, geometry + 12),
+      numAttr: otherAttributes.length,
+      units: binaryString(buffer, strings, buffer.readUInt32LE(info)),
+      otherAttributes: otherAttributes
+    });
+  }
+  for (let i = 0; i < numCircs; ++i){
+    let geometry = circGeometry + i * 12;
+    let info = circInfo + i * 12;
+    let otherAttributes = binaryAttrList(buffer, info, attrs, strings);
+    shapes.circles.push({
+      cx: binaryFloat(buffer, geometry),
+      cy: binaryFloat(buffer, geometry + 4),
+      r: binaryFloat(buffer, geometry + 8),
+      numAttr: otherAttributes.length,
+      units: binaryString(buffer, strings, buffer.readUInt32LE(info)),
+      otherAttributes: otherAttributes
+    });
+  }
+  for (let i = 0; i < numPaths; ++i){
+    let info = pathInfo + i * 12;
+    let otherAttributes = binaryAttrList(buffer, info, attrs, strings);
+    shapes.paths.push({
+      d: binaryString(buffer, strings, buffer.readUInt32LE(info)),
+      numAttr: otherAttributes.length,
+      otherAttributes: otherAttributes
+    });
+  }
+  for (let i = 0; i < numGroups; ++i){
+    let geometry = groupGeometry + i * 16;
+    let info = groupInfo + i * 12;
+    let otherAttributes = binaryAttrList(buffer, info, attrs, strings);
+    shapes.groups.push({
+      children: buffer.readUInt32LE(info),
+      numAttr: otherAttributes.length,
+      bounds: binaryBounds(buffer, geometry),
+      otherAttributes: otherAttributes
+    });
+  }
+
+  return shapes;
+}
+
+// gets the shapes of a file through the binary buffer, the C memory is copied and then freed
+function getShapes(file){
+
+  let pointer = sharedLib.getShapesBinary(file);
+  if (pointer.isNull()){
+    return null;
+  }
+  let length = ref.reinterpret(pointer, SVG_BIN_HEADER_SIZE, 0).readUInt32LE(8);
+  let buffer = Buffer.from(ref.reinterpret(pointer, length, 0));
+  sharedLib.freeBinary(pointer);
+
+  return decodeShapesBinary(buffer);
+}
+
+// checks for the gzip magic number, .svgz files are gzip compressed svg files
+function isGzipFile(fileName){
+  let magic = Buffer.alloc(2);
+  let fd = fs.openSync(fileName, 'r');
+  let read = fs.readSync(fd, magic, 0, 2, 0);
+  fs.closeSync(fd);
+  return (read == 2) && (magic[0] == 0x1f) && (magic[1] == 0x8b);
+}
+
+// size of the svg in a file, for a gzip file it is the ISIZE field in the last 4 bytes of the gzip trailer
+function uncompressedSize(fileName, size){
+  if (size < 18 || isGzipFile(fileName) == false){
+    return size;
+  }
+  let trailer = Buffer.alloc(4);
+  let fd = fs.openSync(fileName, 'r');
+  fs.readSync(fd, trailer, 0, 4, size - 4);
+  fs.closeSync(fd);
+  return trailer.readUInt32LE(0);
+}
+
 app.get('/fileNum', function(req , res){ // get all the file information
 
   let files = [];
@@ -101,10 +357,13 @@ app.get('/fileNum', function(req , res){ // get all the file information
   fs.readdirSync('./uploads').forEach(file => {
       let extension = file.split('.').pop();
       let filename = "uploads/" + file;
-      if ((extension == 'svg') && (sharedLib.validFile(filename) == true)){ // if the file is valid
+      if ((extension == 'svg' || extension == 'svgz') && (sharedLib.validFile(filename) == true)){ // if the file is valid
           files[i] = filename;
           ++i;
       }
+      else if (extension == 'journal'){
+          // the edit journal of a file, see parser/include/SVGJournal.h
+      }
       else{
           console.log(filename + " not a valid svg file and not added to the file log panel");
       }
@@ -119,7 +378,8 @@ app.get('/fileNum', function(req , res){ // get all the file information
 
     image.fileName = files[size];
     let currFile = fs.statSync(files[size]);
-    image.fileSize = (Math.round((currFile.size) / 1024)); // size in kilobytes
+    image.fileSize = (Math.round((currFile.size) / 1024)); // size in kilobytes, compressed for .svgz files
+    image.uncompressedSize = (Math.round(uncompressedSize(files[size], currFile.size) / 1024));
     image.numbers = JSON.parse(sharedLib.getNumber(files[size]));
 
     // b. lastly, push into the data array
@@ -144,12 +404,18 @@ app.get('/fileInfo', function(req , res){ // get all the file information
   // 1. get all the information we need
   image.title = sharedLib.getTitle(file);
   image.description = sharedLib.getDescr(file);
+  let numbers = sharedLib.getNumber(file);
+  image.bounds = (numbers == null) ? null : JSON.parse(numbers).bounds; // the box of the shapes, to frame the preview
 
-  // 2. for each shape, get all info on the shapes
-  image.rectangles = JSON.parse(sharedLib.getRectsJSON(file));
-  image.circles = JSON.parse(sharedLib.getCircsJSON(file));
-  image.paths = JSON.parse(sharedLib.getPathsJSON(file));
-  image.groups = JSON.parse(sharedLib.getGroupsJSON(file));
+  // 2. for each shape, get all info on the shapes, the file is parsed once for all of them
+  //    unless the shapes are loaded a page at a time through /fileComponents
+  let shapes = (req.query.shapes == "false") ? null : getShapes(file);
+  if (shapes != null){
+    image.rectangles = shapes.rectangles;
+    image.circles = shapes.circles;
+    image.paths = shapes.paths;
+    image.groups = shapes.groups;
+  }
 
   // 2. send the valid object
   res.send( // this will send the error return values
@@ -160,6 +426,49 @@ app.get('/fileInfo', function(req , res){ // get all the file information
 
 });
 
+app.get('/fileComponents', function(req , res){ // get one page of a type of component
+
+  // 1. get info
+  let file = req.query.info;
+  let component = req.query.component;
+  let offset = parseInt(req.query.offset);
+  let limit = parseInt(req.query.limit);
+
+  // 2. get the page, the total number of components comes with it
+  let page = null;
+  if (component == "Rectangle"){
+    page = sharedLib.getRectsJSONRange(file, offset, limit);
+  }
+  else if (component == "Circle"){
+    page = sharedLib.getCircsJSONRange(file, offset, limit);
+  }
+  else if (component == "Path"){
+    page = sharedLib.getPathsJSONRange(file, offset, limit);
+  }
+  else if (component == "Group"){
+    page = sharedLib.getGroupsJSONRange(file, offset, limit);
+  }
+  else if (component == "Line" || component == "Ellipse" || component == "Polyline" || component == "Polygon"){
+    // these lists are short, the page is cut from the whole list
+    let list = null;
+    if (component == "Line") list = sharedLib.getLinesJSON(file);
+    else if (component == "Ellipse") list = sharedLib.getEllipsesJSON(file);
+    else if (component == "Polyline") list = sharedLib.getPolylinesJSON(file);
+    else list = sharedLib.getPolygonsJSON(file);
+    if (list != null){
+      let items = JSON.parse(list);
+      page = JSON.stringify({ total: items.length, offset: offset, items: items.slice(offset, offset + limit) });
+    }
+  }
+
+  res.send(
+    {
+      page: (page == null) ? null : JSON.parse(page)
+    }
+  );
+
+});
+
 app.get('/editTitle', function(req , res){
 
   // get the new value
@@ -229,6 +538,54 @@ app.get('/scaleCircs', function(req , res){ // same as rectangles
 
 });
 
+app.get('/scalePaths', function(req , res){ // same as rectangles, about the first point of each path
+
+  let file = req.query.info;
+  let newScale = req.query.newScale;
+  let valid = sharedLib.scalePaths(file, newScale);
+  if (valid == false){
+    console.log("Change unsucessful, scaling paths not changed in " + file);
+  }
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
+app.get('/transformComponents', function(req , res){ // scale, rotate and translate every shape with one write
+
+  let file = req.query.info;
+  let valid = sharedLib.transformComponents(file, req.query.translateX, req.query.translateY, req.query.angle, req.query.newScale);
+  if (valid == false){
+    console.log("Change unsucessful, shapes not transformed in " + file);
+  }
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
+app.get('/scalePrimitives', function(req , res){ // lines, ellipses, polylines and polygons, or any shape by name
+
+  let file = req.query.info;
+  let component = req.query.component;
+  let newScale = req.query.newScale;
+  let valid = sharedLib.scalePrimitives(file, component, newScale);
+  if (valid == false){
+    console.log("Change unsucessful, scaling " + component + " not changed in " + file);
+  }
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
 app.get('/viewAttrs', function(req , res){ // to get the other attributes of a component
 
   // 1. get info
@@ -268,6 +625,90 @@ app.get('/addEditAttrs', function(req , res){
 
 });
 
+// the element paths name an element at any depth, like "g0/g2/rect3", see parser/include/SVGElementPath.h
+app.get('/viewAttrsAtPath', function(req , res){
+
+  let attributes = sharedLib.getAttributesAtPathJSON(req.query.info, req.query.path);
+  res.send(
+    {
+      otherAttributes: (attributes == null) ? [] : JSON.parse(attributes)
+    }
+  );
+
+});
+
+app.get('/addEditAttrsAtPath', function(req , res){
+
+  let file = req.query.info;
+  let valid = sharedLib.setNewAttributesAtPath(file, req.query.path, req.query.name, req.query.value);
+  if (valid == false){
+    console.log("Change unsucessful, attribute not changed at " + req.query.path + " in " + file);
+  }
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
+app.get('/addShapeAtPath', function(req , res){
+
+  // the shape is one object like the ones of /newSVGShapes, added to the svg or the group at the path
+  let file = req.query.info;
+  let valid = sharedLib.addShapeAtPath(file, req.query.path, req.query.shape);
+  if (valid == false){
+    console.log("Change unsucessful, shape not added at " + req.query.path + " in " + file);
+  }
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
+// the shapes in a rectangle, or under a point, of the svg and all its groups, named by their element paths
+app.get('/queryRegion', function(req , res){
+
+  let shapes = sharedLib.queryRegionJSON(req.query.info, parseFloat(req.query.x), parseFloat(req.query.y),
+                                         parseFloat(req.query.width), parseFloat(req.query.height));
+  res.send(
+    {
+      shapes: (shapes == null) ? null : JSON.parse(shapes)
+    }
+  );
+
+});
+
+app.get('/hitTest', function(req , res){
+
+  let shapes = sharedLib.hitTestJSON(req.query.info, parseFloat(req.query.x), parseFloat(req.query.y));
+  res.send(
+    {
+      shapes: (shapes == null) ? null : JSON.parse(shapes)
+    }
+  );
+
+});
+
+// the elements found by a selector like "g > rect[width>10][fill=red]", or only their number when count is "true"
+app.get('/select', function(req , res){
+
+  if (req.query.count == "true"){
+    res.send({ count: sharedLib.selectCount(req.query.info, req.query.selector) });
+    return;
+  }
+
+  let elements = sharedLib.selectJSON(req.query.info, req.query.selector);
+  res.send(
+    {
+      elements: (elements == null) ? null : JSON.parse(elements)
+    }
+  );
+
+});
+
 app.get('/newSVGFile', function(req , res){
 
   // 1. get info
@@ -327,5 +768,287 @@ app.get('/newSVGRectangle', function(req , res){
 
 });
 
+app.get('/newSVGShapes', function(req , res){
+
+  // 1. get info, shapes is a JSON array of circles, rectangles and paths
+  let svgFile = req.query.info;
+  let shapes = req.query.shapes;
+  let valid = sharedLib.addShapesJSON(svgFile, shapes); // will validate, and writes the file once
+  if (valid == false){
+    console.log("Change unsucessful, shapes not added to " + svgFile);
+  }
+  res.send(
+    {
+      success: valid // returns the result
+    }
+  );
+
+});
+
+app.get('/applyEdits', function(req , res){
+
+  // 1. get info, edits is a JSON array of edits applied in order, see applyJSONEdit in parser/src/SVGHelperJSON.c
+  let svgFile = req.query.info;
+  let edits = req.query.edits;
+  let valid = sharedLib.applyEditsJSON(svgFile, edits); // all or none of the edits are written, with one write
+  if (valid == false){
+    console.log("Change unsucessful, edits not applied to " + svgFile);
+  }
+  res.send(
+    {
+      success: valid // returns the result
+    }
+  );
+
+});
+
+//******************** Edit journal ********************/
+
+app.get('/journalEdits', function(req , res){
+
+  // 1. the edits are checked, then appended to uploads/<file>.journal instead of writing the whole file
+  let svgFile = req.query.info;
+  let result = sharedLib.journalEditsJSON(svgFile, req.query.edits);
+  if (result < 0){
+    console.log("Change unsucessful, edits not added to the journal of " + svgFile);
+  }
+  else if (result > 0){
+    // 2. the edits are in the journal, only writing them into the file failed, so they are not sent again
+    console.log("Could not write the journal into " + svgFile + ", the edits stay in the journal");
+  }
+  res.send(
+    {
+      success: result >= 0
+    }
+  );
+
+});
+
+app.get('/compactJournal', function(req , res){
+
+  let valid = sharedLib.compactJournal(req.query.info);
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
+app.get('/journal', function(req , res){
+
+  // 2. [{type, time, edit}], the mod_type, mod_date and mod_summary of the MODIFICATION table
+  let journal = sharedLib.getJournalJSON(req.query.info);
+  res.send(
+    {
+      journal: (journal == null) ? [] : JSON.parse(journal)
+    }
+  );
+
+});
+
+//******************** Sessions ********************/
+// The file is read once by /sessionOpen, then the getters and edits use it in memory.
+// The edits are written by /sessionFlush or /sessionClose, or right away when flush is not "false"
+
+app.get('/sessionOpen', function(req , res){
+
+  let handle = sharedLib.svgOpen(req.query.info);
+  if (handle == 0){
+    console.log("Session not opened for " + req.query.info);
+  }
+  res.send(
+    {
+      handle: handle
+    }
+  );
+
+});
+
+app.get('/sessionClose', function(req , res){
+
+  res.send(
+    {
+      success: sharedLib.svgClose(parseInt(req.query.handle))
+    }
+  );
+
+});
+
+app.get('/sessionFlush', function(req , res){
+
+  res.send(
+    {
+      success: sharedLib.svgFlush(parseInt(req.query.handle))
+    }
+  );
+
+});
+
+app.get('/sessionRevert', function(req , res){ // drop the edits that are not written
+
+  res.send(
+    {
+      success: sharedLib.svgRevert(parseInt(req.query.handle))
+    }
+  );
+
+});
+
+app.get('/sessionInfo', function(req , res){
+
+  let handle = parseInt(req.query.handle);
+  let numbers = sharedLib.svgGetJSON(handle);
+  res.send(
+    {
+      info: {
+        title: sharedLib.svgGetTitle(handle),
+        description: sharedLib.svgGetDescr(handle),
+        numbers: (numbers == null) ? null : JSON.parse(numbers)
+      }
+    }
+  );
+
+});
+
+app.get('/sessionComponents', function(req , res){ // one page of a type of component, like /fileComponents
+
+  let page = sharedLib.svgGetComponentsJSON(parseInt(req.query.handle), req.query.component,
+                                            parseInt(req.query.offset), parseInt(req.query.limit));
+  res.send(
+    {
+      page: (page == null) ? null : JSON.parse(page)
+    }
+  );
+
+});
+
+app.get('/sessionAttrs', function(req , res){
+
+  let otherAttributes = sharedLib.svgGetAttributesJSON(parseInt(req.query.handle), req.query.component, parseInt(req.query.index));
+  res.send(
+    {
+      otherAttributes: (otherAttributes == null) ? null : JSON.parse(otherAttributes)
+    }
+  );
+
+});
+
+app.get('/sessionQueryRegion', function(req , res){ // like /queryRegion, the index of the shapes is kept in the session
+
+  let shapes = sharedLib.svgQueryRegionJSON(parseInt(req.query.handle), parseFloat(req.query.x), parseFloat(req.query.y),
+                                            parseFloat(req.query.width), parseFloat(req.query.height));
+  res.send(
+    {
+      shapes: (shapes == null) ? null : JSON.parse(shapes)
+    }
+  );
+
+});
+
+app.get('/sessionHitTest', function(req , res){
+
+  let shapes = sharedLib.svgHitTestJSON(parseInt(req.query.handle), parseFloat(req.query.x), parseFloat(req.query.y));
+  res.send(
+    {
+      shapes: (shapes == null) ? null : JSON.parse(shapes)
+    }
+  );
+
+});
+
+app.get('/sessionSelect', function(req , res){ // like /select, on the svg of the session
+
+  if (req.query.count == "true"){
+    res.send({ count: sharedLib.svgSelectCount(parseInt(req.query.handle), req.query.selector) });
+    return;
+  }
+
+  let elements = sharedLib.svgSelectJSON(parseInt(req.query.handle), req.query.selector);
+  res.send(
+    {
+      elements: (elements == null) ? null : JSON.parse(elements)
+    }
+  );
+
+});
+
+app.get('/sessionAreaCount', function(req , res){ // the rectangles or circles with the area, the histogram is kept in the session
+
+  res.send({ count: sharedLib.svgNumShapesWithArea(parseInt(req.query.handle), req.query.componentType, parseFloat(req.query.area)) });
+
+});
+
+app.get('/sessionPathCount', function(req , res){ // the paths with the data, the counts are kept in the session
+
+  res.send({ count: sharedLib.svgNumPathsWithData(parseInt(req.query.handle), req.query.data) });
+
+});
+
+// ends every session edit, the edit is written right away unless flush is "false"
+function sessionEdit(req, res, valid){
+
+  let handle = parseInt(req.query.handle);
+  if (valid == true && req.query.flush != "false"){
+    valid = sharedLib.svgFlush(handle);
+  }
+  if (valid == false){
+    console.log("Change unsucessful in session " + handle);
+  }
+  res.send(
+    {
+      success: valid
+    }
+  );
+}
+
+app.get('/sessionEditTitle', function(req , res){
+  sessionEdit(req, res, sharedLib.svgSetTitle(parseInt(req.query.handle), req.query.newValue));
+});
+
+app.get('/sessionEditDesc', function(req , res){
+  sessionEdit(req, res, sharedLib.svgSetDescr(parseInt(req.query.handle), req.query.newValue));
+});
+
+app.get('/sessionEditAttrs', function(req , res){
+  sessionEdit(req, res, sharedLib.svgSetAttribute(parseInt(req.query.handle), req.query.component,
+                                                  parseInt(req.query.index), req.query.name, req.query.value));
+});
+
+app.get('/sessionEditAttrsAtPath', function(req , res){
+  sessionEdit(req, res, sharedLib.svgSetAttributeAtPath(parseInt(req.query.handle), req.query.path,
+                                                        req.query.name, req.query.value));
+});
+
+app.get('/sessionShapes', function(req , res){
+  sessionEdit(req, res, sharedLib.svgAddShapesJSON(parseInt(req.query.handle), req.query.shapes));
+});
+
+app.get('/sessionEdits', function(req , res){
+  sessionEdit(req, res, sharedLib.svgApplyEditsJSON(parseInt(req.query.handle), req.query.edits));
+});
+
+app.get('/sessionJournalEdits', function(req , res){
+
+  // the journal keeps the edits on disk, so there is nothing to flush
+  let valid = sharedLib.svgJournalEditsJSON(parseInt(req.query.handle), req.query.edits);
+  res.send(
+    {
+      success: valid
+    }
+  );
+
+});
+
+app.get('/sessionScale', function(req , res){
+  sessionEdit(req, res, sharedLib.svgScale(parseInt(req.query.handle), req.query.component, parseFloat(req.query.newScale)));
+});
+
+app.get('/sessionTransform', function(req , res){
+  sessionEdit(req, res, sharedLib.svgTransform(parseInt(req.query.handle), parseFloat(req.query.translateX),
+                                               parseFloat(req.query.translateY), parseFloat(req.query.angle),
+                                               parseFloat(req.query.newScale)));
+});
+
 app.listen(portNum);
 console.log('Running app at localhost: ' + portNum);
@@ -37,6 +37,8 @@ typedef struct listHead{
     void (*deleteData)(void* toBeDeleted);
     int (*compare)(const void* first,const void* second);
     char* (*printData)(void* toBePrinted);
+    //Array of the nodes in list order, built by getElementAt and discarded whenever the list changes
+    Node** index;
 } List;
 
 
@@ -200,6 +202,34 @@ void* nextElement(ListIterator* iter);
 int getLength(List* list);
 
 
+/**Returns the data of the element at a position in the list. The first call builds an array of the nodes,
+ *so later calls take constant time until the list is changed.
+ *@pre List must exist, but does not have to have elements.
+ *@param list - a pointer to the List struct.
+ *@param index - position of the element, 0 is the head of the list
+ *@return on success: pointer to the data at the position.  on failure: NULL (e.g. index out of bounds)
+ **/
+void* getElementAt(List* list, int index);
+
+
+/**Returns the node at a position in the list, using the same array of nodes as getElementAt, so the data
+ *of the node can be replaced (e.g. by a reallocated struct) without relinking the list.
+ *@pre List must exist, but does not have to have elements.
+ *@param list - a pointer to the List struct.
+ *@param index - position of the node, 0 is the head of the list
+ *@return on success: pointer to the node.  on failure: NULL (e.g. index out of bounds)
+ **/
+Node* getNodeAt(List* list, int index);
+
+
+/**Discards the array of nodes built by getElementAt. The list functions call this whenever they add or
+ *remove nodes, so it only needs to be called by code that relinks nodes by itself.
+ *@pre List must exist
+ *@param list - a pointer to the List struct.
+ **/
+void invalidateIndex(List* list);
+
+
 /** Function that searches for an element in the list using a comparator function.
  * If an element is found, a pointer to the data of that element is returned
  * Returns NULL if the element is not found.
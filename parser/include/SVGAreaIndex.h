@@ -0,0 +1,76 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGAREAINDEX_H
+#define SVGAREAINDEX_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+
+// the fewest buckets of a table, a table doubles when it is three quarters full
+#define SVG_AREA_TABLE_MIN 16
+
+/*
+    A histogram of the areas of the rectangles and circles of an svg and of all its groups, so numRectsWithArea and
+    numCirclesWithArea are one hash lookup instead of a walk over every shape. The areas are the keys the queries
+    compare, ceil(width * height) and ceil(pi r^2) (see rectAreaKey and circleAreaKey), and each one maps to the
+    number of shapes that have it.
+
+    The histogram is made by getAreaIndex, which the holder of the svg calls before its queries (svgNumShapesWithArea
+    does for a session), and is kept in the svg with the version of the svg it counts (see touchSVG). The queries
+    take a const svg, so they only read it while it is up to date and count the shapes one by one otherwise. A shape
+    that is added is counted, a shape whose attribute is set is moved from its old area to its new one, and the type
+    that is scaled is counted again, so those changes keep it up to date. Any other change to the geometry makes it
+    out of date until getAreaIndex makes it again.
+*/
+typedef struct {
+    int area;
+    // the shapes with the area, -1 for a bucket that was never used
+    int count;
+} AreaBucket;
+
+typedef struct {
+    AreaBucket* buckets;
+    int capacity;
+    int used;
+} AreaTable;
+
+struct AreaIndex {
+    // the version of the svg the tables count
+    unsigned version;
+    AreaTable rects;
+    AreaTable circles;
+};
+
+// A change to one shape, from before it is changed to after, see beginAreaChange
+typedef struct {
+    SVG* img;
+    // the shape that is changed, NULL when the change moves no rectangle or circle
+    elementType type;
+    void* shape;
+    int area;
+    // true if the histogram was up to date before the change
+    bool current;
+} AreaChange;
+
+// Functions for a table
+bool initAreaTable(AreaTable* table, int capacity);
+void freeAreaTable(AreaTable* table);
+bool addAreaCount(AreaTable* table, int area, int count);
+int areaCount(const AreaTable* table, int area);
+
+// Functions for the histogram of an svg
+int shapeAreaKey(const void* shape, elementType type);
+AreaTable* areaTableOf(AreaIndex* areas, elementType type);
+AreaIndex* buildAreaIndex(const SVG* img);
+AreaIndex* getAreaIndex(SVG* img);
+bool areaIndexCurrent(const SVG* img);
+bool recountAreas(SVG* img, elementType type);
+void deleteAreaIndex(AreaIndex* areas);
+
+// Functions to keep the histogram up to date with the changes to the shapes
+void countShapeArea(SVG* img, elementType type, void* shape, bool current);
+void beginAreaChange(SVG* img, elementType type, void* shape, AreaChange* change);
+void endAreaChange(AreaChange* change);
+int countShapesWithArea(const SVG* img, elementType type, float area);
+
+#endif
@@ -0,0 +1,53 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGBINARY_H
+#define SVGBINARY_H
+
+#include <stdint.h>
+#include "SVGParser.h"
+
+/*
+    Packed binary format for the shapes of an svg, read by decodeShapesBinary in app.js
+    Every field is a 32 bit little endian number, so every section is 4 byte aligned.
+    Strings are byte offsets into the string table, offset 0 is always the empty string.
+
+    header        uint32[17]            see the SVG_BIN_* indexes below
+    rect geometry float[numRects * 4]   x, y, width, height
+    circ geometry float[numCircs * 3]   cx, cy, r
+    group bounds  float[numGroups * 4]  x, y, width, height of the box of the group like groupToJSON, NaN for no box
+    rect info     uint32[numRects * 3]  units, first attribute, number of attributes
+    circ info     uint32[numCircs * 3]  units, first attribute, number of attributes
+    path info     uint32[numPaths * 3]  data, first attribute, number of attributes
+    group info    uint32[numGroups * 3] number of children (see numGroupChildren), first attribute, number of attributes
+    attributes    uint32[numAttrs * 2]  name, value
+    string table  NUL terminated UTF-8 strings
+*/
+#define SVG_BIN_MAGIC 0x42475653 // "SVGB"
+#define SVG_BIN_VERSION 2
+
+#define SVG_BIN_HEADER_FIELDS 17
+#define SVG_BIN_INFO_FIELDS 3
+
+enum SVGBinaryHeader{
+    SVG_BIN_MAGIC_FIELD, SVG_BIN_VERSION_FIELD, SVG_BIN_LENGTH,
+    SVG_BIN_NUM_RECTS, SVG_BIN_NUM_CIRCS, SVG_BIN_NUM_PATHS, SVG_BIN_NUM_GROUPS, SVG_BIN_NUM_ATTRS,
+    SVG_BIN_RECT_GEOMETRY, SVG_BIN_CIRC_GEOMETRY, SVG_BIN_GROUP_GEOMETRY,
+    SVG_BIN_RECT_INFO, SVG_BIN_CIRC_INFO, SVG_BIN_PATH_INFO, SVG_BIN_GROUP_INFO,
+    SVG_BIN_ATTRS, SVG_BIN_STRINGS
+};
+
+// Keeps track of where the next value of each section is written
+typedef struct {
+    unsigned char* data;
+    uint32_t* info;
+    uint32_t* attrs;
+    uint32_t numAttrs;
+    char* strings;
+    uint32_t stringLength;
+} BinaryWriter;
+
+uint32_t stringBytesInAttrList(List* list);
+uint32_t binaryString(BinaryWriter* writer, const char* string);
+void binaryAttrList(BinaryWriter* writer, List* list);
+
+#endif
@@ -0,0 +1,52 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGBOUNDS_H
+#define SVGBOUNDS_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+#include "SVGPathData.h"
+#include "SVGStringBuilder.h"
+
+/*
+    Bounding boxes of the shapes, in the numbers of the svg (units and stroke widths are left out, like getBBox).
+    The box of a path is exact: the curves add their extrema, not their control points, and an arc is found from
+    its centre the way svg renderers draw it. A shape or group with a transform attribute has the box of its
+    corners moved by the transform, which holds the shape and is exact when the transform does not rotate it.
+    An empty box has min > max, it is what a shape with nothing to draw (or a path that cannot be read) has.
+
+    The box of a group is the box of its shapes and of the boxes of its groups, moved by its transform. It is kept
+    in the group with the version of the svg it was found for, so the boxes are found once after every change
+    to the shapes (see touchSVG) however many times they are asked for. The box of the svg is kept the same way.
+    A const svg or group is only read: findSVGBounds uses the box kept while it is up to date and findGroupBounds
+    finds the box again, since a group does not know the version of the svg it is in.
+*/
+
+// Functions for the boxes
+void emptyBounds(Bounds* bounds);
+bool boundsEmpty(const Bounds* bounds);
+void addBoundsPoint(Bounds* bounds, float x, float y);
+void unionBounds(Bounds* bounds, const Bounds* other);
+bool boundsIntersect(const Bounds* first, const Bounds* second);
+bool boundsContain(const Bounds* bounds, float x, float y);
+void transformBounds(const Bounds* bounds, const float matrix[6], Bounds* result);
+void appendBoundsJSON(StringBuilder* builder, const Bounds* bounds);
+
+// Functions for the extrema of the curves of a path
+void addQuadraticBounds(Bounds* bounds, const float p0[2], const float p1[2], const float p2[2]);
+void addCubicBounds(Bounds* bounds, const float p0[2], const float p1[2], const float p2[2], const float p3[2]);
+void addArcBounds(Bounds* bounds, const float p0[2], float rx, float ry, float angle, bool largeArc, bool sweep, const float p1[2]);
+void pathDataBounds(const PathData* pathData, Bounds* bounds);
+
+// Functions for the boxes of the shapes
+void elementMatrix(List* attrList, const float parent[6], float result[6]);
+void shapeBounds(void* shape, elementType type, Bounds* bounds);
+void elementBounds(void* element, elementType type, Bounds* bounds);
+
+// Functions for the boxes of the groups and the svg
+const Bounds* groupBounds(Group* group, unsigned version);
+void findGroupBounds(const Group* group, Bounds* bounds);
+const Bounds* svgBounds(SVG* img);
+void findSVGBounds(const SVG* img, Bounds* bounds);
+
+#endif
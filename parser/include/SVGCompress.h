@@ -0,0 +1,25 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGCOMPRESS_H
+#define SVGCOMPRESS_H
+
+#include <stdbool.h>
+#include <zlib.h>
+#include "SVGParser.h"
+
+/*
+    .svgz files are svg files compressed with gzip. They are read by streaming the file through zlib
+    into the libxml2 parser, and written by sending the output of SVGWriter through zlib.
+    Reading also works for uncompressed files, zlib passes their bytes through as they are.
+*/
+
+// Functions to read an svg or svgz file into an xml tree
+int gzIORead(void* context, char* buffer, int length);
+int gzIOClose(void* context);
+xmlDocPtr readSVGFile(const char* fileName);
+
+// Functions for writing compressed files
+bool compressedFileName(const char* fileName);
+int getCompressionLevel(void);
+
+#endif
@@ -0,0 +1,38 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGELEMENTPATH_H
+#define SVGELEMENTPATH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "SVGParser.h"
+
+/*
+    An element path names any element in the tree through the groups it is in, so the server can edit
+    a shape inside a group without flattening the svg first. "g0/g2/rect3" is the fourth rectangle of the
+    third group of the first group of the svg. Every part is the name of the xml element and its index in
+    the list of that type, every part but the last must be a group, and "" or "svg" is the svg itself.
+    The names are svg, g, rect, circle, path, line, ellipse, polyline and polygon.
+    Every part is found with getElementAt, so a path is resolved in O(depth).
+*/
+typedef struct {
+    // the group the element is in, NULL when it is in the svg
+    Group* parent;
+    // the element and its index in the list of its type, SVG_IMG and the svg for the svg itself
+    elementType type;
+    int index;
+    void* element;
+} ElementPath;
+
+// Functions to read a path
+elementType pathElementType(const char* name, size_t length);
+const char* pathElementName(elementType type);
+List* containerList(const SVG* img, Group* parent, elementType type);
+bool resolveElementPath(SVG* img, const char* path, ElementPath* result);
+
+// Functions to use the element at a path
+List* elementPathAttributes(SVG* img, const ElementPath* elementPath);
+bool setAttributeAtPath(SVG* img, const char* path, Attribute* newAttribute);
+bool addComponentAtPath(SVG* img, const char* path, elementType type, void* newElement);
+
+#endif
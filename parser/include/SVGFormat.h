@@ -0,0 +1,37 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGFORMAT_H
+#define SVGFORMAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "SVGParser.h"
+
+// longest number formatNumber writes, with the \0
+#define SVG_NUMBER_LENGTH 96
+
+/*
+    The layout of the files written, see SVGWriteOptions in SVGParser.h.
+    Numbers are formatted here for both the writer and the xml tree, and the attributes that can be left
+    out are found from a table of the svg 1.1 initial values. An inherited attribute is only dropped when
+    none of its ancestors set it, each of them is a bit in the inheritedSet passed down to the children,
+    and never in a document with a style or use element (see documentInheritedSet).
+*/
+
+// Functions for the options used by writeSVG and validateAndWriteSVG
+SVGWriteOptions getWriteOptions(void);
+bool validWriteOptions(SVGWriteOptions options);
+
+// Function to write a number with the precision of the options, or the fewest digits for SVG_PRECISION_SHORTEST
+void formatNumber(char* buffer, size_t size, float number, int precision);
+
+// Functions to find the attributes that are set to their default values
+int defaultAttributeIndex(const char* name);
+bool sameNumber(const char* value, const char* number);
+bool zeroLength(const char* value);
+bool isDefaultAttribute(const char* name, const char* value, unsigned inheritedSet);
+unsigned inheritedAttributeSet(List* attributes, unsigned inheritedSet);
+bool styleOrUseElement(const char* xml);
+unsigned documentInheritedSet(const SVG* img);
+
+#endif
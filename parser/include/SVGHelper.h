@@ -4,6 +4,12 @@
 #define SVGHELPER_H
 
 #include "SVGParser.h"
+#include "SVGStringBuilder.h"
+
+// the values of attributes and the data of paths are allocated in steps of this many bytes, a power of 2
+#define SVG_VALUE_ROUNDING 16
+// a namespace declared with a prefix on the svg is kept in its other attributes with this in front of the prefix
+#define SVG_XMLNS_PREFIX "xmlns:"
 
 // Module 1 helper functions:
 
@@ -13,6 +19,9 @@ int getElementNames(xmlNode* a_node, SVG* svg);
 
 // struct creation functions
 Attribute* otherAttributes (char *name, char *content);
+size_t valueCapacity(size_t length);
+size_t growCapacity(size_t capacity, size_t length);
+Attribute* setAttributeValue(Attribute* attr, const char* value);
 Rectangle* rectAttributes(xmlNode *cur_node);
 Circle* circAttributes(xmlNode *cur_node);
 Path* pathAttributes (xmlNode *cur_node);
@@ -20,18 +29,24 @@ Group* groupAttributes (xmlNode *cur_node);
 
 // list within a struct creation functions
 void firstOtherAttributes(xmlNode *cur_node, List* otherAttributesList);
+void namespaceAttributes(xmlNode *cur_node, List* otherAttributesList);
+RawElement* rawElement(xmlNode *cur_node);
+void addRawElement(xmlNode *cur_node, List* otherElementsList, ElementPlace* place);
+void rawElementAnchor(List* list, elementType type, ElementPlace* place);
 
 // validity check functions
 int numberWithUnits(float* number, char* units, char* value);
 int titleDescNS(char *field, char* data);
 
-int validChar(char* word);
+int validChar(const char* word);
 int emptyString(char* word);
 
 // Module 2 helper funcitons:
 int getElementGroups(List *source, List *dest, char* type);
 int findNumShape(List * list, bool (*customCompare)(const void* first,const void* second), const void* searchRecord);
 
+int rectAreaKey(const Rectangle* rect);
+int circleAreaKey(const Circle* circ);
 bool compareRectAreas(const void* data, const void* area);
 bool compareCircAreas(const void* data, const void* area);
 bool comparePathData(const void* data, const void* string);
@@ -49,4 +64,18 @@ void dummyDeleteCircle(void* data);
 void dummyDeletePath(void* data);
 void dummyDeleteGroup(void* data);
 
+// String representation helper functions:
+void appendSVGString(StringBuilder* builder, const SVG* img);
+void appendAttributeString(StringBuilder* builder, const Attribute* attr);
+void appendGroupString(StringBuilder* builder, const Group* group);
+void appendRectangleString(StringBuilder* builder, const Rectangle* rect);
+void appendCircleString(StringBuilder* builder, const Circle* circ);
+void appendPathString(StringBuilder* builder, const Path* path);
+
+void appendAttrListString(StringBuilder* builder, List* list);
+void appendRectListString(StringBuilder* builder, List* list);
+void appendCircListString(StringBuilder* builder, List* list);
+void appendPathListString(StringBuilder* builder, List* list);
+void appendGroupListString(StringBuilder* builder, List* list);
+
 #endif
@@ -11,13 +11,15 @@
 // Function to validate xml file against a schema file
 bool validateFileSVG(xmlDocPtr doc, const char* schemaFile);
 xmlDocPtr createXMLFromStruct(const SVG* img);
-
-// Functions to write svg shape struct to a node in the xml tree
-void addAttrListToParentNode(List* list, xmlNodePtr* parent);
-void addRectListToParentNode(List* rectList, xmlNodePtr* parent);
-void addCircListToParentNode(List* circList, xmlNodePtr* parent);
-void addPathListToParentNode(List* pathList, xmlNodePtr* parent);
-void addGroupListToParentNode(List* groupList, xmlNodePtr* parent);
+xmlDocPtr createXMLFromStructChecked(const SVG* img, bool* valid);
+
+// Functions to write svg shape struct to a node in the xml tree, valid is NULL or set to false when a struct is not valid
+void addAttrListToParentNode(List* list, xmlNodePtr* parent, bool* valid);
+void addRectListToParentNode(List* rectList, xmlNodePtr* parent, bool* valid);
+void addCircListToParentNode(List* circList, xmlNodePtr* parent, bool* valid);
+void addPathListToParentNode(List* pathList, xmlNodePtr* parent, bool* valid);
+void addGroupListToParentNode(List* groupList, xmlNodePtr* parent, bool* valid);
+void addRawElementListToParentNode(List* elementList, xmlNodePtr* parent, bool* valid);
 // Function to convert floating point number and units to a string
 char* unitsWithNumber(float number, char units[]);
 
@@ -34,17 +36,24 @@ bool validRectListStruct(List* rectangles);
 bool validCircListStruct(List* circles);
 bool validPathListStruct(List* paths);
 bool validGroupListStruct(List* groupList);
+bool validRawElementListStruct(List* otherElements);
 
 bool isListEmpty(List* list);
-bool checkString(char* string);
+bool checkString(const char* string);
 bool checkRange(float number);
 bool checkInvalid(float number);
 
 // Functions to help in the setting of attributes
+bool changeCoor(float* coor, char value[]);
+bool changeDimen(float* dimen, char value[]);
 bool changeValueInAttr (List* attrList, Attribute* newAttribute);
 bool changeValueInRect (List* rectList, int index, Attribute* newAttribute);
 bool changeValueInCirc (List* circList, int index, Attribute* newAttribute);
 bool changeValueInPath (List* pathList, int index, Attribute* newAttribute);
 bool changeValueInGroup (List* groupList, int index, Attribute* newAttribute);
 
+// Function to help in the adding of components
+bool addComponentToGroup (List* groupList, int index, elementType type, void* newElement);
+bool addShapeToGroup (Group* group, elementType type, void* newElement);
+
 #endif
@@ -0,0 +1,32 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGHELPERJSON_H
+#define SVGHELPERJSON_H
+
+#include "SVGParser.h"
+
+// Functions to read the JSON strings sent by the server (flat objects and arrays of flat objects)
+const char* skipJSONSpaces(const char* json);
+const char* skipJSONString(const char* json);
+const char* skipJSONValue(const char* json);
+int encodeUTF8(char* dest, unsigned int codePoint);
+char* copyJSONString(const char* start, const char* end);
+
+char* nextJSONObject(const char** cursor);
+char* getJSONValue(const char* object, const char* key);
+bool getJSONFloat(const char* object, const char* key, float* number);
+bool getJSONInt(const char* object, const char* key, int* number);
+
+// Functions to create shapes from a JSON object that names its type
+elementType JSONShapeType(const char* object);
+void getJSONUnits(const char* object, char units[50]);
+void* JSONtoShape(const char* object, elementType* type);
+bool JSONtoAttrList(const char* array, List* otherAttributes);
+bool addJSONShape(SVG* img, const char* object);
+bool addJSONShapes(SVG* img, const char* shapes);
+
+// Functions to apply the edits of applyEditsJSON
+bool applyJSONEdit(SVG* img, const char* edit);
+bool applyJSONEdits(SVG* img, const char* edits);
+
+#endif
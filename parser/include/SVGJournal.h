@@ -0,0 +1,77 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGJOURNAL_H
+#define SVGJOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "SVGParser.h"
+
+#define SVG_JOURNAL_SUFFIX ".journal"
+#define SVG_JOURNAL_MAGIC 0x4a475653u // "SVGJ"
+// the journal is written into the svg when it is this big, or when its first edit is this old
+#define SVG_JOURNAL_MAX_BYTES (64 * 1024)
+#define SVG_JOURNAL_MAX_SECONDS 600
+// a record longer than this is taken as a broken file
+#define SVG_JOURNAL_MAX_EDIT (16 * 1024 * 1024)
+
+/*
+    An edit journal is a file next to the svg ("a.svg.journal") that edits are appended to, instead of writing
+    the whole svg again for every edit. Every record is the header below and then the edit, a JSON object in the
+    format of applyJSONEdit. createValidSVG applies the records after reading the svg, and writing the svg
+    (writeSVG or validateAndWriteSVG) removes the journal, since the file written has the edits in it.
+
+    Every record keeps the device, inode, size and time of the svg it was made for. The svg is always replaced by
+    a rename, so once it is written again the old records do not match it and are skipped, even if the journal
+    could not be removed. The inode alone is not enough, a new file can be given the inode of one that was removed.
+    A record that was not written whole (the magic, the length or the checksum are wrong) ends the journal.
+*/
+typedef struct {
+    uint64_t device;
+    uint64_t inode;
+    int64_t size;
+    //Nanoseconds since the epoch when the svg was last written
+    int64_t modified;
+} JournalBase;
+
+typedef struct {
+    uint32_t magic;
+    //Bytes of the edit after the header
+    uint32_t length;
+    //Seconds since the epoch when the edit was made
+    int64_t time;
+    //The svg the edit applies to
+    JournalBase base;
+    //The kind of edit, a JournalOp
+    uint32_t op;
+    //FNV-1a of the edit
+    uint32_t checksum;
+} JournalRecord;
+
+// The kinds of edits, the same as the "op" of applyJSONEdit, and the mod_type of the MODIFICATION table
+typedef enum {
+    JOURNAL_UNKNOWN, JOURNAL_TITLE, JOURNAL_DESCRIPTION, JOURNAL_ATTRIBUTE, JOURNAL_SCALE, JOURNAL_TRANSFORM, JOURNAL_ADD
+} JournalOp;
+
+// Functions for the journal file
+char* journalName(const char* fileName);
+bool journalExists(const char* fileName);
+long journalSize(const char* fileName);
+bool removeJournal(const char* fileName);
+JournalOp journalOpNamed(const char* name);
+const char* journalOpName(JournalOp op);
+uint32_t journalChecksum(const char* data, size_t length);
+bool journalBaseOf(const char* fileName, JournalBase* base);
+bool sameJournalBase(const JournalBase* first, const JournalBase* second);
+
+// Functions to write and read the records
+bool appendJournal(const char* fileName, const char* edits, time_t now);
+char* readJournalRecord(FILE* file, JournalRecord* record);
+long journalValidLength(const char* fileName);
+int replayJournal(SVG* img, const char* fileName);
+time_t journalStarted(const char* fileName);
+bool journalNeedsCompaction(const char* fileName, time_t now);
+char* journalToJSON(const char* fileName);
+
+#endif
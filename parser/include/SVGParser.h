@@ -20,32 +20,122 @@ char* getRectsJSON(char* filename);
 char* getCircsJSON(char* filename);
 char* getPathsJSON(char* filename);
 char* getGroupsJSON(char* filename);
+char* getRectsJSONRange(char* filename, int offset, int limit);
+char* getCircsJSONRange(char* filename, int offset, int limit);
+char* getPathsJSONRange(char* filename, int offset, int limit);
+char* getGroupsJSONRange(char* filename, int offset, int limit);
+char* getLinesJSON(char* filename);
+char* getEllipsesJSON(char* filename);
+char* getPolylinesJSON(char* filename);
+char* getPolygonsJSON(char* filename);
 char* getAttributesJSON(char* filename, char* componentType, int index);
+char* getAttributesAtPathJSON(char* filename, char* elementPath);
+char* queryRegionJSON(char* filename, float x, float y, float width, float height);
+char* hitTestJSON(char* filename, float x, float y);
+int selectCount(char* filename, char* selector);
+char* selectJSON(char* filename, char* selector);
+void* getShapesBinary(char* filename);
+void freeBinary(void* data);
 
 bool changeTitle(char* filename, char* newValue);
 bool changedDescr(char* filename, char* newValue);
 bool scaleRectangles(char* filename, float scaleValue);
 bool scaleCircles(char* filename, float scaleValue);
+bool scalePaths(char* filename, float scaleValue);
+bool scalePrimitives(char* filename, char* componentType, float scaleValue);
+bool transformComponents(char* filename, float translateX, float translateY, float angle, float scaleValue);
+
+// Session functions: the file is read once by svgOpen, and edited in memory until svgFlush or svgClose writes it (see SVGSession.h)
+int svgOpen(char* filename);
+bool svgFlush(int handle);
+bool svgFlushSessions(void);
+bool svgClose(int handle);
+bool svgRevert(int handle);
+void svgSweepSessions(void);
+char* svgGetJSON(int handle);
+char* svgGetTitle(int handle);
+char* svgGetDescr(int handle);
+char* svgGetComponentsJSON(int handle, char* componentType, int offset, int limit);
+char* svgGetAttributesJSON(int handle, char* componentType, int index);
+bool svgSetTitle(int handle, char* newValue);
+bool svgSetDescr(int handle, char* newValue);
+bool svgSetAttribute(int handle, char* componentType, int componentNumber, char* newName, char* newValue);
+bool svgSetAttributeAtPath(int handle, char* elementPath, char* newName, char* newValue);
+bool svgAddShapesJSON(int handle, char* shapes);
+bool svgApplyEditsJSON(int handle, char* edits);
+bool svgJournalEditsJSON(int handle, char* edits);
+bool svgScale(int handle, char* componentType, float scaleValue);
+bool svgTransform(int handle, float translateX, float translateY, float angle, float scaleValue);
+char* svgQueryRegionJSON(int handle, float x, float y, float width, float height);
+char* svgHitTestJSON(int handle, float x, float y);
+int svgSelectCount(int handle, char* selector);
+int svgNumShapesWithArea(int handle, char* componentType, float area);
+int svgNumPathsWithData(int handle, char* data);
+char* svgSelectJSON(int handle, char* selector);
 bool setNewAttributes(char* filename, char* componentType, int componentNumber, char* newName, char* newValue);
+// Element path functions: an element at any depth named like "g0/g2/rect3" (see SVGElementPath.h)
+bool setNewAttributesAtPath(char* filename, char* elementPath, char* newName, char* newValue);
+bool addShapeAtPath(char* filename, char* elementPath, char* shape);
 
 bool createFile(char* filename, char* svg);
 bool addCircle(char* filename, char* circle);
 bool addRectangle(char* filename, char* rectangle);
+bool addShapesJSON(char* filename, char* shapes);
+bool applyEditsJSON(char* filename, char* edits);
+
+// Journal functions: edits appended to a file next to the svg, and written into the svg later (see SVGJournal.h)
+int journalEditsJSON(char* filename, char* edits);
+bool compactJournal(char* filename);
+char* getJournalJSON(char* filename);
 
 // END OF WRAPPER FUNCTIONS
 
 typedef enum COMP{
-    SVG_IMG, CIRC, RECT, PATH, GROUP
+    SVG_IMG, CIRC, RECT, PATH, GROUP, LINE, ELLIPSE, POLYLINE, POLYGON
 } elementType;
 
 //Represents a generic SVG element/XML node Attribute
 typedef struct  {
     //Attribute name.  Must not be NULL
 	char* 	name;
+    //Bytes value has room for, with the terminating NUL.  A new value that fits is copied in place,
+    //a longer one reallocates the struct (see setAttributeValue in SVGHelper.h)
+    size_t  capacity;
     //Attribute value.  May be empty
 	char	value[]; 
 } Attribute;
 
+//Where a raw element or a line, ellipse, polyline or polygon was read among the children of its svg or group,
+//so it is written back in the same place and not after the children of the types before it
+typedef struct {
+    //The child of its svg or group it was read after: the rectangle, circle, path or group at afterIndex in the
+    //list of afterType.  For SVG_IMG it is the number of the title and desc it was read after, 0 when it was read first
+    elementType afterType;
+    int afterIndex;
+    //The number of raw elements and shapes with a place read before it in its svg or group, so the ones read after
+    //the same child keep their order.  -1 for a shape that was not read from a file, it is written after the paths
+    int position;
+} ElementPlace;
+
+//Represents an element the parser does not model (defs, text, use, style, ...) with everything inside it.
+//It is kept as the xml it was read as, and written back unchanged in the same place among its siblings
+typedef struct {
+    //Where it was read
+    ElementPlace place;
+    //Number of bytes in xml
+    size_t length;
+    //The element as xml, like "<defs><linearGradient id=\"a\"/></defs>".  Must not be empty
+    char xml[];
+} RawElement;
+
+//A bounding box in the numbers of the svg, see SVGBounds.h.  It is empty when min > max
+typedef struct {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+} Bounds;
+
 //Represents a group of objects in an SVG file
 typedef struct {
     
@@ -61,6 +151,22 @@ typedef struct {
     //Additional rectangle attributes - i.e. attributes of the g XML element.  
 	//All objects in the list will be of type Attribute.  It must not be NULL.  It may be empty.
     List* otherAttributes;
+
+    //Elements in the group that are not rectangles, circles, paths or groups, in the order they were read.
+    //All objects in the list will be of type RawElement.  It may be NULL, which is the same as empty.
+    List* otherElements;
+
+    //All objects in the lists will be of type Line, Ellipse, Polyline and Polygon.
+    //They may be NULL, which is the same as empty.
+    List* lines;
+    List* ellipses;
+    List* polylines;
+    List* polygons;
+
+    //The box of the shapes of the group, with its transform, in the numbers of the group or svg it is in.
+    //boundsVersion is the version of the svg plus one when the box was found, 0 before that
+    Bounds bounds;
+    unsigned boundsVersion;
 } Group;
 
 //Represents a rectangle primitive 
@@ -101,6 +207,9 @@ typedef struct {
 
 } Circle;
 
+//The path data read into commands and numbers, see SVGPathData.h
+typedef struct PathData PathData;
+
 //Represents a path primitive - i.e. a sequence of points connected with lines or curves
 typedef struct {
     
@@ -108,11 +217,88 @@ typedef struct {
     //All objects in the list will be of type Attribute.  It must not be NULL.  It may be empty.
     List* otherAttributes;
 
-    //Path data.  Must not be NULL
-    char data[];
+    //The data read into commands and numbers, made the first time it is needed by getPathData.  May be NULL.
+    //It is freed with the path, and must be freed and set to NULL when data is changed
+    PathData* parsed;
+
+    //Path data.  Must not be NULL.  It is kept in the store of path data (see SVGPathStore.h) once for all the paths
+    //with the same data, so it must only be changed with setPathData
+    const char* data;
 
 } Path;
 
+//Represents a line primitive - a line from (x1, y1) to (x2, y2)
+typedef struct {
+    float x1;
+    float y1;
+    float x2;
+    float y2;
+
+    //Units for the line coordinates.  May be empty.
+    char units[50];
+
+    //Additional line attributes - i.e. attributes of the line XML element.
+    //All objects in the list will be of type Attribute.  It must not be NULL.  It may be empty.
+    List* otherAttributes;
+
+    //Where it was read, see ElementPlace
+    ElementPlace place;
+
+} Line;
+
+//Represents an ellipse primitive
+typedef struct {
+    //The X and Y coordinates of the ellipse centre
+    float cx;
+    float cy;
+    //Radius on the x and y axis.  Must be >= 0
+    float rx;
+    float ry;
+
+    //Units for the ellipse coordinates and size.  May be empty.
+    char units[50];
+
+    //Additional ellipse attributes - i.e. attributes of the ellipse XML element.
+    //All objects in the list will be of type Attribute.  It must not be NULL.  It may be empty.
+    List* otherAttributes;
+
+    //Where it was read, see ElementPlace
+    ElementPlace place;
+
+} Ellipse;
+
+//Represents a polyline or polygon primitive - points joined by straight lines, a polygon also joins the
+//last point back to the first.  The points attribute is read once into the points array, so the
+//geometry can be used without reading the string again
+typedef struct {
+
+    //Additional attributes - i.e. attributes of the polyline or polygon XML element.
+    //All objects in the list will be of type Attribute.  It must not be NULL.  It may be empty.
+    List* otherAttributes;
+
+    //Where it was read, see ElementPlace
+    ElementPlace place;
+
+    //Number of points.  Must be >= 0
+    int numPoints;
+    //Number of points the struct has room for.  Must be >= numPoints
+    int maxPoints;
+
+    //The x and y of each point, one after the other: x0, y0, x1, y1, ...  Holds 2 * numPoints floats
+    float points[];
+
+} Polyline;
+
+//Polygons have the same fields as polylines
+typedef Polyline Polygon;
+
+//The index of the shapes of an svg, see SVGSpatial.h
+typedef struct SpatialIndex SpatialIndex;
+//The histogram of the areas of the shapes of an svg, see SVGAreaIndex.h
+typedef struct AreaIndex AreaIndex;
+//The number of paths with each path data, see SVGPathStore.h
+typedef struct PathCounts PathCounts;
+
 // The main struct, representing an svg elemnt of the format
 // While a full SVG struct might have multiple svg components, we will assume that all of our input
 // structs will only have one
@@ -144,7 +330,33 @@ typedef struct {
     //Additional SVG attributes - i.e. attributes of the svg XML element.  
     //All objects in the list will be of type Attribute.  It must not be NULL.  It may be empty.  
     //Do not put the namespace here, since it already has its own field
+    //The other namespaces declared on the svg are kept here as xmlns:prefix attributes
     List* otherAttributes;
+
+    //Elements in the svg that are not the title, description, rectangles, circles, paths or groups,
+    //in the order they were read.
+    //All objects in the list will be of type RawElement.  It may be NULL, which is the same as empty.
+    List* otherElements;
+
+    //All objects in the lists will be of type Line, Ellipse, Polyline and Polygon.
+    //They may be NULL, which is the same as empty.
+    List* lines;
+    List* ellipses;
+    List* polylines;
+    List* polygons;
+
+    //Counts the changes to the geometry of the shapes, so the boxes and the index below know when they are out of date
+    unsigned version;
+    //The R-tree of the boxes of the shapes, see SVGSpatial.h.  It is made when the svg is first queried.
+    //It may be NULL.
+    SpatialIndex* spatial;
+    //The box of all the shapes, kept like the box of a group
+    Bounds bounds;
+    unsigned boundsVersion;
+    //The histogram of the areas of the rectangles and circles, see SVGAreaIndex.h.  It may be NULL.
+    AreaIndex* areas;
+    //The number of paths with each path data, see SVGPathStore.h.  It may be NULL.
+    PathCounts* pathCounts;
 } SVG;
 
 //A1
@@ -201,6 +413,11 @@ List* getCircles(const SVG* img);
 List* getGroups(const SVG* img);
 // Function that returns a list of all paths in the struct.  
 List* getPaths(const SVG* img);
+// Functions that return a list of all lines, ellipses, polylines and polygons in the struct.
+List* getLines(const SVG* img);
+List* getEllipses(const SVG* img);
+List* getPolylines(const SVG* img);
+List* getPolygons(const SVG* img);
 
 
 /* For the four "num..." functions below, you need to search the SVG struct for components that match the search 
@@ -276,6 +493,87 @@ SVG* createValidSVG(const char* fileName, const char* schemaFile);
  **/
 bool writeSVG(const SVG* img, const char* fileName);
 
+/** Function to validate an SVG struct and write it to a file, building its xml tree only once for the schema
+    and writing the file from the struct like writeSVG
+ *@pre
+    SVG struct exists and is not NULL.
+    schema file name is not NULL/empty, and represents a valid schema file
+    fileName is not NULL, has the correct extension
+ *@post SVG struct has not been modified in any way, and if it is valid (the same checks as validateSVG)
+    the file has been replaced with its contents
+ *@return a boolean value indicating whether the SVG was valid and written
+ *@param
+    img - a pointer to a SVG struct
+    schemaFile - the name of a schema file
+    fileName - the name of the output file
+ **/
+bool validateAndWriteSVG(const SVG* img, const char* schemaFile, const char* fileName);
+
+/* Options for the layout of the files written by writeSVG and validateAndWriteSVG:
+    indent       - true puts every element on its own line, two spaces per level, false writes the
+                   elements with no whitespace between them
+    precision    - the digits after the point for the numbers of rectangles and circles, or
+                   SVG_PRECISION_SHORTEST for the fewest digits that still read back as the same float
+    dropDefaults - leaves out attributes set to the value the element would have without them, like
+                   opacity="1" or x="0", inherited ones are only left out when no ancestor sets them
+                   and the document has no style or use element
+   The defaults are indent on, 6 digits and no attributes dropped, the same output as xmlSaveFormatFileEnc
+*/
+typedef struct {
+    bool indent;
+    int precision;
+    bool dropDefaults;
+} SVGWriteOptions;
+
+#define SVG_PRECISION_SHORTEST -1
+#define SVG_PRECISION_MAX 20
+
+/** Function to write an SVG struct into a file in SVG format, laid out with the given options
+ *@pre
+    SVG struct exists, is valid, and and is not NULL.
+    fileName is not NULL, has the correct extension
+    options.precision is SVG_PRECISION_SHORTEST or 0 to SVG_PRECISION_MAX
+ *@post SVG struct has not been modified in any way, and a file representing the
+    SVG contents in SVG format has been created
+ *@return a boolean value indicating success or failure of the write
+ *@param
+    img - a pointer to a SVG struct
+    fileName - the name of the output file
+    options - the layout of the file
+ **/
+bool writeSVGWithOptions(const SVG* img, const char* fileName, SVGWriteOptions options);
+
+// Function to set the options used by writeSVG and validateAndWriteSVG, invalid options are ignored
+void setDefaultWriteOptions(bool indent, int precision, bool dropDefaults);
+
+/* Durability levels for writeSVG. At every level the file is written to a temp file in the same directory
+   and renamed over the original, so readers and crashes only ever see the old or the new file.
+   The levels only differ in when the new contents are forced to the disk with fsync:
+    SVG_SYNC_NONE    - never, a power loss can lose recent writes
+    SVG_SYNC_BATCHED - files written are fsynced together by syncSVGWrites, which also runs on its own at a write
+                       that makes SVG_SYNC_BATCH_SIZE files, or that comes SVG_SYNC_BATCH_SECONDS seconds after the
+                       first file of the batch. The age is only checked at a write, so the caller must also call
+                       syncSVGWrites every SVG_SYNC_BATCH_SECONDS seconds for the last writes of a batch
+    SVG_SYNC_FILE    - the temp file is fsynced before the rename (default)
+    SVG_SYNC_FULL    - the directory is also fsynced after the rename, so the rename itself is on disk
+*/
+typedef enum SYNC{
+    SVG_SYNC_NONE, SVG_SYNC_BATCHED, SVG_SYNC_FILE, SVG_SYNC_FULL
+} writeDurability;
+
+#define SVG_SYNC_BATCH_SIZE 64
+#define SVG_SYNC_BATCH_SECONDS 5
+
+// Function to set the durability of every writeSVG after it, any pending batched writes are synced first
+void setWriteDurability(int durability);
+// Function to fsync the files written since the last sync in SVG_SYNC_BATCHED mode, returns false if any sync failed
+bool syncSVGWrites(void);
+
+/* Files named .svgz are read and written compressed with gzip.
+   Function to set the zlib level they are written with, 0 (fastest) to 9 (smallest), or -1 for the zlib default
+*/
+void setCompressionLevel(int level);
+
 /** Function to setting an attribute in an SVG or component
  *@pre
     SVG object exists, is valid, and and is not NULL.
@@ -303,6 +601,29 @@ bool setAttribute(SVG* img, elementType elemType, int elemIndex, Attribute* newA
  **/
 void addComponent(SVG* img, elementType type, void* newElement);
 
+/* The element types transformSVG moves, one bit for each elementType */
+#define SVG_ELEMENT_MASK(type) (1u << (type))
+#define SVG_SHAPES_MASK (SVG_ELEMENT_MASK(RECT) | SVG_ELEMENT_MASK(CIRC) | SVG_ELEMENT_MASK(PATH) | SVG_ELEMENT_MASK(LINE) | \
+                         SVG_ELEMENT_MASK(ELLIPSE) | SVG_ELEMENT_MASK(POLYLINE) | SVG_ELEMENT_MASK(POLYGON))
+
+/** Function to apply an affine transform to the shapes of an SVG
+ *@pre
+    SVG object exists, is valid, and and is not NULL.
+    matrix holds the 6 numbers of the svg matrix(a b c d e f): x' = a x + c y + e, y' = b x + d y + f
+ *@post Every shape of the types in elementMask, in the svg and its groups, is drawn moved by the matrix.
+    The coordinates are changed when they can show the moved shape exactly, otherwise the matrix is put
+    in front of the transform attribute of the shape. Shapes inside a group with a transform are moved
+    so they still end up moved by the matrix after the transform of the group.
+    With GROUP in elementMask, the groups of the svg are moved as a whole by their transform attribute
+    instead, and the shapes in them are not changed. The svg must be validated after
+ *@return a boolean value indicating success or failure of the function, on failure some shapes may be moved
+ *@param
+    img - a pointer to an SVG struct
+    matrix - the 6 numbers of the matrix
+    elementMask - SVG_ELEMENT_MASK of the types to move, or'ed together, like SVG_SHAPES_MASK
+ **/
+bool transformSVG(SVG* img, const float matrix[6], unsigned elementMask);
+
 /** Function to converting an Attribute into a JSON string
 *@pre Attribute is not NULL
 *@post Attribute has not been modified in any way
@@ -383,6 +704,38 @@ char* pathListToJSON(const List *list);
 **/
 char* groupListToJSON(const List *list);
 
+/** Functions to convert a Line, an Ellipse, or a Polyline or Polygon into a JSON string
+*@pre the struct is not NULL
+*@post the struct has not been modified in any way
+*@return A string in JSON format, {} for NULL
+    line: {"x1":...,"y1":...,"x2":...,"y2":...,"numAttr":...,"units":"..."}
+    ellipse: {"cx":...,"cy":...,"rx":...,"ry":...,"numAttr":...,"units":"..."}
+    polyline or polygon: {"numPoints":...,"points":[x0,y0,x1,y1,...],"numAttr":...}
+**/
+char* lineToJSON(const Line *l);
+char* ellipseToJSON(const Ellipse *e);
+char* polylineToJSON(const Polyline *p);
+
+/** Functions to convert a list of Line, Ellipse, or Polyline or Polygon structs into a JSON array
+*@pre list is not NULL
+*@post list has not been modified in any way
+*@return A string in JSON format, [] for NULL
+**/
+char* lineListToJSON(const List *list);
+char* ellipseListToJSON(const List *list);
+char* polylineListToJSON(const List *list);
+
+/** Function to converting a page of a list of shape or Group structs into a JSON string
+*@pre list contains structs of the given type, or is NULL
+*@post list has not been modified in any way
+*@return A string in JSON format: {"total":numInList,"offset":offset,"items":[...]}
+*@param list - a pointer to a List struct
+*@param type - the type of the structs in the list, RECT, CIRC, PATH, GROUP, LINE, ELLIPSE, POLYLINE, or POLYGON
+*@param offset - index of the first element in the page
+*@param limit - maximum number of elements in the page
+**/
+char* listToJSONRange(const List *list, elementType type, int offset, int limit);
+
 /** Function to converting an SVG into a JSON string
 *@pre SVG is not NULL
 *@post SVG has not been modified in any way
@@ -391,6 +744,15 @@ char* groupListToJSON(const List *list);
 **/
 char* SVGtoJSON(const SVG* img);
 
+/** Function to converting the shapes of an SVG into a packed binary buffer (see SVGBinary.h)
+*@pre SVG is not NULL
+*@post SVG has not been modified in any way
+*@return A newly allocated buffer, the number of bytes is also stored in its header
+*@param img - a pointer to an SVG struct
+*@param length - set to the number of bytes in the buffer, may be NULL
+**/
+unsigned char* SVGtoBinary(const SVG* img, size_t* length);
+
 /* ******************************* Bonus A2 functions - optional for A2 *************************** */
 
 /** Function to converting a JSON string into an SVG struct
@@ -417,6 +779,14 @@ Rectangle* JSONtoRect(const char* svgString);
 **/
 Circle* JSONtoCircle(const char* svgString);
 
+/** Function to converting a JSON string into a Path struct
+*@pre JSON string is not NULL
+*@post Path has not been modified in any way
+*@return A newly allocated and initialized Path struct
+*@param str - a pointer to a string
+**/
+Path* JSONtoPath(const char* svgString);
+
 
 /* ******************************* List helper functions  - MUST be implemented *************************** */
 
@@ -424,6 +794,10 @@ void deleteAttribute( void* data);
 char* attributeToString(void* data);
 int compareAttributes(const void *first, const void *second);
 
+void deleteRawElement(void* data);
+char* rawElementToString(void* data);
+int compareRawElements(const void *first, const void *second);
+
 void deleteGroup(void* data);
 char* groupToString(void* data);
 int compareGroups(const void *first, const void *second);
@@ -440,4 +814,16 @@ void deletePath(void* data);
 char* pathToString(void* data);
 int comparePaths(const void *first, const void *second);
 
+void deleteLine(void* data);
+char* lineToString(void* data);
+int compareLines(const void *first, const void *second);
+
+void deleteEllipse(void* data);
+char* ellipseToString(void* data);
+int compareEllipses(const void *first, const void *second);
+
+void deletePolyline(void* data);
+char* polylineToString(void* data);
+int comparePolylines(const void *first, const void *second);
+
 #endif
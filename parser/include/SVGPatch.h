@@ -0,0 +1,76 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGPATCH_H
+#define SVGPATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "SVGParser.h"
+
+/*
+    Small edits (the title, the description, or one attribute of a shape) are made by replacing only the
+    bytes of the old value in the file, instead of parsing, validating and writing the whole file again.
+    The file is scanned (without libxml2) for the byte spans of the elements the edit needs, the new value is
+    checked against the schema in a tiny document made of just the svg and the edited element, and the file
+    is written again as the bytes before the span, the new value, and the bytes after it.
+    When anything in the file is not simple enough to be sure the span is the one createSVG would use,
+    or the xml declaration names an encoding other than UTF-8, the patch functions return false and the
+    caller does the full edit instead.
+    A file with an edit journal (see SVGJournal.h) is never patched, the full edit writes the journal into it.
+
+    Only the edited element is validated, not the whole file: a file that was valid is still valid after a
+    patch, but a file that was already invalid somewhere else is patched where the full edit (createValidSVG)
+    would refuse it. The file list only shows the files that are valid, so the server only edits those.
+*/
+
+// A range of bytes in the file, start is the first byte and end is one past the last
+typedef struct {
+    size_t start;
+    size_t end;
+} ByteSpan;
+
+typedef struct {
+    // the start tag, from the < to one past the >
+    ByteSpan tag;
+    // the bytes between the start and the end tag
+    ByteSpan content;
+    bool selfClosing;
+    // the content is only text, no elements, comments or CDATA sections
+    bool simple;
+} ElementSpan;
+
+typedef struct {
+    const char* data;
+    size_t length;
+    ElementSpan root;
+    // every title and desc outside of a group is read by createSVG, so a patch needs there to be exactly one
+    ElementSpan title;
+    int numTitles;
+    ElementSpan desc;
+    int numDescs;
+    // the shape or group to find, numbered the same way as the lists in the SVG struct
+    elementType targetType;
+    int targetIndex;
+    ElementSpan target;
+    bool targetFound;
+} SVGSpans;
+
+// Functions to read the file and find the spans
+bool mapFile(const char* fileName, const char** data, size_t* length);
+void unmapFile(const char* data, size_t length);
+bool stringAt(const char* data, size_t length, size_t pos, const char* string);
+size_t findString(const char* data, size_t length, size_t pos, const char* string);
+size_t endOfTag(const char* data, size_t length, size_t pos, bool* selfClosing);
+bool tagNameIs(const char* data, size_t length, size_t pos, const char* name);
+bool scanSVGSpans(SVGSpans* spans);
+bool findAttributeSpan(const char* data, const ElementSpan* element, const char* name, ByteSpan* value);
+
+// Functions to check and write a patch
+bool validPatch(const SVGSpans* spans, const ElementSpan* element, const char* name, const char* value, const char* schemaFile);
+bool spliceFile(const char* fileName, const char* data, size_t length, ByteSpan span, const char* value, bool attribute);
+
+// Functions that make the edits, return false when the edit could not be made by patching
+bool patchTitleDesc(const char* fileName, const char* elementName, const char* newValue, const char* schemaFile);
+bool patchAttribute(const char* fileName, elementType type, int index, const char* name, const char* value, const char* schemaFile);
+
+#endif
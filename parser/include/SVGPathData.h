@@ -0,0 +1,47 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGPATHDATA_H
+#define SVGPATHDATA_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+#include "SVGStringBuilder.h"
+
+/*
+    The d attribute of a path read into commands and numbers, so the geometry can be used without reading the text again.
+    Every segment has its own command letter, the repeats that the text leaves out (like the line tos after a move to)
+    are written in, and the numbers of all the segments are in one array in the order of the text.
+    The struct, its numbers and its commands are one allocation, freed with free.
+*/
+struct PathData {
+    int numCommands;
+    int numCoords;
+
+    //The numbers of each segment one after the other, numArgs(command) of them for each command
+    float* coords;
+
+    //One letter of MLHVCSQTAZ, or the lower case for relative, for each segment
+    char* commands;
+};
+
+// Functions to read and write the path data
+int numArgs(char command);
+bool pathSpace(char c);
+bool readPathNumber(const char** cursor, float* number);
+bool readPathFlag(const char** cursor, float* number);
+PathData* parsePathData(const char* data);
+void appendPathNumber(StringBuilder* builder, float number, bool first, bool* lastHasPoint);
+char* pathDataToString(const PathData* pathData);
+
+// Functions for the parse that is kept in the path
+PathData* getPathData(Path* path);
+void clearPathData(Path* path);
+bool setPathData(Path* path, const char* data);
+bool updatePath(Path* path);
+
+// Functions to scale the paths about their first point, like scaleRectangles keeps x and y
+void scalePathData(PathData* pathData, float scaleValue);
+bool scalePathList(List* pathList, float scaleValue);
+bool scaleGroupPaths(List* groupList, float scaleValue);
+
+#endif
@@ -0,0 +1,87 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGPATHSTORE_H
+#define SVGPATHSTORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "SVGParser.h"
+
+// the fewest buckets of the store and of a table of counts, they double when they are three quarters full
+#define SVG_PATH_STORE_MIN 64
+#define SVG_PATH_COUNTS_MIN 16
+
+/*
+    The store of path data. The data of every path is kept here once, with the number of paths that have it, so icon
+    sets that repeat the same d hundreds of times keep it once. A path holds the string of the store (see Path), it is
+    given a string by storePathData and gives it back with releasePathData, and the string is freed when the last path
+    that has it gives it back. The strings are found by the hash of their exact text, and each keeps the hash of its
+    text in lower case too, for the counts below.
+*/
+typedef struct PathString {
+    // the next string in the bucket of the store
+    struct PathString* next;
+    uint32_t hash;
+    uint32_t caseHash;
+    // the paths, and the tables of counts, that have the string
+    int refs;
+    char data[];
+} PathString;
+
+/*
+    The number of paths of an svg and of all its groups with each path data, so numPathsWithdata is one hash lookup
+    instead of a strcasecmp against every path. The data are compared like the query compares them, with the case of
+    the letters left out, so a bucket counts all the paths whose data differ only in case, and keeps the string of
+    the store of the first of them.
+
+    The counts are made by getPathCounts (svgNumPathsWithData calls it for a session) and are kept in the svg with
+    the version of the svg they count, like the area histogram (see SVGAreaIndex.h), and numPathsWithdata only reads
+    them while they are up to date. A path that is added is counted and a path whose data is set is moved from its
+    old data to its new one, any other change to the paths makes the counts out of date.
+*/
+typedef struct {
+    // a string of the store, NULL for a bucket that was never used
+    const char* data;
+    int count;
+} PathCountBucket;
+
+struct PathCounts {
+    // the version of the svg the table counts
+    unsigned version;
+    PathCountBucket* buckets;
+    int capacity;
+    int used;
+};
+
+// A change to one path, from before it is changed to after, see beginPathChange
+typedef struct {
+    SVG* img;
+    // the path that is changed and its data before, NULL when the change moves no path
+    Path* path;
+    const char* data;
+    // true if the counts were up to date before the change
+    bool current;
+} PathChange;
+
+// Functions for the store
+uint32_t hashPathData(const char* data, bool foldCase);
+const char* storePathData(const char* data);
+const char* retainPathData(const char* data);
+void releasePathData(const char* data);
+int pathDataRefs(const char* data);
+
+// Functions for the counts of an svg
+PathCounts* buildPathCounts(const SVG* img);
+PathCounts* getPathCounts(SVG* img);
+bool pathCountsCurrent(const SVG* img);
+bool addPathCount(PathCounts* counts, const char* data, int count);
+int pathCount(const PathCounts* counts, const char* data);
+void deletePathCounts(PathCounts* counts);
+
+// Functions to keep the counts up to date with the changes to the paths
+void countPathData(SVG* img, elementType type, void* shape, bool current);
+void beginPathChange(SVG* img, elementType type, void* shape, PathChange* change);
+void endPathChange(PathChange* change);
+int countPathsWithData(const SVG* img, const char* data);
+
+#endif
@@ -0,0 +1,91 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGSELECTOR_H
+#define SVGSELECTOR_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+#include "SVGStringBuilder.h"
+
+/*
+    A small selector language for the elements of an svg and of all its groups, so the server can ask for any set of
+    elements without a new query function for each question. A selector is compiled once into a plan and the plan is
+    run over the tree, it is made of steps like css:
+
+        rect[width>10]               rectangles wider than 10
+        g > rect[fill=red]           red rectangles that are children of a group
+        g circle[r<=5]               small circles in a group at any depth
+        path[id^=icon], polygon      paths whose id starts with icon, and every polygon
+
+    A step is an element name (svg, g, rect, circle, path, line, ellipse, polyline, polygon or * for any element) with
+    any number of tests in brackets. The steps are joined by > for a child or by spaces for any descendant, and
+    the selectors of a list are joined by commas. A test is [name] for an element that has the attribute, or
+    [name op value] with = != ^= $= *= < <= > >=, the value may be quoted. The numbers of the structs (x, width, cx, r, ...)
+    and d and points are attributes like the other attributes, and there are two made up ones: area, of a rect,
+    circle or ellipse, and len, the number of children of a group like numGroupsWithLen.
+    The comparisons are of numbers, and = and != are too when the value is a number, otherwise they compare the text.
+
+    The plan keeps the types the selector can return, so the walk only reads the lists of those types.
+    The elements found are named by their element paths (see SVGElementPath.h).
+*/
+typedef enum SELECT{
+    SELECT_HAS, SELECT_EQUAL, SELECT_NOT_EQUAL, SELECT_PREFIX, SELECT_SUFFIX, SELECT_CONTAINS,
+    SELECT_LESS, SELECT_LESS_EQUAL, SELECT_GREATER, SELECT_GREATER_EQUAL
+} selectorOp;
+
+typedef struct {
+    char* name;
+    selectorOp op;
+    // the value, NULL for SELECT_HAS, and the value read as a number when it is one
+    char* value;
+    bool numeric;
+    float number;
+} SelectorTest;
+
+typedef struct {
+    // the type of the element, any type when anyType is true
+    bool anyType;
+    elementType type;
+    // true when the element must be a child of the element of the step before, false for any descendant
+    bool child;
+    SelectorTest* tests;
+    int numTests;
+} SelectorStep;
+
+typedef struct {
+    SelectorStep* steps;
+    int numSteps;
+} SelectorChain;
+
+typedef struct {
+    // the selectors of the list, an element is found when any of them matches it
+    SelectorChain* chains;
+    int numChains;
+    // the types the last step of a chain can be, SVG_ELEMENT_MASK of each
+    unsigned typeMask;
+} Selector;
+
+// An element found by a selector, the element at index in the list of its type in parent (NULL for the svg)
+typedef struct {
+    elementType type;
+    void* element;
+    Group* parent;
+    int index;
+    // the element path, "svg" for the svg itself
+    char* path;
+} SelectorMatch;
+
+// Functions to compile a selector
+Selector* compileSelector(const char* text);
+void deleteSelector(Selector* selector);
+
+// Functions to run the plan
+bool matchSelectorStep(const SelectorStep* step, elementType type, void* element);
+int countSelected(SVG* img, const Selector* selector);
+SelectorMatch* selectElements(SVG* img, const Selector* selector, int* count);
+void freeSelectorMatches(SelectorMatch* matches, int count);
+char* selectorMatchesToJSON(const SelectorMatch* matches, int count);
+int countSelectorMatches(SVG* img, const char* text);
+char* selectToJSON(SVG* img, const char* text);
+
+#endif
@@ -0,0 +1,70 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGSESSION_H
+#define SVGSESSION_H
+
+#include <stdbool.h>
+#include <time.h>
+#include <sys/types.h>
+#include "SVGParser.h"
+#include "SVGStringBuilder.h"
+
+#define SVG_MAX_SESSIONS 32
+#define SVG_SESSION_IDLE_SECONDS 300
+#define SVG_SESSION_SCHEMA "uploads/svg.xsd"
+
+/*
+    An open file for the svgOpen functions in SVGParser.h. The file is read once when it is opened, and the getters
+    and edits use the struct in memory until svgFlush writes it back. Opening a file that is already open gives the
+    same handle and counts one more reference, the session is only closed when every reference is closed.
+    A session not used for SVG_SESSION_IDLE_SECONDS is written and its struct freed, the handle stays open
+    and the file is read again the next time it is used.
+    The edits that are not written yet are also kept in the format of applyJSONEdit, so an edit that fails is
+    undone by reading the file again and applying them, and the edits before it are kept.
+*/
+typedef struct {
+    //The handle given by svgOpen, 0 when the slot is free
+    int handle;
+    int refCount;
+    char* fileName;
+
+    //The file read into a struct.  NULL when it was freed after being idle
+    SVG* img;
+    //True when img has edits that are not in the file yet
+    bool dirty;
+    //Those edits, as the objects of a JSON array of edits without its brackets.  Failed when they could not all be kept
+    StringBuilder edits;
+    //Where the edit being made starts in edits, it is taken out again when it fails
+    size_t editStart;
+    time_t lastUsed;
+
+    //The file as it was when img was read or written, to find when something else changed it
+    time_t modified;
+    long modifiedNanos;
+    off_t size;
+    ino_t inode;
+    //Bytes in the edit journal of the file, -1 when it has none
+    long journalSize;
+} SVGSession;
+
+// Functions to find, read and write the sessions
+SVGSession* findSession(int handle);
+SVGSession* findSessionNamed(const char* fileName);
+bool statSession(SVGSession* session);
+bool fileChanged(const SVGSession* session);
+bool loadSession(SVGSession* session);
+void unloadSession(SVGSession* session);
+bool flushSession(SVGSession* session);
+void freeSession(SVGSession* session);
+void sweepSessions(time_t now);
+
+// Functions for the getters and the edits
+SVGSession* useSession(int handle);
+bool restoreSession(SVGSession* session);
+bool finishEdit(SVGSession* session, bool applied);
+void beginSessionEdit(SVGSession* session, const char* op);
+void appendEditString(SVGSession* session, const char* name, const char* value);
+void endSessionEdit(SVGSession* session);
+void logSessionEdits(SVGSession* session, const char* edits, const char* op);
+
+#endif
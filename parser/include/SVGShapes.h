@@ -0,0 +1,66 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGSHAPES_H
+#define SVGSHAPES_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+#include "SVGStringBuilder.h"
+
+/*
+    Lines, ellipses, polylines and polygons. They are read, checked, converted and written the same way as
+    rectangles and circles, and the points of polylines and polygons are read once into the float array of
+    the struct. Their lists in the SVG and Group structs may be NULL, every function here takes a NULL list as empty.
+    Polylines and polygons share the Polyline struct and its functions, the type says which element it is.
+*/
+
+// Functions to create the structs and lists
+List* initShapeList(elementType type);
+List** svgShapeList(SVG* img, elementType type);
+List* svgComponentList(const SVG* img, elementType type);
+List** groupShapeList(Group* group, elementType type);
+const char* shapeElementName(elementType type);
+elementType componentTypeNamed(const char* componentType);
+int parsePoints(const char* string, float* points, int maxNumbers, const char** end);
+Line* lineAttributes(xmlNode* cur_node);
+Ellipse* ellipseAttributes(xmlNode* cur_node);
+Polyline* polylineAttributes(xmlNode* cur_node);
+bool addShapeNode(xmlNode* cur_node, List** list, elementType type, ElementPlace* place);
+
+// Functions to find the shapes in the groups, and count them and their attributes
+void dummyDeleteShape(void* data);
+void collectShapes(List* groupList, List* dest, elementType type);
+List* getShapes(const SVG* img, elementType type);
+List* shapeOtherAttributes(void* shape, elementType type);
+ElementPlace* shapePlace(void* shape, elementType type);
+int getShapeAttrLen(List* list, elementType type);
+int getShapesAttrLen(List* lines, List* ellipses, List* polylines, List* polygons);
+int numGroupChildren(const Group* group);
+
+// String representation helper functions
+void appendLineString(StringBuilder* builder, const Line* line);
+void appendEllipseString(StringBuilder* builder, const Ellipse* ellipse);
+void appendPolylineString(StringBuilder* builder, const Polyline* poly);
+void appendShapeListString(StringBuilder* builder, List* list, elementType type, const char* label, const char* end);
+void appendPoints(StringBuilder* builder, const Polyline* poly, int precision);
+char* pointsToString(const Polyline* poly, int precision);
+char* shapeToJSON(void* shape, elementType type);
+char* shapeListToJSON(const List* list, elementType type);
+
+// Functions to check for validity
+bool validLineStruct(Line* line);
+bool validEllipseStruct(Ellipse* ellipse);
+bool validPolylineStruct(Polyline* poly);
+bool validShapeStruct(void* shape, elementType type);
+bool validShapeListStruct(List* list, elementType type);
+
+// Function to write a shape list to a node in the xml tree, valid is NULL or set to false when a struct is not valid
+void addShapeListToParentNode(List* list, elementType type, xmlNodePtr* parent, bool* valid);
+
+// Functions to change the shapes
+Polyline* reservePoints(Polyline* poly, int numPoints);
+bool changeValueInShape(List* list, elementType type, int index, Attribute* newAttribute);
+void scaleShape(void* shape, elementType type, float scaleValue);
+bool scaleShapes(SVG* img, elementType type, float scaleValue);
+
+#endif
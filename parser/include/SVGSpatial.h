@@ -0,0 +1,90 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGSPATIAL_H
+#define SVGSPATIAL_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+#include "SVGBounds.h"
+#include "SVGStringBuilder.h"
+
+// the most children of a node of the tree
+#define SPATIAL_NODE_SIZE 16
+
+/*
+    An R-tree of the boxes of the shapes of an svg and of all its groups, so the shapes in a region or under a
+    point are found without testing every shape. The tree is made when the svg is first queried, packed by
+    sort-tile-recursive (the boxes sorted by x into slices, and every slice by y into full nodes), and is kept in
+    the svg. A shape added with addComponent or to a group is inserted into the tree, and any other change to the
+    geometry of the shapes (see touchSVG) makes the tree out of date, so the next query packs it again.
+
+    Every shape is an entry, with its box in the numbers of the svg (the transforms of its groups and its own
+    transform applied) and the matrix that takes it there. The groups the shapes are in are kept once each, with
+    their element paths (see SVGElementPath.h), so a result names every shape like "g0/g2/rect3".
+*/
+typedef struct {
+    Bounds box;
+    // the matrix from the numbers of the shape to the numbers of the svg
+    float matrix[6];
+    elementType type;
+    // the index of the shape in the list of its type, and its group in the groups of the index
+    int index;
+    int group;
+    void* element;
+} SpatialEntry;
+
+// a group that has shapes in the index, NULL and "" are the svg itself
+typedef struct {
+    Group* group;
+    char* path;
+    float matrix[6];
+} SpatialGroup;
+
+typedef struct SpatialNode {
+    Bounds box;
+    bool leaf;
+    int count;
+    // the children of an inner node, or the entries of a leaf
+    union {
+        struct SpatialNode* nodes[SPATIAL_NODE_SIZE];
+        int entries[SPATIAL_NODE_SIZE];
+    } children;
+} SpatialNode;
+
+struct SpatialIndex {
+    // the version of the svg the tree was made for, see touchSVG
+    unsigned version;
+
+    SpatialEntry* entries;
+    int numEntries;
+    int maxEntries;
+
+    SpatialGroup* groups;
+    int numGroups;
+    int maxGroups;
+
+    SpatialNode* root;
+};
+
+// Functions to keep the index up to date with the svg
+void touchSVG(SVG* img);
+bool geometryAttribute(const char* name);
+void shapeAdded(SVG* img, Group* group, elementType type, void* element);
+
+// Functions for the index
+SpatialIndex* buildSpatialIndex(SVG* img);
+SpatialIndex* getSpatialIndex(SVG* img);
+bool insertSpatialEntry(SpatialIndex* index, int group, elementType type, int elementIndex, void* element);
+void deleteSpatialNode(SpatialNode* node);
+void deleteSpatialIndex(SpatialIndex* index);
+
+// Functions to query the index, the results are indices into the entries, which the caller must free
+int* queryRegion(SVG* img, const Bounds* region, int* count);
+int* hitTest(SVG* img, float x, float y, int* count);
+bool entryHit(const SpatialEntry* entry, float x, float y);
+char* spatialEntryPath(const SpatialIndex* index, int entry);
+char* spatialResultToJSON(const SpatialIndex* index, const int* entries, int count);
+char* queryRegionToJSON(SVG* img, float x, float y, float width, float height);
+char* hitTestToJSON(SVG* img, float x, float y);
+
+#endif
@@ -0,0 +1,39 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGSTRINGBUILDER_H
+#define SVGSTRINGBUILDER_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+    A growable string that the toString and JSON functions append to, so a whole document is written
+    into one buffer instead of building, copying and freeing a string for every element.
+    The buffer doubles when it runs out of space, and is always NUL terminated.
+*/
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    // set when an allocation fails, every append after that is ignored and finishBuilder returns NULL
+    bool failed;
+} StringBuilder;
+
+bool initBuilder(StringBuilder* builder, size_t capacity);
+bool reserveBuilder(StringBuilder* builder, size_t extra);
+void appendBytes(StringBuilder* builder, const char* bytes, size_t length);
+void appendString(StringBuilder* builder, const char* string);
+void appendChar(StringBuilder* builder, char c);
+void appendFormat(StringBuilder* builder, const char* format, ...);
+
+// Functions to append text that goes inside a JSON string, with quotes, backslashes and control characters escaped
+size_t cleanJSONSpan(const char* string, size_t length);
+void appendJSONEscaped(StringBuilder* builder, const char* string, size_t length);
+void appendJSONString(StringBuilder* builder, const char* string);
+
+// returns the string, which the caller must free, or NULL if any append failed
+char* finishBuilder(StringBuilder* builder);
+void freeBuilder(StringBuilder* builder);
+
+#endif
@@ -0,0 +1,49 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGTRANSFORM_H
+#define SVGTRANSFORM_H
+
+#include <stdbool.h>
+#include "SVGParser.h"
+#include "SVGPathData.h"
+
+#define SVG_PI 3.14159265358979323846
+
+/*
+    Affine transforms of the shapes, see transformSVG in SVGParser.h.
+    A matrix is the 6 numbers of the svg matrix(a b c d e f): x' = a x + c y + e and y' = b x + d y + f.
+    The points are moved by one kernel over x, y pairs that are next to each other in memory, so the
+    points of all the shapes of a list, or of a run of path segments, are moved by one call.
+    A shape whose numbers cannot show the moved shape exactly (a rotated rectangle, a shape with units or
+    its own transform) is left as it is, and the matrix is put in front of its transform attribute instead.
+*/
+
+// Functions for the matrices
+void identityMatrix(float matrix[6]);
+void multiplyMatrix(const float first[6], const float second[6], float result[6]);
+bool invertMatrix(const float matrix[6], float result[6]);
+void rotationMatrix(float angle, float matrix[6]);
+void composeMatrix(float translateX, float translateY, float angle, float scaleValue, float matrix[6]);
+bool parseTransform(const char* transform, float matrix[6]);
+bool axisAlignedMatrix(const float matrix[6]);
+bool rightAngleMatrix(const float matrix[6]);
+bool similarityMatrix(const float matrix[6]);
+
+// Kernel to move x, y pairs, the vectors of relative path data are moved with the translation set to 0
+void transformPoints(const float matrix[6], float* xy, int numPoints);
+
+// Functions for the transform attribute
+const char* transformAttribute(List* attrList);
+bool composeTransformAttribute(List* attrList, const float matrix[6]);
+
+// Functions to move the shapes
+bool exactShape(void* shape, elementType type, const float matrix[6]);
+float* shapePoints(void* shape, elementType type, int* numPoints);
+bool wholePoints(const float* xy, int numPoints);
+bool transformPathData(PathData* pathData, const float matrix[6]);
+bool transformPathList(List* pathList, const float matrix[6]);
+bool transformList(List* list, elementType type, const float matrix[6]);
+bool transformElements(List* lists[], const float matrix[6], unsigned elementMask);
+bool transformGroups(List* groupList, const float matrix[6], unsigned elementMask);
+
+#endif
@@ -0,0 +1,81 @@
+// Name: Haifaa Abushaaban
+
+#ifndef SVGWRITER_H
+#define SVGWRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zlib.h>
+#include "SVGParser.h"
+
+#define SVG_WRITER_BUFFER_SIZE 65536
+// the raw elements, lines, ellipses, polylines and polygons of an svg or group, the lists whose elements have a place
+#define SVG_PLACED_LISTS 5
+
+/*
+    Writes an svg struct straight to a file descriptor through one fixed buffer, instead of building
+    an xmlDoc first. With the default options the output is the same as xmlSaveFormatFileEnc gives for the
+    tree made by createXMLFromStruct: the xml declaration, two spaces of indent per level, and the same escaping.
+    Files named .svgz are compressed with gzip on the way out.
+*/
+typedef struct {
+    int fd;
+    // the file being replaced, and the temp file in the same directory that is renamed over it by closeWriter
+    char* fileName;
+    char* tempName;
+    // set for .svgz files, the output goes through zlib before it reaches fd
+    gzFile gz;
+    char buffer[SVG_WRITER_BUFFER_SIZE];
+    size_t length;
+    // set when a write fails, every write after that is ignored and closeWriter returns false
+    bool failed;
+    // the layout of the file, and the inherited attributes the ancestors of the current element set
+    SVGWriteOptions options;
+    unsigned inheritedSet;
+    // the lists of the svg or group whose children are being written with elements that have a place, the raw elements
+    // and then the shapes from LINE to POLYGON, each element read from a file goes after the child it was read after
+    List* placedLists[SVG_PLACED_LISTS];
+} SVGWriter;
+
+// The elements of the placed lists that come after the children of one type, see ElementPlace. Each list is in the
+// order of the document, so the next one of each list is the next one to write after the children of the type
+typedef struct {
+    elementType type;
+    ListIterator iters[SVG_PLACED_LISTS];
+    void* next[SVG_PLACED_LISTS];
+} PlacedCursor;
+
+// Functions to open, fill and close the buffered output
+bool openWriter(SVGWriter* writer, const char* fileName);
+void flushWriter(SVGWriter* writer);
+void writeToFile(SVGWriter* writer, const char* bytes, size_t length);
+bool closeWriter(SVGWriter* writer);
+void freeWriterNames(SVGWriter* writer);
+void writeBytes(SVGWriter* writer, const char* bytes, size_t length);
+void writeString(SVGWriter* writer, const char* string);
+void writeEscaped(SVGWriter* writer, const char* string, bool attribute);
+void writeIndent(SVGWriter* writer, int depth);
+void writeNewline(SVGWriter* writer);
+
+// Functions for the durability of the rename, see writeDurability in SVGParser.h
+char* tempFileName(const char* fileName);
+bool syncDirectory(const char* fileName);
+bool syncFile(const char* fileName);
+void addPendingSync(const char* fileName);
+
+// Functions to write the attributes and elements, depth is the indent level of the element
+void writeAttribute(SVGWriter* writer, const char* name, const char* value);
+void writeNumberAttribute(SVGWriter* writer, const char* name, float number, const char* units);
+void writeTextElement(SVGWriter* writer, const char* name, const char* text, int depth);
+void writeAttrList(SVGWriter* writer, List* list);
+void writeRectList(SVGWriter* writer, List* rectList, int depth);
+void writeCircList(SVGWriter* writer, List* circList, int depth);
+void writePathList(SVGWriter* writer, List* pathList, int depth);
+void writeShape(SVGWriter* writer, void* shape, elementType type, int depth);
+void writeShapeList(SVGWriter* writer, List* list, elementType type, int depth);
+void writeGroupList(SVGWriter* writer, List* groupList, int depth);
+PlacedCursor placedCursor(const SVGWriter* writer, elementType type);
+void writePlacedAfter(SVGWriter* writer, PlacedCursor* cursor, int index, int depth);
+void writeSVGStruct(SVGWriter* writer, const SVG* img);
+
+#endif
@@ -23,6 +23,8 @@ List * initializeList(char* (*printFunction)(void* toBePrinted),void (*deleteFun
 	tmpList->deleteData = deleteFunction;
 	tmpList->compare = compareFunction;
 	tmpList->printData = printFunction;
+
+	tmpList->index = NULL;
 	
 	return tmpList;
 }
@@ -37,6 +39,9 @@ List * initializeList(char* (*printFunction)(void* toBePrinted),void (*deleteFun
 void freeList(List* list){	
 
     clearList(list);
+	if (list != NULL){
+		free(list->index);
+	}
 	free(list);
 }
 
@@ -57,6 +62,8 @@ void clearList(List* list){
 		return;
 	}
 	
+	invalidateIndex(list);
+
 	Node* tmp;
 	
 	while (list->head != NULL){
@@ -71,6 +78,14 @@ void clearList(List* list){
 	list->length = 0;
 }
 
+/**Discards the array of nodes used by getElementAt, called whenever nodes are added or removed
+*@param list pointer to the List-type dummy node
+**/
+void invalidateIndex(List* list){
+	free(list->index);
+	list->index = NULL;
+}
+
 /**Function for creating a node for the linked list. 
 * This node contains abstracted (void *) data as well as previous and next
 * pointers to connect to other nodes in the list
@@ -105,6 +120,7 @@ void insertBack(List* list, void* toBeAdded){
 		return;
 	}
 	
+	invalidateIndex(list);
 	(list->length)++;
 
 	Node* newNode = initializeNode(toBeAdded);
@@ -130,6 +146,7 @@ void insertFront(List* list, void* toBeAdded){
 		return;
 	}
 	
+	invalidateIndex(list);
 	(list->length)++;
 
 	Node* newNode = initializeNode(toBeAdded);
@@ -196,6 +213,7 @@ void* deleteDataFromList(List* list, void* toBeDeleted){
 			
 			void* data = delNode->data;
 			free(delNode);
+			invalidateIndex(list);
 			
 			(list->length)--;
 
@@ -252,6 +270,7 @@ void insertSorted(List *list, void *toBeAdded){
 			free(currDescr);
 			free(newDescr);
 		
+			invalidateIndex(list);
 			Node* newNode = initializeNode(toBeAdded);
 			newNode->next = currNode;
 			newNode->previous = currNode->previous;
@@ -277,18 +296,41 @@ returned string must be freed by the calling function.
  **/
 char* toString(List * list){
 	ListIterator iter = createIterator(list);
+	size_t length = 0;
+	size_t capacity = 64;
 	char* str;
 		
-	str = (char*)malloc(sizeof(char));
+	str = (char*)malloc(sizeof(char) * capacity);
+	if (str == NULL){
+		return NULL;
+	}
 	strcpy(str, "");
 	
 	void* elem;
 	while((elem = nextElement(&iter)) != NULL){
 		char* currDescr = list->printData(elem);
-		int newLen = strlen(str)+50+strlen(currDescr);
-		str = (char*)realloc(str, newLen);
-		strcat(str, "\n");
-		strcat(str, currDescr);
+		if (currDescr == NULL){
+			continue;
+		}
+		size_t descrLen = strlen(currDescr);
+
+		//Grow by doubling, so the string is copied O(log n) times instead of once per element
+		if (length + descrLen + 2 > capacity){
+			while (length + descrLen + 2 > capacity){
+				capacity *= 2;
+			}
+			char* newStr = (char*)realloc(str, capacity);
+			if (newStr == NULL){
+				free(currDescr);
+				free(str);
+				return NULL;
+			}
+			str = newStr;
+		}
+
+		str[length++] = '\n';
+		memcpy(str + length, currDescr, descrLen + 1);
+		length += descrLen;
 		
 		free(currDescr);
 	}
@@ -319,6 +361,31 @@ int getLength(List* list){
 	return list->length;
 }
 
+void* getElementAt(List* list, int index){
+	Node* node = getNodeAt(list, index);
+	return (node == NULL) ? NULL : node->data;
+}
+
+Node* getNodeAt(List* list, int index){
+	if (list == NULL || index < 0 || index >= list->length){
+		return NULL;
+	}
+
+	if (list->index == NULL){
+		list->index = (Node**)malloc(sizeof(Node*) * list->length);
+		if (list->index == NULL){
+			return NULL;
+		}
+
+		int i = 0;
+		for (Node* tmp = list->head; tmp != NULL; tmp = tmp->next){
+			list->index[i++] = tmp;
+		}
+	}
+
+	return list->index[index];
+}
+
 void* findElement(List * list, bool (*customCompare)(const void* first,const void* second), const void* searchRecord){
 	if (customCompare == NULL)
 		return NULL;
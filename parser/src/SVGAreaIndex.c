@@ -0,0 +1,243 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelper.h"
+#include "SVGAreaIndex.h"
+
+bool initAreaTable(AreaTable* table, int capacity){
+
+    if (table == NULL) return false;
+
+    // a power of 2, so the probe wraps with a mask
+    int size = SVG_AREA_TABLE_MIN;
+    while (size < capacity && size < (1 << 30)) size *= 2;
+    capacity = size;
+
+    table->buckets = malloc(sizeof(AreaBucket) * capacity);
+    if (table->buckets == NULL) return false;
+
+    for (int i = 0; i < capacity; ++i){
+        table->buckets[i].count = -1;
+    }
+    table->capacity = capacity;
+    table->used = 0;
+    return true;
+}
+
+void freeAreaTable(AreaTable* table){
+
+    if (table == NULL) return;
+
+    free(table->buckets);
+    table->buckets = NULL;
+    table->capacity = 0;
+    table->used = 0;
+}
+
+// the bucket of the area, or the unused bucket it would go in, the capacity is a power of 2
+static AreaBucket* findAreaBucket(const AreaTable* table, int area){
+
+    uint32_t mask = (uint32_t)table->capacity - 1;
+    uint32_t i = ((uint32_t)area * 2654435761u) & mask;
+
+    while (table->buckets[i].count >= 0 && table->buckets[i].area != area){
+        i = (i + 1) & mask;
+    }
+
+    return &table->buckets[i];
+}
+
+static bool growAreaTable(AreaTable* table){
+
+    AreaTable grown;
+    if (initAreaTable(&grown, table->capacity * 2) == false) return false;
+
+    for (int i = 0; i < table->capacity; ++i){
+        if (table->buckets[i].count < 0) continue;
+
+        *findAreaBucket(&grown, table->buckets[i].area) = table->buckets[i];
+        ++grown.used;
+    }
+
+    free(table->buckets);
+    *table = grown;
+    return true;
+}
+
+/*
+    adds count shapes to the area, or takes them away when count is negative
+    an area whose count goes to 0 keeps its bucket, so the areas after it in the probe are still found
+*/
+bool addAreaCount(AreaTable* table, int area, int count){
+
+    if (table == NULL || table->buckets == NULL) return false;
+
+    if ((table->used + 1) * 4 > table->capacity * 3 && growAreaTable(table) == false) return false;
+
+    AreaBucket* bucket = findAreaBucket(table, area);
+    if (bucket->count < 0){
+        bucket->area = area;
+        bucket->count = 0;
+        ++table->used;
+    }
+
+    bucket->count += count;
+    if (bucket->count < 0) bucket->count = 0;
+    return true;
+}
+
+int areaCount(const AreaTable* table, int area){
+
+    if (table == NULL || table->buckets == NULL) return 0;
+
+    AreaBucket* bucket = findAreaBucket(table, area);
+    return (bucket->count < 0) ? 0 : bucket->count;
+}
+
+// the area the queries compare, for a rectangle or a circle
+int shapeAreaKey(const void* shape, elementType type){
+
+    if (type == RECT) return rectAreaKey((const Rectangle*)shape);
+    if (type == CIRC) return circleAreaKey((const Circle*)shape);
+    return 0;
+}
+
+AreaTable* areaTableOf(AreaIndex* areas, elementType type){
+
+    if (areas == NULL) return NULL;
+    if (type == RECT) return &areas->rects;
+    if (type == CIRC) return &areas->circles;
+    return NULL;
+}
+
+// counts every shape of the type in the svg and its groups into the table
+static bool countAreas(const SVG* img, elementType type, AreaTable* table){
+
+    List* shapes = (type == RECT) ? getRects(img) : getCircles(img);
+    if (shapes == NULL) return false;
+
+    bool valid = initAreaTable(table, getLength(shapes) * 2);
+    void* elem;
+    ListIterator iter = createIterator(shapes);
+    while (valid && (elem = nextElement(&iter)) != NULL){
+        valid = addAreaCount(table, shapeAreaKey(elem, type), 1);
+    }
+    if (valid == false) freeAreaTable(table);
+
+    freeList(shapes);
+    return valid;
+}
+
+// makes the histogram of the svg as it is now, the caller keeps it in the svg or frees it with deleteAreaIndex
+AreaIndex* buildAreaIndex(const SVG* img){
+
+    if (img == NULL) return NULL;
+
+    AreaIndex* areas = calloc(1, sizeof(AreaIndex));
+    if (areas == NULL) return NULL;
+    areas->version = img->version;
+
+    if (countAreas(img, RECT, &areas->rects) == false || countAreas(img, CIRC, &areas->circles) == false){
+        deleteAreaIndex(areas);
+        return NULL;
+    }
+
+    return areas;
+}
+
+// the histogram of the svg, made again when a change to the svg since it was made has made it out of date
+AreaIndex* getAreaIndex(SVG* img){
+
+    if (img == NULL) return NULL;
+    if (areaIndexCurrent(img)) return img->areas;
+
+    deleteAreaIndex(img->areas);
+    img->areas = buildAreaIndex(img);
+    return img->areas;
+}
+
+bool areaIndexCurrent(const SVG* img){
+
+    return img != NULL && img->areas != NULL && img->areas->version == img->version;
+}
+
+// counts the shapes of the type again, after they were all changed, the histogram is then up to date
+bool recountAreas(SVG* img, elementType type){
+
+    AreaTable* table = areaTableOf((img == NULL) ? NULL : img->areas, type);
+    if (table == NULL) return false;
+
+    AreaTable counted;
+    if (countAreas(img, type, &counted) == false) return false;
+
+    freeAreaTable(table);
+    *table = counted;
+    img->areas->version = img->version;
+    return true;
+}
+
+void deleteAreaIndex(AreaIndex* areas){
+
+    if (areas == NULL) return;
+
+    freeAreaTable(&areas->rects);
+    freeAreaTable(&areas->circles);
+    free(areas);
+}
+
+/*
+    counts a shape that was added, current is whether the histogram was up to date before it was added
+    (the svg has been touched since), the histogram is then up to date again
+*/
+void countShapeArea(SVG* img, elementType type, void* shape, bool current){
+
+    if (img == NULL || img->areas == NULL || current == false) return;
+
+    AreaTable* table = areaTableOf(img->areas, type);
+    if (table == NULL || addAreaCount(table, shapeAreaKey(shape, type), 1)) img->areas->version = img->version;
+}
+
+/*
+    called before a shape is changed, with the shape, or with NULL when the change moves no rectangle or circle,
+    endAreaChange is then called after the change, before anything else changes the svg
+*/
+void beginAreaChange(SVG* img, elementType type, void* shape, AreaChange* change){
+
+    change->img = img;
+    change->current = areaIndexCurrent(img);
+    change->type = type;
+    change->shape = (type == RECT || type == CIRC) ? shape : NULL;
+    change->area = (change->shape == NULL) ? 0 : shapeAreaKey(shape, type);
+}
+
+// moves the shape from its old area to its new one, the histogram is then up to date again
+void endAreaChange(AreaChange* change){
+
+    if (change->current == false || change->img->areas == NULL) return;
+
+    if (change->shape != NULL){
+        AreaTable* table = areaTableOf(change->img->areas, change->type);
+        int area = shapeAreaKey(change->shape, change->type);
+        if (area != change->area && (addAreaCount(table, change->area, -1) == false || addAreaCount(table, area, 1) == false)) return;
+    }
+
+    change->img->areas->version = change->img->version;
+}
+
+/*
+    the number of rectangles or circles of the svg and its groups with the area, after ceil like the queries
+    the svg is const so the histogram is only read, it is made by getAreaIndex
+    @return -1 if the svg has no histogram that is up to date, the caller then counts the shapes itself
+*/
+int countShapesWithArea(const SVG* img, elementType type, float area){
+
+    if (areaIndexCurrent(img) == false) return -1;
+
+    return areaCount(areaTableOf(img->areas, type), (int)ceil(area));
+}
@@ -0,0 +1,183 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGShapes.h"
+#include "SVGBounds.h"
+#include "SVGBinary.h"
+
+// number of bytes the names and values of an attribute list need in the string table
+uint32_t stringBytesInAttrList(List* list){
+
+    uint32_t bytes = 0;
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        Attribute* attr = (Attribute*) elem;
+        bytes += strlen(attr->name) + strlen(attr->value) + 2; // 2 for the \0s
+    }
+
+    return bytes;
+}
+
+// copies a string into the string table and returns its offset, empty strings all share offset 0
+uint32_t binaryString(BinaryWriter* writer, const char* string){
+
+    size_t length = strlen(string);
+    if (length == 0) return 0;
+
+    uint32_t offset = writer->stringLength;
+    memcpy(writer->strings + offset, string, length + 1);
+    writer->stringLength += length + 1;
+
+    return offset;
+}
+
+// writes the first attribute and number of attributes of a shape, and the attributes themselves
+void binaryAttrList(BinaryWriter* writer, List* list){
+
+    *(writer->info++) = writer->numAttrs;
+    *(writer->info++) = getLength(list);
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        Attribute* attr = (Attribute*) elem;
+        *(writer->attrs++) = binaryString(writer, attr->name);
+        *(writer->attrs++) = binaryString(writer, attr->value);
+        ++(writer->numAttrs);
+    }
+}
+
+/*
+    converts the shapes directly in the svg (the same ones as the get...JSON functions) into
+    the packed binary format described in SVGBinary.h
+    the first pass measures every section so the buffer is allocated once, the second pass fills it
+    caller must free the buffer
+*/
+unsigned char* SVGtoBinary(const SVG* img, size_t* length){
+
+    if (img == NULL) return NULL;
+
+    // 1. measure the sections
+    uint32_t numRects = getLength(img->rectangles);
+    uint32_t numCircs = getLength(img->circles);
+    uint32_t numPaths = getLength(img->paths);
+    uint32_t numGroups = getLength(img->groups);
+    uint32_t numAttrs = 0;
+    uint32_t stringBytes = 1; // the empty string at offset 0
+
+    void* elem;
+    ListIterator iter = createIterator(img->rectangles);
+    while ((elem = nextElement(&iter)) != NULL){
+        Rectangle* rect = (Rectangle*) elem;
+        numAttrs += getLength(rect->otherAttributes);
+        stringBytes += strlen(rect->units) + 1 + stringBytesInAttrList(rect->otherAttributes);
+    }
+    iter = createIterator(img->circles);
+    while ((elem = nextElement(&iter)) != NULL){
+        Circle* circ = (Circle*) elem;
+        numAttrs += getLength(circ->otherAttributes);
+        stringBytes += strlen(circ->units) + 1 + stringBytesInAttrList(circ->otherAttributes);
+    }
+    iter = createIterator(img->paths);
+    while ((elem = nextElement(&iter)) != NULL){
+        Path* path = (Path*) elem;
+        numAttrs += getLength(path->otherAttributes);
+        stringBytes += strlen(path->data) + 1 + stringBytesInAttrList(path->otherAttributes);
+    }
+    iter = createIterator(img->groups);
+    while ((elem = nextElement(&iter)) != NULL){
+        Group* group = (Group*) elem;
+        numAttrs += getLength(group->otherAttributes);
+        stringBytes += stringBytesInAttrList(group->otherAttributes);
+    }
+
+    // 2. lay out the sections one after the other
+    uint32_t header[SVG_BIN_HEADER_FIELDS];
+    header[SVG_BIN_MAGIC_FIELD] = SVG_BIN_MAGIC;
+    header[SVG_BIN_VERSION_FIELD] = SVG_BIN_VERSION;
+    header[SVG_BIN_NUM_RECTS] = numRects;
+    header[SVG_BIN_NUM_CIRCS] = numCircs;
+    header[SVG_BIN_NUM_PATHS] = numPaths;
+    header[SVG_BIN_NUM_GROUPS] = numGroups;
+    header[SVG_BIN_NUM_ATTRS] = numAttrs;
+    header[SVG_BIN_RECT_GEOMETRY] = sizeof(header);
+    header[SVG_BIN_CIRC_GEOMETRY] = header[SVG_BIN_RECT_GEOMETRY] + numRects * 4 * sizeof(float);
+    header[SVG_BIN_GROUP_GEOMETRY] = header[SVG_BIN_CIRC_GEOMETRY] + numCircs * 3 * sizeof(float);
+    header[SVG_BIN_RECT_INFO] = header[SVG_BIN_GROUP_GEOMETRY] + numGroups * 4 * sizeof(float);
+    header[SVG_BIN_CIRC_INFO] = header[SVG_BIN_RECT_INFO] + numRects * SVG_BIN_INFO_FIELDS * sizeof(uint32_t);
+    header[SVG_BIN_PATH_INFO] = header[SVG_BIN_CIRC_INFO] + numCircs * SVG_BIN_INFO_FIELDS * sizeof(uint32_t);
+    header[SVG_BIN_GROUP_INFO] = header[SVG_BIN_PATH_INFO] + numPaths * SVG_BIN_INFO_FIELDS * sizeof(uint32_t);
+    header[SVG_BIN_ATTRS] = header[SVG_BIN_GROUP_INFO] + numGroups * SVG_BIN_INFO_FIELDS * sizeof(uint32_t);
+    header[SVG_BIN_STRINGS] = header[SVG_BIN_ATTRS] + numAttrs * 2 * sizeof(uint32_t);
+    header[SVG_BIN_LENGTH] = header[SVG_BIN_STRINGS] + ((stringBytes + 3) & ~3u); // keep the total length aligned
+
+    unsigned char* data = calloc(header[SVG_BIN_LENGTH], 1);
+    if (data == NULL) return NULL;
+    memcpy(data, header, sizeof(header));
+
+    BinaryWriter writer;
+    writer.data = data;
+    writer.info = (uint32_t*)(data + header[SVG_BIN_RECT_INFO]);
+    writer.attrs = (uint32_t*)(data + header[SVG_BIN_ATTRS]);
+    writer.numAttrs = 0;
+    writer.strings = (char*)(data + header[SVG_BIN_STRINGS]);
+    writer.stringLength = 1;
+
+    // 3. fill the geometry and info sections, the geometry sections and the info sections are each consecutive so one
+    //    cursor is used for each
+    float* geometry = (float*)(data + header[SVG_BIN_RECT_GEOMETRY]);
+    iter = createIterator(img->rectangles);
+    while ((elem = nextElement(&iter)) != NULL){
+        Rectangle* rect = (Rectangle*) elem;
+        *(geometry++) = rect->x;
+        *(geometry++) = rect->y;
+        *(geometry++) = rect->width;
+        *(geometry++) = rect->height;
+        *(writer.info++) = binaryString(&writer, rect->units);
+        binaryAttrList(&writer, rect->otherAttributes);
+    }
+
+    iter = createIterator(img->circles);
+    while ((elem = nextElement(&iter)) != NULL){
+        Circle* circ = (Circle*) elem;
+        *(geometry++) = circ->cx;
+        *(geometry++) = circ->cy;
+        *(geometry++) = circ->r;
+        *(writer.info++) = binaryString(&writer, circ->units);
+        binaryAttrList(&writer, circ->otherAttributes);
+    }
+
+    iter = createIterator(img->paths);
+    while ((elem = nextElement(&iter)) != NULL){
+        Path* path = (Path*) elem;
+        *(writer.info++) = binaryString(&writer, path->data);
+        binaryAttrList(&writer, path->otherAttributes);
+    }
+
+    iter = createIterator(img->groups);
+    while ((elem = nextElement(&iter)) != NULL){
+        Group* group = (Group*) elem;
+        *(writer.info++) = numGroupChildren(group); // the same count as groupToJSON, with the lines, ellipses, polylines and polygons
+        binaryAttrList(&writer, group->otherAttributes);
+
+        // the box of the group, found again like groupToJSON does for a group whose box is not kept
+        Bounds bounds;
+        findGroupBounds(group, &bounds);
+        bool empty = boundsEmpty(&bounds);
+        *(geometry++) = empty ? NAN : bounds.minX;
+        *(geometry++) = empty ? NAN : bounds.minY;
+        *(geometry++) = empty ? NAN : bounds.maxX - bounds.minX;
+        *(geometry++) = empty ? NAN : bounds.maxY - bounds.minY;
+    }
+
+    if (length != NULL) *length = header[SVG_BIN_LENGTH];
+    return data;
+}
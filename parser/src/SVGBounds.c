@@ -0,0 +1,505 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGShapes.h"
+#include "SVGPathData.h"
+#include "SVGTransform.h"
+#include "SVGStringBuilder.h"
+#include "SVGElementPath.h"
+#include "SVGBounds.h"
+
+void emptyBounds(Bounds* bounds){
+
+    bounds->minX = INFINITY;
+    bounds->minY = INFINITY;
+    bounds->maxX = -INFINITY;
+    bounds->maxY = -INFINITY;
+}
+
+bool boundsEmpty(const Bounds* bounds){
+
+    return bounds->minX > bounds->maxX || bounds->minY > bounds->maxY;
+}
+
+void addBoundsPoint(Bounds* bounds, float x, float y){
+
+    if (isfinite(x) == 0 || isfinite(y) == 0) return;
+
+    if (x < bounds->minX) bounds->minX = x;
+    if (x > bounds->maxX) bounds->maxX = x;
+    if (y < bounds->minY) bounds->minY = y;
+    if (y > bounds->maxY) bounds->maxY = y;
+}
+
+void unionBounds(Bounds* bounds, const Bounds* other){
+
+    if (boundsEmpty(other)) return;
+
+    addBoundsPoint(bounds, other->minX, other->minY);
+    addBoundsPoint(bounds, other->maxX, other->maxY);
+}
+
+// true if the boxes share a point, the edges count
+bool boundsIntersect(const Bounds* first, const Bounds* second){
+
+    if (boundsEmpty(first) || boundsEmpty(second)) return false;
+
+    return first->minX <= second->maxX && second->minX <= first->maxX && first->minY <= second->maxY && second->minY <= first->maxY;
+}
+
+bool boundsContain(const Bounds* bounds, float x, float y){
+
+    return x >= bounds->minX && x <= bounds->maxX && y >= bounds->minY && y <= bounds->maxY;
+}
+
+// the box of the 4 corners of the box moved by the matrix, result may be bounds
+void transformBounds(const Bounds* bounds, const float matrix[6], Bounds* result){
+
+    if (boundsEmpty(bounds)){
+        emptyBounds(result);
+        return;
+    }
+
+    float corners[8] = {bounds->minX, bounds->minY, bounds->maxX, bounds->minY, bounds->maxX, bounds->maxY, bounds->minX, bounds->maxY};
+    transformPoints(matrix, corners, 4);
+
+    emptyBounds(result);
+    for (int i = 0; i < 4; ++i){
+        addBoundsPoint(result, corners[2 * i], corners[2 * i + 1]);
+    }
+}
+
+// {"x":1.00,"y":2.00,"w":3.00,"h":4.00} like rectToJSON, or null for an empty box
+void appendBoundsJSON(StringBuilder* builder, const Bounds* bounds){
+
+    if (boundsEmpty(bounds)){
+        appendString(builder, "null");
+        return;
+    }
+
+    appendFormat(builder, "{\"x\":%.2f,\"y\":%.2f,\"w\":%.2f,\"h\":%.2f}", bounds->minX, bounds->minY, bounds->maxX - bounds->minX, bounds->maxY - bounds->minY);
+}
+
+// the roots of a t^2 + b t + c in (0, 1), returns how many are in roots
+static int unitRoots(double a, double b, double c, double roots[2]){
+
+    int count = 0;
+
+    // 1. a line, or no root at all
+    if (fabs(a) < 1e-12){
+        if (fabs(b) < 1e-12) return 0;
+        double t = -c / b;
+        if (t > 0 && t < 1) roots[count++] = t;
+        return count;
+    }
+
+    // 2. the two roots of the quadratic
+    double discriminant = b * b - 4 * a * c;
+    if (discriminant < 0) return 0;
+
+    double root = sqrt(discriminant);
+    double first = (-b + root) / (2 * a);
+    double second = (-b - root) / (2 * a);
+    if (first > 0 && first < 1) roots[count++] = first;
+    if (second > 0 && second < 1 && discriminant > 0) roots[count++] = second;
+
+    return count;
+}
+
+// adds the end points of the curve and the points where it turns in x or y
+void addQuadraticBounds(Bounds* bounds, const float p0[2], const float p1[2], const float p2[2]){
+
+    addBoundsPoint(bounds, p0[0], p0[1]);
+    addBoundsPoint(bounds, p2[0], p2[1]);
+
+    for (int axis = 0; axis < 2; ++axis){
+        // the derivative 2 (1 - t) (p1 - p0) + 2 t (p2 - p1) is 0
+        double denominator = (double)p0[axis] - 2.0 * p1[axis] + p2[axis];
+        if (fabs(denominator) < 1e-12) continue;
+
+        double t = ((double)p0[axis] - p1[axis]) / denominator;
+        if (t <= 0 || t >= 1) continue;
+
+        double u = 1 - t;
+        addBoundsPoint(bounds, (float)(u * u * p0[0] + 2 * u * t * p1[0] + t * t * p2[0]), (float)(u * u * p0[1] + 2 * u * t * p1[1] + t * t * p2[1]));
+    }
+}
+
+void addCubicBounds(Bounds* bounds, const float p0[2], const float p1[2], const float p2[2], const float p3[2]){
+
+    addBoundsPoint(bounds, p0[0], p0[1]);
+    addBoundsPoint(bounds, p3[0], p3[1]);
+
+    for (int axis = 0; axis < 2; ++axis){
+        // the derivative over 3 is a t^2 + b t + c
+        double a = -(double)p0[axis] + 3.0 * p1[axis] - 3.0 * p2[axis] + p3[axis];
+        double b = 2.0 * ((double)p0[axis] - 2.0 * p1[axis] + p2[axis]);
+        double c = (double)p1[axis] - p0[axis];
+
+        double roots[2];
+        int count = unitRoots(a, b, c, roots);
+        for (int i = 0; i < count; ++i){
+            double t = roots[i];
+            double u = 1 - t;
+            double x = u * u * u * p0[0] + 3 * u * u * t * p1[0] + 3 * u * t * t * p2[0] + t * t * t * p3[0];
+            double y = u * u * u * p0[1] + 3 * u * u * t * p1[1] + 3 * u * t * t * p2[1] + t * t * t * p3[1];
+            addBoundsPoint(bounds, (float)x, (float)y);
+        }
+    }
+}
+
+// true if the angle is on the arc that starts at start and turns by sweep (both in radians)
+static bool angleOnArc(double angle, double start, double sweep){
+
+    double turned = (sweep >= 0) ? angle - start : start - angle;
+    turned = fmod(turned, 2 * SVG_PI);
+    if (turned < 0) turned += 2 * SVG_PI;
+
+    return turned <= fabs(sweep);
+}
+
+/*
+    adds an arc, from its end points to its centre and angles like the implementation notes of the svg
+    specification (radii that are too small are made big enough, a radius of 0 is a line), then the end points
+    and the angles where the ellipse turns in x or y that are on the arc
+*/
+void addArcBounds(Bounds* bounds, const float p0[2], float rx, float ry, float angle, bool largeArc, bool sweep, const float p1[2]){
+
+    addBoundsPoint(bounds, p0[0], p0[1]);
+    addBoundsPoint(bounds, p1[0], p1[1]);
+
+    double radiusX = fabs((double)rx);
+    double radiusY = fabs((double)ry);
+    if (radiusX == 0 || radiusY == 0 || (p0[0] == p1[0] && p0[1] == p1[1])) return;
+
+    // 1. the middle of the chord in the axes of the ellipse
+    double phi = angle * SVG_PI / 180.0;
+    double cosPhi = cos(phi);
+    double sinPhi = sin(phi);
+    double dx = ((double)p0[0] - p1[0]) / 2;
+    double dy = ((double)p0[1] - p1[1]) / 2;
+    double x1 = cosPhi * dx + sinPhi * dy;
+    double y1 = -sinPhi * dx + cosPhi * dy;
+
+    // 2. radii too small for the end points are scaled up
+    double lambda = (x1 * x1) / (radiusX * radiusX) + (y1 * y1) / (radiusY * radiusY);
+    if (lambda > 1){
+        radiusX *= sqrt(lambda);
+        radiusY *= sqrt(lambda);
+    }
+
+    // 3. the centre
+    double numerator = radiusX * radiusX * radiusY * radiusY - radiusX * radiusX * y1 * y1 - radiusY * radiusY * x1 * x1;
+    double denominator = radiusX * radiusX * y1 * y1 + radiusY * radiusY * x1 * x1;
+    double factor = (numerator <= 0 || denominator == 0) ? 0 : sqrt(numerator / denominator);
+    if (largeArc == sweep) factor = -factor;
+
+    double centreX1 = factor * radiusX * y1 / radiusY;
+    double centreY1 = -factor * radiusY * x1 / radiusX;
+    double centreX = cosPhi * centreX1 - sinPhi * centreY1 + ((double)p0[0] + p1[0]) / 2;
+    double centreY = sinPhi * centreX1 + cosPhi * centreY1 + ((double)p0[1] + p1[1]) / 2;
+
+    // 4. the start angle and how far the arc turns
+    double start = atan2((y1 - centreY1) / radiusY, (x1 - centreX1) / radiusX);
+    double end = atan2((-y1 - centreY1) / radiusY, (-x1 - centreX1) / radiusX);
+    double turn = end - start;
+    if (sweep && turn < 0) turn += 2 * SVG_PI;
+    if (sweep == false && turn > 0) turn -= 2 * SVG_PI;
+
+    // 5. x(t) = cx + rx cos(phi) cos(t) - ry sin(phi) sin(t), and y(t) = cy + rx sin(phi) cos(t) + ry cos(phi) sin(t)
+    double turningX = atan2(-radiusY * sinPhi, radiusX * cosPhi);
+    double turningY = atan2(radiusY * cosPhi, radiusX * sinPhi);
+    double candidates[4] = {turningX, turningX + SVG_PI, turningY, turningY + SVG_PI};
+
+    for (int i = 0; i < 4; ++i){
+        if (angleOnArc(candidates[i], start, turn) == false) continue;
+
+        double x = centreX + radiusX * cosPhi * cos(candidates[i]) - radiusY * sinPhi * sin(candidates[i]);
+        double y = centreY + radiusX * sinPhi * cos(candidates[i]) + radiusY * cosPhi * sin(candidates[i]);
+        addBoundsPoint(bounds, (float)x, (float)y);
+    }
+}
+
+/*
+    the box of every segment of the path data, the smooth curves reflect the last control point like a renderer
+    a lone move to adds its point, since a renderer may still draw a marker or a round cap there
+*/
+void pathDataBounds(const PathData* pathData, Bounds* bounds){
+
+    emptyBounds(bounds);
+    if (pathData == NULL) return;
+
+    float current[2] = {0, 0};
+    float start[2] = {0, 0};
+    float control[2] = {0, 0};
+    char last = 'M';
+    const float* args = pathData->coords;
+
+    for (int i = 0; i < pathData->numCommands; ++i){
+        char command = pathData->commands[i];
+        char upper = toupper((unsigned char)command);
+        bool relative = (command != upper);
+        float baseX = relative ? current[0] : 0;
+        float baseY = relative ? current[1] : 0;
+        float next[2] = {current[0], current[1]};
+
+        // 1. the control point of a smooth curve is the last one reflected, or the current point after another command
+        float reflected[2] = {current[0], current[1]};
+        if ((upper == 'S' && (last == 'C' || last == 'S')) || (upper == 'T' && (last == 'Q' || last == 'T'))){
+            reflected[0] = 2 * current[0] - control[0];
+            reflected[1] = 2 * current[1] - control[1];
+        }
+
+        // 2. the segment
+        if (upper == 'M'){
+            next[0] = baseX + args[0];
+            next[1] = baseY + args[1];
+            start[0] = next[0];
+            start[1] = next[1];
+            addBoundsPoint(bounds, next[0], next[1]);
+        }
+        else if (upper == 'L'){
+            next[0] = baseX + args[0];
+            next[1] = baseY + args[1];
+            addBoundsPoint(bounds, current[0], current[1]);
+            addBoundsPoint(bounds, next[0], next[1]);
+        }
+        else if (upper == 'H' || upper == 'V'){
+            next[(upper == 'H') ? 0 : 1] = ((upper == 'H') ? baseX : baseY) + args[0];
+            addBoundsPoint(bounds, current[0], current[1]);
+            addBoundsPoint(bounds, next[0], next[1]);
+        }
+        else if (upper == 'C'){
+            float first[2] = {baseX + args[0], baseY + args[1]};
+            control[0] = baseX + args[2];
+            control[1] = baseY + args[3];
+            next[0] = baseX + args[4];
+            next[1] = baseY + args[5];
+            addCubicBounds(bounds, current, first, control, next);
+        }
+        else if (upper == 'S'){
+            control[0] = baseX + args[0];
+            control[1] = baseY + args[1];
+            next[0] = baseX + args[2];
+            next[1] = baseY + args[3];
+            addCubicBounds(bounds, current, reflected, control, next);
+        }
+        else if (upper == 'Q'){
+            control[0] = baseX + args[0];
+            control[1] = baseY + args[1];
+            next[0] = baseX + args[2];
+            next[1] = baseY + args[3];
+            addQuadraticBounds(bounds, current, control, next);
+        }
+        else if (upper == 'T'){
+            control[0] = reflected[0];
+            control[1] = reflected[1];
+            next[0] = baseX + args[0];
+            next[1] = baseY + args[1];
+            addQuadraticBounds(bounds, current, control, next);
+        }
+        else if (upper == 'A'){
+            next[0] = baseX + args[5];
+            next[1] = baseY + args[6];
+            addArcBounds(bounds, current, args[0], args[1], args[2], args[3] != 0, args[4] != 0, next);
+        }
+        else if (upper == 'Z'){
+            next[0] = start[0];
+            next[1] = start[1];
+        }
+
+        current[0] = next[0];
+        current[1] = next[1];
+        last = upper;
+        args += numArgs(command);
+    }
+}
+
+// the parent matrix with the transform attribute of the element after it, or the parent if it has none
+void elementMatrix(List* attrList, const float parent[6], float result[6]){
+
+    float matrix[6];
+    const char* transform = transformAttribute(attrList);
+
+    if (transform != NULL && parseTransform(transform, matrix)){
+        multiplyMatrix(parent, matrix, result);
+    }
+    else{
+        memcpy(result, parent, sizeof(float) * 6);
+    }
+}
+
+// the box of a shape in its own numbers, before its transform attribute, groups are not shapes and are empty
+void shapeBounds(void* shape, elementType type, Bounds* bounds){
+
+    emptyBounds(bounds);
+    if (shape == NULL) return;
+
+    if (type == RECT){
+        Rectangle* rect = (Rectangle*)shape;
+        addBoundsPoint(bounds, rect->x, rect->y);
+        addBoundsPoint(bounds, rect->x + rect->width, rect->y + rect->height);
+    }
+    else if (type == CIRC){
+        Circle* circle = (Circle*)shape;
+        addBoundsPoint(bounds, circle->cx - circle->r, circle->cy - circle->r);
+        addBoundsPoint(bounds, circle->cx + circle->r, circle->cy + circle->r);
+    }
+    else if (type == ELLIPSE){
+        Ellipse* ellipse = (Ellipse*)shape;
+        addBoundsPoint(bounds, ellipse->cx - ellipse->rx, ellipse->cy - ellipse->ry);
+        addBoundsPoint(bounds, ellipse->cx + ellipse->rx, ellipse->cy + ellipse->ry);
+    }
+    else if (type == PATH){
+        pathDataBounds(getPathData((Path*)shape), bounds);
+    }
+    else if (type == LINE || type == POLYLINE || type == POLYGON){
+        int numPoints;
+        float* points = shapePoints(shape, type, &numPoints);
+        for (int i = 0; i < numPoints; ++i){
+            addBoundsPoint(bounds, points[2 * i], points[2 * i + 1]);
+        }
+    }
+}
+
+// the box of a shape with its transform attribute, in the numbers of the group or svg it is in
+void elementBounds(void* element, elementType type, Bounds* bounds){
+
+    shapeBounds(element, type, bounds);
+
+    const char* transform = transformAttribute(shapeOtherAttributes(element, type));
+    float matrix[6];
+    if (transform != NULL && parseTransform(transform, matrix)) transformBounds(bounds, matrix, bounds);
+}
+
+// adds the boxes of the shapes that are right in the group, or in the svg when the group is NULL
+static void addShapesBounds(const SVG* img, Group* group, Bounds* bounds){
+
+    for (elementType type = CIRC; type <= POLYGON; ++type){
+        if (type == GROUP) continue;
+
+        List* list = containerList(img, group, type);
+        if (list == NULL) continue;
+
+        void* elem;
+        ListIterator iter = createIterator(list);
+        while ((elem = nextElement(&iter)) != NULL){
+            Bounds shape;
+            elementBounds(elem, type, &shape);
+            unionBounds(bounds, &shape);
+        }
+    }
+}
+
+// the box found for the inside of a group, moved by its transform
+static void moveGroupBounds(const Group* group, const Bounds* inside, Bounds* bounds){
+
+    const char* transform = transformAttribute(group->otherAttributes);
+    float matrix[6];
+
+    if (transform != NULL && parseTransform(transform, matrix)) transformBounds(inside, matrix, bounds);
+    else *bounds = *inside;
+}
+
+/*
+    the box of the group in the numbers of the group or svg it is in, kept in the group and in its groups
+    version is the version of the svg the group is in, the box kept is used while it has not changed
+*/
+const Bounds* groupBounds(Group* group, unsigned version){
+
+    if (group == NULL) return NULL;
+    if (group->boundsVersion == version + 1) return &group->bounds;
+
+    // 1. the shapes of the group
+    Bounds inside;
+    emptyBounds(&inside);
+    addShapesBounds(NULL, group, &inside);
+
+    // 2. the groups, which keep their boxes too
+    if (group->groups != NULL){
+        void* elem;
+        ListIterator iter = createIterator(group->groups);
+        while ((elem = nextElement(&iter)) != NULL){
+            unionBounds(&inside, groupBounds((Group*)elem, version));
+        }
+    }
+
+    moveGroupBounds(group, &inside, &group->bounds);
+    group->boundsVersion = version + 1;
+    return &group->bounds;
+}
+
+// the box of the group found again, for when the svg it is in is not known, nothing is kept
+void findGroupBounds(const Group* group, Bounds* bounds){
+
+    emptyBounds(bounds);
+    if (group == NULL) return;
+
+    Bounds inside;
+    emptyBounds(&inside);
+    addShapesBounds(NULL, (Group*)group, &inside);
+
+    if (group->groups != NULL){
+        void* elem;
+        ListIterator iter = createIterator(group->groups);
+        while ((elem = nextElement(&iter)) != NULL){
+            Bounds child;
+            findGroupBounds((const Group*)elem, &child);
+            unionBounds(&inside, &child);
+        }
+    }
+
+    moveGroupBounds(group, &inside, bounds);
+}
+
+// the box of all the shapes of the svg, the boxes of all its groups are kept up to date with it
+const Bounds* svgBounds(SVG* img){
+
+    if (img == NULL) return NULL;
+    if (img->boundsVersion == img->version + 1) return &img->bounds;
+
+    emptyBounds(&img->bounds);
+    addShapesBounds(img, NULL, &img->bounds);
+
+    if (img->groups != NULL){
+        void* elem;
+        ListIterator iter = createIterator(img->groups);
+        while ((elem = nextElement(&iter)) != NULL){
+            unionBounds(&img->bounds, groupBounds((Group*)elem, img->version));
+        }
+    }
+
+    img->boundsVersion = img->version + 1;
+    return &img->bounds;
+}
+
+// the box of all the shapes of a const svg, the box kept by svgBounds while it is up to date or found again without keeping it
+void findSVGBounds(const SVG* img, Bounds* bounds){
+
+    emptyBounds(bounds);
+    if (img == NULL) return;
+
+    if (img->boundsVersion == img->version + 1){
+        *bounds = img->bounds;
+        return;
+    }
+
+    addShapesBounds(img, NULL, bounds);
+
+    if (img->groups != NULL){
+        void* elem;
+        ListIterator iter = createIterator(img->groups);
+        while ((elem = nextElement(&iter)) != NULL){
+            Bounds group;
+            findGroupBounds((const Group*)elem, &group);
+            unionBounds(bounds, &group);
+        }
+    }
+}
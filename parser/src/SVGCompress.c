@@ -0,0 +1,63 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include "SVGParser.h"
+#include "SVGCompress.h"
+
+// zlib level for the .svgz files written, 0 (none) to 9 (smallest), or Z_DEFAULT_COMPRESSION
+static int compressionLevel = Z_DEFAULT_COMPRESSION;
+
+void setCompressionLevel(int level){
+
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) return;
+
+    compressionLevel = level;
+}
+
+int getCompressionLevel(void){
+
+    return compressionLevel;
+}
+
+// files that end in .svgz are written compressed
+bool compressedFileName(const char* fileName){
+
+    if (fileName == NULL) return false;
+
+    size_t length = strlen(fileName);
+    return (length >= 5) && (strcasecmp(fileName + length - 5, ".svgz") == 0);
+}
+
+// input callbacks for xmlReadIO, the parser pulls the decompressed bytes from zlib as it needs them
+int gzIORead(void* context, char* buffer, int length){
+
+    return gzread((gzFile) context, buffer, length);
+}
+
+int gzIOClose(void* context){
+
+    return (gzclose((gzFile) context) == Z_OK) ? 0 : -1;
+}
+
+/*
+    parses an svg file, compressed or not, into an xml tree without decompressing the whole file first
+    returns NULL if the file cannot be opened or parsed, like xmlReadFile
+*/
+xmlDocPtr readSVGFile(const char* fileName){
+
+    if (fileName == NULL) return NULL;
+
+    gzFile file = gzopen(fileName, "rb");
+    if (file == NULL) return NULL;
+    gzbuffer(file, 65536);
+
+    // xmlReadIO closes the file with gzIOClose when it is done, even if the parse fails
+    return xmlReadIO(gzIORead, gzIOClose, file, fileName, NULL, 0);
+}
@@ -0,0 +1,184 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelper.h"
+#include "SVGHelperA2.h"
+#include "SVGShapes.h"
+#include "SVGElementPath.h"
+#include "SVGSpatial.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
+
+// the type of an element name in a path, SVG_IMG for "svg" and for any other name
+elementType pathElementType(const char* name, size_t length){
+
+    if (length == 1 && strncasecmp(name, "g", 1) == 0) return GROUP;
+    if (length == 4 && strncasecmp(name, "rect", 4) == 0) return RECT;
+    if (length == 6 && strncasecmp(name, "circle", 6) == 0) return CIRC;
+    if (length == 4 && strncasecmp(name, "path", 4) == 0) return PATH;
+
+    for (elementType type = LINE; type <= POLYGON; ++type){
+        const char* shapeName = shapeElementName(type);
+        if (length == strlen(shapeName) && strncasecmp(name, shapeName, length) == 0) return type;
+    }
+
+    return SVG_IMG;
+}
+
+// the name of the type in a path, the other way from pathElementType
+const char* pathElementName(elementType type){
+
+    if (type == GROUP) return "g";
+    if (type == RECT) return "rect";
+    if (type == CIRC) return "circle";
+    if (type == PATH) return "path";
+    if (type == SVG_IMG) return "svg";
+
+    return shapeElementName(type);
+}
+
+// the list of the type in the group, or in the svg when the group is NULL
+List* containerList(const SVG* img, Group* parent, elementType type){
+
+    if (parent == NULL) return svgComponentList(img, type);
+
+    if (type == RECT) return parent->rectangles;
+    if (type == CIRC) return parent->circles;
+    if (type == PATH) return parent->paths;
+    if (type == GROUP) return parent->groups;
+
+    List** list = groupShapeList(parent, type);
+    return (list == NULL) ? NULL : *list;
+}
+
+/*
+    finds the element of a path like "g0/g2/rect3"
+    @return false if the path is malformed, or a group or an element in it is not there
+*/
+bool resolveElementPath(SVG* img, const char* path, ElementPath* result){
+
+    if (img == NULL || path == NULL || result == NULL) return false;
+
+    result->parent = NULL;
+    result->type = SVG_IMG;
+    result->index = -1;
+    result->element = img;
+
+    // 1. the svg itself
+    while (*path == '/') ++path;
+    if (*path == '\0' || strcasecmp(path, "svg") == 0) return true;
+
+    while (*path != '\0'){
+        // 2. the groups before the last part
+        if (result->type != SVG_IMG){
+            if (result->type != GROUP) return false;
+            result->parent = (Group*) result->element;
+        }
+
+        // 3. the name and the index of the part
+        const char* name = path;
+        while (isalpha((unsigned char)*path)) ++path;
+        size_t length = path - name;
+        if (length == 0 || isdigit((unsigned char)*path) == 0) return false;
+
+        char* end;
+        long index = strtol(path, &end, 10);
+        if (*end != '\0' && *end != '/') return false;
+        path = (*end == '/') ? end + 1 : end;
+
+        // 4. the element, from the list of its type in the svg or the group
+        result->type = pathElementType(name, length);
+        List* list = containerList(img, result->parent, result->type);
+        if (result->type == SVG_IMG || list == NULL || index >= getLength(list)) return false;
+
+        result->index = (int)index;
+        result->element = getElementAt(list, result->index);
+        if (result->element == NULL) return false;
+    }
+
+    return true;
+}
+
+// the other attributes of the element at the path
+List* elementPathAttributes(SVG* img, const ElementPath* elementPath){
+
+    if (img == NULL || elementPath == NULL) return NULL;
+    if (elementPath->type == SVG_IMG) return img->otherAttributes;
+
+    return shapeOtherAttributes(elementPath->element, elementPath->type);
+}
+
+/*
+    setAttribute for the element at a path, which may be in a group at any depth
+    newAttribute is freed or kept by the element when the attribute is set, otherwise it is left to the caller
+*/
+bool setAttributeAtPath(SVG* img, const char* path, Attribute* newAttribute){
+
+    if (img == NULL || newAttribute == NULL) return false;
+
+    ElementPath elementPath;
+    if (resolveElementPath(img, path, &elementPath) == false) return false;
+
+    // 1. the svg and the elements of the svg are set the same way as before
+    if (elementPath.parent == NULL) return setAttribute(img, elementPath.type, elementPath.index, newAttribute);
+
+    // 2. valid attribute strings
+    if ((validChar(newAttribute->name) == 0) || (strcmp(newAttribute->name, "") == 0) || (validChar(newAttribute->value) == 0) || (strcmp(newAttribute->value, "") == 0)) return false;
+
+    // 3. the element is changed in the list of its group, and moved to its new area in the area histogram
+    //    or to its new data in the path counts
+    AreaChange areaChange;
+    PathChange pathChange;
+    beginAreaChange(img, elementPath.type, elementPath.element, &areaChange);
+    beginPathChange(img, elementPath.type, elementPath.element, &pathChange);
+    if (geometryAttribute(newAttribute->name)) touchSVG(img);
+
+    bool valid;
+    List* list = containerList(img, elementPath.parent, elementPath.type);
+    if (elementPath.type == RECT) valid = changeValueInRect(list, elementPath.index, newAttribute);
+    else if (elementPath.type == CIRC) valid = changeValueInCirc(list, elementPath.index, newAttribute);
+    else if (elementPath.type == PATH) valid = changeValueInPath(list, elementPath.index, newAttribute);
+    else if (elementPath.type == GROUP) valid = changeValueInGroup(list, elementPath.index, newAttribute);
+    else valid = changeValueInShape(list, elementPath.type, elementPath.index, newAttribute);
+
+    endAreaChange(&areaChange);
+    endPathChange(&pathChange);
+    return valid;
+}
+
+/*
+    addComponent for the svg or the group at a path, which may be in a group at any depth
+    newElement belongs to the svg when it was added, otherwise it is left to the caller
+*/
+bool addComponentAtPath(SVG* img, const char* path, elementType type, void* newElement){
+
+    if (img == NULL || newElement == NULL || type == SVG_IMG || type == GROUP) return false;
+
+    ElementPath elementPath;
+    if (resolveElementPath(img, path, &elementPath) == false) return false;
+
+    // 1. added to the svg, addComponent does not say when the element was not valid so the list is checked
+    if (elementPath.type == SVG_IMG){
+        List* list = svgComponentList(img, type);
+        int length = (list == NULL) ? 0 : getLength(list);
+
+        addComponent(img, type, newElement);
+
+        list = svgComponentList(img, type);
+        return list != NULL && getLength(list) > length;
+    }
+
+    // 2. only a group holds other elements
+    if (elementPath.type != GROUP) return false;
+    if (addShapeToGroup((Group*) elementPath.element, type, newElement) == false) return false;
+
+    shapeAdded(img, (Group*) elementPath.element, type, newElement);
+    return true;
+}
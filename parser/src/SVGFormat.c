@@ -0,0 +1,216 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGFormat.h"
+
+// options used by writeSVG and validateAndWriteSVG, the same layout as xmlSaveFormatFileEnc until they are set
+static SVGWriteOptions defaultOptions = { true, 6, false };
+
+/*
+    initial values of the svg 1.1 presentation attributes that are worth leaving out,
+    number values are compared as numbers so "1", "1.0" and "1.000000" are all the default
+*/
+typedef struct {
+    const char* name;
+    const char* value;
+    bool number;
+    bool inherited;
+} DefaultAttribute;
+
+static const DefaultAttribute defaultAttributes[] = {
+    { "opacity", "1", true, false },
+    { "display", "inline", false, false },
+    { "fill-opacity", "1", true, true },
+    { "fill-rule", "nonzero", false, true },
+    { "stroke", "none", false, true },
+    { "stroke-opacity", "1", true, true },
+    { "stroke-width", "1", true, true },
+    { "stroke-linecap", "butt", false, true },
+    { "stroke-linejoin", "miter", false, true },
+    { "stroke-miterlimit", "4", true, true },
+    { "stroke-dasharray", "none", false, true },
+    { "stroke-dashoffset", "0", true, true },
+    { "clip-rule", "nonzero", false, true },
+    { "visibility", "visible", false, true },
+};
+
+#define NUM_DEFAULT_ATTRIBUTES ((int)(sizeof(defaultAttributes) / sizeof(defaultAttributes[0])))
+
+void setDefaultWriteOptions(bool indent, int precision, bool dropDefaults){
+
+    SVGWriteOptions options = { indent, precision, dropDefaults };
+    if (validWriteOptions(options) == false) return;
+
+    defaultOptions = options;
+}
+
+SVGWriteOptions getWriteOptions(void){
+
+    return defaultOptions;
+}
+
+bool validWriteOptions(SVGWriteOptions options){
+
+    return options.precision >= SVG_PRECISION_SHORTEST && options.precision <= SVG_PRECISION_MAX;
+}
+
+/*
+    writes the number with a fixed number of digits after the point like %f,
+    or for SVG_PRECISION_SHORTEST with the fewest digits that strtof reads back as the same float
+*/
+void formatNumber(char* buffer, size_t size, float number, int precision){
+
+    if (precision >= 0 || isfinite(number) == 0){
+        snprintf(buffer, size, "%.*f", (precision >= 0) ? precision : 0, number);
+        return;
+    }
+
+    // a float needs at most 45 digits after the point, for the smallest denormals
+    for (int digits = 0; digits <= 45; ++digits){
+        snprintf(buffer, size, "%.*f", digits, number);
+        if (strtof(buffer, NULL) == number) break;
+    }
+
+    if (strcmp(buffer, "-0") == 0) strcpy(buffer, "0");
+}
+
+// returns the index of the attribute in defaultAttributes, or -1 if it has no default to drop
+int defaultAttributeIndex(const char* name){
+
+    if (name == NULL) return -1;
+
+    for (int i = 0; i < NUM_DEFAULT_ATTRIBUTES; ++i){
+        if (strcmp(defaultAttributes[i].name, name) == 0) return i;
+    }
+
+    return -1;
+}
+
+// true if the whole value (spaces around it are allowed) is a number equal to number
+bool sameNumber(const char* value, const char* number){
+
+    char* end = NULL;
+    double parsed = strtod(value, &end);
+    if (end == value) return false;
+
+    while (isspace((unsigned char)*end)) ++end;
+    if (*end != '\0') return false;
+
+    return parsed == strtod(number, NULL);
+}
+
+// true for a length of zero in any units, like "0", "0.000000" or "0px"
+bool zeroLength(const char* value){
+
+    char* end = NULL;
+    double parsed = strtod(value, &end);
+    if (end == value || parsed != 0) return false;
+
+    while (isalpha((unsigned char)*end) || *end == '%') ++end;
+
+    return *end == '\0';
+}
+
+bool isDefaultAttribute(const char* name, const char* value, unsigned inheritedSet){
+
+    int index = defaultAttributeIndex(name);
+    if (index < 0 || value == NULL) return false;
+
+    const DefaultAttribute* attr = &(defaultAttributes[index]);
+
+    // 1. an ancestor changed the value this element would inherit, so the default is not the default here
+    if (attr->inherited && (inheritedSet & (1u << index)) != 0) return false;
+
+    // 2. compare the values
+    if (attr->number) return sameNumber(value, attr->value);
+    return strcasecmp(value, attr->value) == 0;
+}
+
+/*
+    adds the inherited attributes in the list to the set of attributes the ancestors of the children set,
+    a style or class can set any of them
+*/
+unsigned inheritedAttributeSet(List* attributes, unsigned inheritedSet){
+
+    if (attributes == NULL) return inheritedSet;
+
+    void* elem;
+    ListIterator iter = createIterator(attributes);
+    while ((elem = nextElement(&iter)) != NULL){
+        Attribute* attr = (Attribute*) elem;
+
+        if (strcmp(attr->name, "style") == 0 || strcmp(attr->name, "class") == 0) return ~0u;
+
+        int index = defaultAttributeIndex(attr->name);
+        if (index >= 0) inheritedSet |= (1u << index);
+    }
+
+    return inheritedSet;
+}
+
+// true if the raw xml has a style or use element in it at any depth, with or without a prefix
+bool styleOrUseElement(const char* xml){
+
+    for (const char* c = strchr(xml, '<'); c != NULL; c = strchr(c + 1, '<')){
+
+        const char* name = c + 1;
+        size_t length = strcspn(name, " \t\r\n/>:");
+        if (name[length] == ':'){
+            name += length + 1;
+            length = strcspn(name, " \t\r\n/>");
+        }
+
+        if (length == 5 && strncmp(name, "style", 5) == 0) return true;
+        if (length == 3 && strncmp(name, "use", 3) == 0) return true;
+    }
+
+    return false;
+}
+
+static bool styleOrUseInList(List* elementList){
+
+    if (elementList == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(elementList);
+    while ((elem = nextElement(&iter)) != NULL){
+        if (styleOrUseElement(((RawElement*) elem)->xml)) return true;
+    }
+
+    return false;
+}
+
+static bool styleOrUseInGroups(List* groupList){
+
+    if (groupList == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(groupList);
+    while ((elem = nextElement(&iter)) != NULL){
+        Group* group = (Group*) elem;
+        if (styleOrUseInList(group->otherElements) || styleOrUseInGroups(group->groups)) return true;
+    }
+
+    return false;
+}
+
+/*
+    the set the svg element starts with: a style element can set an inherited attribute on any element,
+    and a use element makes the element it copies inherit from the use, so with either of them in the
+    document no inherited attribute is dropped, like under an ancestor with a style or class
+*/
+unsigned documentInheritedSet(const SVG* img){
+
+    if (img == NULL) return 0;
+    if (styleOrUseInList(img->otherElements) || styleOrUseInGroups(img->groups)) return ~0u;
+
+    return 0;
+}
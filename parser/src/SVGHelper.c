@@ -12,6 +12,9 @@
 #include "SVGHelper.h"
 #include "SVGHelperA2.h"
 #include "SVGParser.h"
+#include "SVGPathData.h"
+#include "SVGPathStore.h"
+#include "SVGShapes.h"
 
 #define DELIMITERS "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ !@#$%^&*()_~`{}|[]:\";',/<>?"
 #define NUMDELIMITERS "0123456789.-"
@@ -34,46 +37,73 @@ int getElementNames(xmlNode* a_node, SVG* svg){
     }
 
     xmlNode *cur_node = NULL;
+    // where the next raw element or shape is read, see ElementPlace
+    ElementPlace place = { SVG_IMG, 0, 0 };
 
     for (cur_node = a_node; cur_node != NULL; cur_node = cur_node->next) {
 
+        // comments are kept with the unknown elements, the text between elements is only indent
+        bool inSVG = (cur_node->parent != NULL && cur_node->parent->type == XML_ELEMENT_NODE);
+        if (cur_node->type == XML_COMMENT_NODE && inSVG){
+            addRawElement(cur_node, svg->otherElements, &place);
+            continue;
+        }
+        if (cur_node->type != XML_ELEMENT_NODE) continue;
+
         char* name = (char*)(cur_node->name);
 
         if (strcasecmp(name, "title") == 0){
             int valid = titleDescNS(svg->title, (char*)cur_node->children->content);
             if (valid == 0) strcpy(svg->title, "");
+            if (place.afterType == SVG_IMG) place.afterIndex = (strlen(svg->title) != 0) + (strlen(svg->description) != 0);
         }
-        if (strcasecmp(name, "desc") == 0){
+        else if (strcasecmp(name, "desc") == 0){
             int valid = titleDescNS(svg->description, (char*)cur_node->children->content);
             if (valid == 0) strcpy(svg->description, "");
+            if (place.afterType == SVG_IMG) place.afterIndex = (strlen(svg->title) != 0) + (strlen(svg->description) != 0);
         }
-
         // The primitives:
-        if (strcasecmp(name, "rect") == 0){ // create new rectangle
+        else if (strcasecmp(name, "rect") == 0){ // create new rectangle
             Rectangle* rect = rectAttributes(cur_node); // fill in with attributes
             insertBack(svg->rectangles, (void*)rect); // insert into the rectangle list
+            rawElementAnchor(svg->rectangles, RECT, &place);
         }
         else if (strcasecmp(name, "circle") == 0){ // create new circle
             Circle* circ = circAttributes(cur_node); // fill in with attributes
             insertBack(svg->circles, (void*)circ); // insert into the circle list
+            rawElementAnchor(svg->circles, CIRC, &place);
         }
         else if (strcasecmp(name, "path") == 0){ // create new path
             Path* path = pathAttributes(cur_node); // fill in with attributes
             insertBack(svg->paths, (void*)path); // insert into the path list
+            rawElementAnchor(svg->paths, PATH, &place);
+        }
+        else if (strcasecmp(name, "line") == 0){ // the lists of the other primitives are created if they are NULL
+            addShapeNode(cur_node, &(svg->lines), LINE, &place);
+        }
+        else if (strcasecmp(name, "ellipse") == 0){
+            addShapeNode(cur_node, &(svg->ellipses), ELLIPSE, &place);
+        }
+        else if (strcasecmp(name, "polyline") == 0){
+            addShapeNode(cur_node, &(svg->polylines), POLYLINE, &place);
+        }
+        else if (strcasecmp(name, "polygon") == 0){
+            addShapeNode(cur_node, &(svg->polygons), POLYGON, &place);
         }
         else if (strcasecmp(name, "g") == 0){ // create new group
             Group *newGroup = groupAttributes(cur_node); // fill in with attributes (not other primitives)
             getElementNamesGroups(cur_node->children, newGroup);
             insertBack(svg->groups, (void*)newGroup);
+            rawElementAnchor(svg->groups, GROUP, &place);
         }
-        else{ // just call attr with no argument and place in otherAttributes list
+        else if (inSVG == false){ // the svg element, its attributes go in the otherAttributes list
+            namespaceAttributes(cur_node, svg->otherAttributes); // xmlns:xlink and the like, before the attributes
             firstOtherAttributes(cur_node, svg->otherAttributes); // fill in with attributes
-        }
-
-        // if its a group dont go to the children since we already traversed the children in the children in the getElementNamesGroups function
-        if (strcasecmp(name, "g") != 0){
             getElementNames(cur_node->children, svg);
         }
+        else{ // any other element is kept as it is, with everything inside it
+            addRawElement(cur_node, svg->otherElements, &place);
+        }
 
     }
 
@@ -95,35 +125,97 @@ void getElementNamesGroups(xmlNode* a_node, Group* group){
     }
 
     xmlNode *cur_node = NULL;
+    // where the next raw element or shape is read, a group has no title or desc so it is 0 for SVG_IMG
+    ElementPlace place = { SVG_IMG, 0, 0 };
 
     for (cur_node = a_node; cur_node != NULL; cur_node = cur_node->next) {
 
+        if (cur_node->type == XML_COMMENT_NODE){
+            addRawElement(cur_node, group->otherElements, &place);
+            continue;
+        }
+        if (cur_node->type != XML_ELEMENT_NODE) continue;
+
         char* name = (char*)(cur_node->name);
 
         if (strcasecmp(name, "rect") == 0){ // create new rectangle
             Rectangle* rect = rectAttributes(cur_node); // fill in with attributes
             insertBack(group->rectangles, (void*)rect);
+            rawElementAnchor(group->rectangles, RECT, &place);
         }
         else if (strcasecmp(name, "circle") == 0){ // create new circle
             Circle* circ = circAttributes(cur_node); // fill in with attributes
             insertBack(group->circles, (void*)circ);
+            rawElementAnchor(group->circles, CIRC, &place);
         }
         else if (strcasecmp(name, "path") == 0){ // create new path
             Path* path = pathAttributes(cur_node); // fill in with attributes
             insertBack(group->paths, (void*)path);
+            rawElementAnchor(group->paths, PATH, &place);
+        }
+        else if (strcasecmp(name, "line") == 0){
+            addShapeNode(cur_node, &(group->lines), LINE, &place);
+        }
+        else if (strcasecmp(name, "ellipse") == 0){
+            addShapeNode(cur_node, &(group->ellipses), ELLIPSE, &place);
+        }
+        else if (strcasecmp(name, "polyline") == 0){
+            addShapeNode(cur_node, &(group->polylines), POLYLINE, &place);
+        }
+        else if (strcasecmp(name, "polygon") == 0){
+            addShapeNode(cur_node, &(group->polygons), POLYGON, &place);
         }
         else if (strcasecmp(name, "g") == 0){ // create new group
             Group *newGroup = groupAttributes(cur_node); // fill in with attributes
             getElementNamesGroups(cur_node->children, newGroup);
             insertBack(group->groups, (void*)newGroup);
+            rawElementAnchor(group->groups, GROUP, &place);
         }
-        else{
-            firstOtherAttributes(cur_node, group->otherAttributes);
+        else{ // kept as it is, with everything inside it
+            addRawElement(cur_node, group->otherElements, &place);
         }
     }
 }
 
 
+/*
+    the bytes to allocate for a value of the length and its null, rounded up to SVG_VALUE_ROUNDING,
+    so most edits to a value (a color, a number with one more digit) fit in place
+*/
+size_t valueCapacity(size_t length){
+
+    return (length + SVG_VALUE_ROUNDING) & ~(size_t)(SVG_VALUE_ROUNDING - 1);
+}
+
+// the capacity for a value that no longer fits, it grows by half at least so a value that keeps growing is rarely moved
+size_t growCapacity(size_t capacity, size_t length){
+
+    size_t grown = capacity + capacity / 2;
+    return valueCapacity((length + 1 > grown) ? length : grown);
+}
+
+/*
+    replaces the value of the attribute, in place when it fits, otherwise the attribute is reallocated, so the caller
+    must replace the attribute pointer wherever it is kept (like in the node of its list) with the attribute returned
+    @return NULL, with the attribute not changed, if it cannot be reallocated
+*/
+Attribute* setAttributeValue(Attribute* attr, const char* value){
+
+    if (attr == NULL || value == NULL) return NULL;
+
+    size_t length = strlen(value);
+    if (length + 1 > attr->capacity){
+        size_t capacity = growCapacity(attr->capacity, length);
+        Attribute* newAttr = realloc(attr, sizeof(Attribute) + capacity);
+        if (newAttr == NULL) return NULL;
+        attr = newAttr;
+        attr->capacity = capacity;
+    }
+
+    memcpy(attr->value, value, length + 1);
+    return attr;
+}
+
 /**
  * This function will return an attribute struct when given a node and its attributes
  * caller must free the node
@@ -132,10 +224,12 @@ Attribute* otherAttributes (char *name, char *content){
 
     if (name == NULL || content == NULL) return NULL;
 
-    Attribute* anAtr = malloc(sizeof(Attribute) + strlen(content) + 1); // 1 for null
+    size_t capacity = valueCapacity(strlen(content)); // 1 for null, and room for a slightly longer value
+    Attribute* anAtr = malloc(sizeof(Attribute) + capacity);
     if (anAtr == NULL){
         return NULL;
     }
+    anAtr->capacity = capacity;
     anAtr->name = malloc(strlen(name) + 1); // 1 for null
     if (anAtr->name == NULL){
         free(anAtr);
@@ -148,6 +242,101 @@ Attribute* otherAttributes (char *name, char *content){
 
 }
 
+// true if the node itself declares the prefix
+static bool declaredOn(xmlNode *node, const xmlChar* prefix){
+
+    for (xmlNsPtr ns = (node != NULL) ? node->nsDef : NULL; ns != NULL; ns = ns->next){
+        if (ns->prefix != NULL && xmlStrEqual(ns->prefix, prefix)) return true;
+    }
+    return false;
+}
+
+/**
+ * This function will return the xml of a node the parser does not model, with everything inside it
+ * namespaces declared above the node are declared again on it, except for the default svg namespace
+ * the file is written with and the ones declared on the svg, which are written back on it (namespaceAttributes),
+ * so the xml means the same thing when it is written back inside the svg
+ * caller must free the element
+ */
+RawElement* rawElement(xmlNode *cur_node){
+
+    if (cur_node == NULL || cur_node->doc == NULL) return NULL;
+
+    // 1. copy the node on its own, libxml2 declares the namespaces it uses from outside of it on the copy
+    xmlNodePtr copy = xmlDocCopyNode(cur_node, cur_node->doc, 1);
+    if (copy == NULL) return NULL;
+
+    xmlNodePtr root = xmlDocGetRootElement(cur_node->doc);
+    const xmlChar* svgNS = (root != NULL && root->ns != NULL) ? root->ns->href : NULL;
+    xmlNsPtr removed = NULL;
+    xmlNsPtr* link = &(copy->nsDef);
+    while (*link != NULL){
+        bool onSVG = ((*link)->prefix == NULL && svgNS != NULL && xmlStrEqual((*link)->href, svgNS));
+        if (onSVG == false && (*link)->prefix != NULL && declaredOn(cur_node, (*link)->prefix) == false){
+            // the prefix means the same here as on the svg when the svg is where it is declared
+            xmlNsPtr inScope = xmlSearchNs(cur_node->doc, cur_node->parent, (*link)->prefix);
+            onSVG = (inScope != NULL && declaredOn(root, (*link)->prefix) && xmlSearchNs(cur_node->doc, root, (*link)->prefix) == inScope);
+        }
+        if (onSVG == false){
+            link = &((*link)->next);
+            continue;
+        }
+
+        xmlNsPtr ns = *link; // the nodes of the copy still point to it until the copy is freed
+        *link = ns->next;
+        ns->next = removed;
+        removed = ns;
+    }
+
+    // 2. write the copy as utf-8 without adding any indent, the output buffer is flushed into xmlBuf when it is closed
+    RawElement* raw = NULL;
+    xmlBufferPtr xmlBuf = xmlBufferCreate();
+    xmlOutputBufferPtr out = (xmlBuf != NULL) ? xmlOutputBufferCreateBuffer(xmlBuf, xmlFindCharEncodingHandler("UTF-8")) : NULL;
+    if (out != NULL){
+        xmlNodeDumpOutput(out, cur_node->doc, copy, 0, 0, "UTF-8");
+        if (xmlOutputBufferClose(out) >= 0){
+            size_t length = xmlBufferLength(xmlBuf);
+            raw = (length > 0) ? malloc(sizeof(RawElement) + length + 1) : NULL; // 1 for null
+            if (raw != NULL){
+                raw->length = length;
+                memcpy(raw->xml, xmlBufferContent(xmlBuf), length);
+                raw->xml[length] = '\0';
+            }
+        }
+    }
+    if (xmlBuf != NULL) xmlBufferFree(xmlBuf);
+
+    xmlFreeNode(copy);
+    if (removed != NULL) xmlFreeNsList(removed);
+
+    return raw;
+
+}
+
+// the raw element is read at the place, which then counts it for the next one, see ElementPlace
+void addRawElement(xmlNode *cur_node, List* otherElementsList, ElementPlace* place){
+
+    if (cur_node == NULL || otherElementsList == NULL || place == NULL) return;
+
+    RawElement* raw = rawElement(cur_node);
+    if (raw == NULL) return;
+
+    raw->place = *place;
+    ++place->position;
+    insertBack(otherElementsList, (void*)raw);
+
+}
+
+// the raw elements and shapes read next come after the last element of the list, if one was added to it
+void rawElementAnchor(List* list, elementType type, ElementPlace* place){
+
+    if (list == NULL || getLength(list) == 0) return;
+
+    place->afterType = type;
+    place->afterIndex = getLength(list) - 1;
+
+}
+
 /**
  * This function will add to the list of other attribute structures when given a node that doesnt belong to one of the geometric primitives
  */
@@ -167,6 +356,28 @@ void firstOtherAttributes(xmlNode *cur_node, List* otherAttributesList){ // givi
 
 }
 
+/**
+ * This function will add the namespaces declared with a prefix on a node to its list of other attributes,
+ * as "xmlns:prefix" attributes, so they are written back on the node and not on the raw elements that use them
+ * the default namespace has its own field in the svg
+ */
+void namespaceAttributes(xmlNode *cur_node, List* otherAttributesList){
+
+    if (cur_node == NULL || otherAttributesList == NULL) return;
+
+    for (xmlNsPtr ns = cur_node->nsDef; ns != NULL; ns = ns->next){
+        if (ns->prefix == NULL || ns->href == NULL) continue;
+
+        char* name = malloc(strlen(SVG_XMLNS_PREFIX) + strlen((const char*)ns->prefix) + 1); // 1 for null
+        if (name == NULL) continue;
+        strcpy(name, SVG_XMLNS_PREFIX);
+        strcat(name, (const char*)ns->prefix);
+        insertBack(otherAttributesList, (void*)otherAttributes(name, (char*)ns->href));
+        free(name);
+    }
+
+}
+
 /**
  * This function will return a rectangle struct with its attributes when given a node
  * caller must free the node
@@ -283,17 +494,22 @@ Path* pathAttributes (xmlNode *cur_node){
     }
 
     path->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes); // must initialize list, cannot be NULL but can be empty
+    path->parsed = NULL; // the data is read into commands the first time it is needed
+    path->data = storePathData(""); // empty data when there is no d, shared with the store
+    if (path->data == NULL){
+        deletePath(path);
+        return NULL;
+    }
 
     for (attr = cur_node->properties; attr != NULL; attr = attr->next) {
         xmlNode *value = attr->children;
         char *attrName = (char *)attr->name;
         char *cont = (char *)(value->content);
         if (strcasecmp(attrName, "d") == 0){ // path data
-            path = realloc(path, sizeof(Path) + strlen(cont) + 1); // for the data
-            if (path == NULL){
+            if (setPathData(path, cont) == false){ // the data of the store, shared with the paths with the same data
+                deletePath(path);
                 return NULL;
             }
-            strcpy(path->data, cont);
         }
         else{
             insertBack(path->otherAttributes, (void*)otherAttributes (attrName, cont)); // create a node and insert into the other attribute list
@@ -320,6 +536,12 @@ Group* groupAttributes (xmlNode *cur_node){
     group->paths = initializeList(&pathToString, &deletePath, &comparePaths);
     group->groups = initializeList(&groupToString, &deleteGroup, &compareGroups);
     group->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    group->otherElements = initializeList(&rawElementToString, &deleteRawElement, &compareRawElements);
+    group->lines = initShapeList(LINE);
+    group->ellipses = initShapeList(ELLIPSE);
+    group->polylines = initShapeList(POLYLINE);
+    group->polygons = initShapeList(POLYGON);
+    group->boundsVersion = 0;
 
     for (attr = cur_node->properties; attr != NULL; attr = attr->next) {
         xmlNode *value = attr->children;
@@ -342,7 +564,7 @@ int numberWithUnits(float* number, char* units, char* value){
 
     if (value == NULL) return 0;
 
-    char* cpy = malloc (sizeof(value));
+    char* cpy = malloc (strlen(value) + 1);
     if (cpy == NULL){
         return 0;
     }
@@ -358,7 +580,10 @@ int numberWithUnits(float* number, char* units, char* value){
     *number = atof (token); // if the number happens to be just '.', then the atof function will return 0.0
 
     token = strtok(cpy, NUMDELIMITERS);
-    if (token != NULL) strcpy(units, token); // token not being null means there is a character specified after a number
+    if (token != NULL){ // token not being null means there is a character specified after a number
+        strncpy(units, token, 49); // units are at most 49 characters, like in the structs
+        units[49] = '\0';
+    }
 
     if (checkInvalid(*number) == false){
         free(cpy);
@@ -373,7 +598,7 @@ int numberWithUnits(float* number, char* units, char* value){
  * This function returns whether a string is not empty or not
  * @return 0 when it is empty
  */
-int validChar(char* word){ // checks if a character is valid
+int validChar(const char* word){ // checks if a character is valid
 
     if (word == NULL || word[0] == '\0' || word[0] == '\n') return 0; // 0 indicates false, not valid
     return 1;
@@ -505,11 +730,22 @@ int findNumShape(List * list, bool (*customCompare)(const void* first, const voi
 
 }
 
+// the areas numRectsWithArea and numCirclesWithArea compare, rounded up, the area histogram is keyed by them too
+int rectAreaKey(const Rectangle* rect){
+
+    return ceil(rect->width * rect->height);
+}
+
+int circleAreaKey(const Circle* circ){
+
+    return ceil(pow(circ->r, 2) * M_PI);
+}
+
 bool compareRectAreas(const void* data, const void* area){
 
     if (data == NULL || area == NULL) return 0;
     Rectangle* rect = (Rectangle*) data;
-    int shapeArea = ceil(rect->width * rect->height);
+    int shapeArea = rectAreaKey(rect);
     return (shapeArea == *(int*)area);
 
 }
@@ -518,7 +754,7 @@ bool compareCircAreas(const void* data, const void* area){
 
     if (data == NULL || area == NULL) return 0;
     Circle* circ = (Circle*) data;
-    int shapeArea = ceil(pow(circ->r, 2) * M_PI);
+    int shapeArea = circleAreaKey(circ);
     return (shapeArea == *(int*)area);
 
 }
@@ -535,11 +771,7 @@ bool compareGroupLen(const void* data, const void* length){
 
     if (data == NULL || length == NULL) return 0;
     Group* group = (Group*) data;
-    int count = 0;
-    count += getLength(group->rectangles);
-    count += getLength(group->circles);
-    count += getLength(group->paths);
-    count += getLength(group->groups);
+    int count = numGroupChildren(group);
 
     return (count == *(int*)length);
 
@@ -610,6 +842,7 @@ int getGroupAttrLen(List* list){
         count += getRectAttrLen(group->rectangles);
         count += getCircAttrLen(group->circles);
         count += getPathAttrLen(group->paths);
+        count += getShapesAttrLen(group->lines, group->ellipses, group->polylines, group->polygons);
         count += getGroupAttrLen(group->groups);
     }
 
@@ -651,3 +884,132 @@ int compareInGroups(List *group, bool (*customCompare)(const void* first, const
     return count;
 
 }
+
+// String representation helper functions:
+
+/**
+ * The append...String functions write the same text as the ...ToString functions, but append it
+ * to one builder so that the whole svg is written in a single traversal with no copies of the subtrees.
+ * The list functions match toString in LinkedListAPI.c: every element is preceded by a newline.
+ */
+void appendSVGString(StringBuilder* builder, const SVG* img){
+
+    if (builder == NULL || img == NULL) return;
+
+    appendFormat(builder, "N: %s\nT: %s\nD: %s\nR: ", img->namespace, img->title, img->description);
+    appendRectListString(builder, img->rectangles);
+    appendString(builder, "\nC: ");
+    appendCircListString(builder, img->circles);
+    appendString(builder, "\nP: ");
+    appendPathListString(builder, img->paths);
+    appendString(builder, "\nG: ");
+    appendGroupListString(builder, img->groups);
+    appendShapeListString(builder, img->lines, LINE, "\nL: ", "");
+    appendShapeListString(builder, img->ellipses, ELLIPSE, "\nE: ", "");
+    appendShapeListString(builder, img->polylines, POLYLINE, "\nPL: ", "");
+    appendShapeListString(builder, img->polygons, POLYGON, "\nPG: ", "");
+    appendString(builder, "\nA: ");
+    appendAttrListString(builder, img->otherAttributes);
+    appendString(builder, "\n");
+}
+
+void appendAttributeString(StringBuilder* builder, const Attribute* attr){
+
+    appendString(builder, attr->name);
+    appendString(builder, " = \"");
+    appendString(builder, attr->value);
+    appendString(builder, "\"\n");
+}
+
+void appendGroupString(StringBuilder* builder, const Group* group){
+
+    appendString(builder, "Rectangles:\n(");
+    appendRectListString(builder, group->rectangles);
+    appendString(builder, ")\nCircles:\n(");
+    appendCircListString(builder, group->circles);
+    appendString(builder, ")\nPaths:\n(");
+    appendPathListString(builder, group->paths);
+    appendString(builder, ")\nSubgroups:\n(");
+    appendGroupListString(builder, group->groups);
+    appendString(builder, ")");
+    appendShapeListString(builder, group->lines, LINE, "\nLines:\n(", ")");
+    appendShapeListString(builder, group->ellipses, ELLIPSE, "\nEllipses:\n(", ")");
+    appendShapeListString(builder, group->polylines, POLYLINE, "\nPolylines:\n(", ")");
+    appendShapeListString(builder, group->polygons, POLYGON, "\nPolygons:\n(", ")");
+    appendString(builder, "\nOtherAttributes:\n(");
+    appendAttrListString(builder, group->otherAttributes);
+    appendString(builder, ")\n");
+}
+
+void appendRectangleString(StringBuilder* builder, const Rectangle* rect){
+
+    appendFormat(builder, "x = \"%f\"\ny = \"%f\"\nwidth = \"%f\"\nheight = \"%f\"\nunits = \"%s\"\n", rect->x, rect->y, rect->width, rect->height, rect->units);
+    appendAttrListString(builder, rect->otherAttributes);
+    appendString(builder, "\n");
+}
+
+void appendCircleString(StringBuilder* builder, const Circle* circ){
+
+    appendFormat(builder, "cx = \"%f\"\ncy = \"%f\"\nr = \"%f\"\nunits = \"%s\"\n", circ->cx, circ->cy, circ->r, circ->units);
+    appendAttrListString(builder, circ->otherAttributes);
+    appendString(builder, "\n");
+}
+
+void appendPathString(StringBuilder* builder, const Path* path){
+
+    appendString(builder, "d = \"");
+    appendString(builder, path->data);
+    appendString(builder, "\"\n");
+    appendAttrListString(builder, path->otherAttributes);
+    appendString(builder, "\n");
+}
+
+void appendAttrListString(StringBuilder* builder, List* list){
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        appendString(builder, "\n");
+        appendAttributeString(builder, (Attribute*)elem);
+    }
+}
+
+void appendRectListString(StringBuilder* builder, List* list){
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        appendString(builder, "\n");
+        appendRectangleString(builder, (Rectangle*)elem);
+    }
+}
+
+void appendCircListString(StringBuilder* builder, List* list){
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        appendString(builder, "\n");
+        appendCircleString(builder, (Circle*)elem);
+    }
+}
+
+void appendPathListString(StringBuilder* builder, List* list){
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        appendString(builder, "\n");
+        appendPathString(builder, (Path*)elem);
+    }
+}
+
+void appendGroupListString(StringBuilder* builder, List* list){
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        appendString(builder, "\n");
+        appendGroupString(builder, (Group*)elem);
+    }
+}
@@ -18,6 +18,10 @@
 #include "SVGParser.h"
 #include "SVGHelper.h"
 #include "SVGHelperA2.h"
+#include "SVGFormat.h"
+#include "SVGShapes.h"
+#include "SVGPathData.h"
+#include "SVGElementPath.h"
 
 #define LIBXML_SCHEMAS_ENABLED
 
@@ -97,22 +101,44 @@ bool validateFileSVG(xmlDocPtr doc, const char* schemaFile){
 */
 xmlDocPtr createXMLFromStruct(const SVG* img){
 
+    return createXMLFromStructChecked(img, NULL);
+
+}
+
+/*
+    same as createXMLFromStruct, and if valid is not NULL it also does the checks of validSVGStruct
+    on each struct as it is added to the tree, valid is set to false if any check fails
+    so validating the struct does not need a second traversal
+    NOTE: THE CALLER MUST CALL xmlCleanupParser() AFTER THIS FUNCTION IS CALLED OR THERE WILL BE MEMORY LEAKS!!!
+*/
+xmlDocPtr createXMLFromStructChecked(const SVG* img, bool* valid){
+
     LIBXML_TEST_VERSION;
 
     xmlDocPtr doc = NULL; // document pointer
     xmlNodePtr root_node = NULL; // root of tree
 
-    // 1. convert the SVG to an XML by creating a new document, a node and set it as a root node
+    // 1. the svg fields, the same checks as validSVGStruct
+    if (valid != NULL){
+        if ((img->rectangles == NULL) || (img->circles == NULL) || (img->paths == NULL) || (img->groups == NULL) || (img->otherAttributes == NULL)) *valid = false;
+        if (validChar((char*)img->namespace) == 0 || emptyString((char*)img->namespace) == 0) *valid = false;
+        if (checkString((char*)img->title) == false || checkString((char*)img->description) == false) *valid = false;
+    }
+
+    // 2. convert the SVG to an XML by creating a new document, a node and set it as a root node
     doc = xmlNewDoc(BAD_CAST "1.0");
     root_node = xmlNewNode(NULL, BAD_CAST "svg");
     xmlDocSetRootElement(doc, root_node);
 
-    // 2. set the namespace, title, and description using the xmlNewText
+    // 3. set the namespace, title, and description using the xmlNewText
     xmlNsPtr nameSpace = xmlNewNs(root_node, (const xmlChar*) img->namespace, NULL); // prefix = NULL
     if (nameSpace == NULL){
+        xmlFreeDoc(doc);
         return NULL;
     }
     xmlSetNs(root_node, nameSpace); // set the namespace for the root node
+    // the other attributes declare the other namespaces, which the raw elements are parsed with
+    addAttrListToParentNode(img->otherAttributes, &root_node, valid);
 
     if (strlen(img->title) != 0){
         xmlNodePtr titleNode = xmlNewChild(root_node, NULL, BAD_CAST "title", NULL);
@@ -125,16 +151,21 @@ xmlDocPtr createXMLFromStruct(const SVG* img){
         xmlAddChild(descNode, descNodeTxt);
     }
 
-    /* 3.
+    /* 4.
        calling functions that will loop through list (other attributes, rect, circ, path, groups),
        and adds items to the parent, root_node svg
        these functions will be used for both the svg children and the group children
     */
-    addRectListToParentNode(img->rectangles, &root_node);
-    addCircListToParentNode(img->circles, &root_node);
-    addPathListToParentNode(img->paths, &root_node);
-    addGroupListToParentNode(img->groups, &root_node);
-    addAttrListToParentNode(img->otherAttributes, &root_node);
+    addRectListToParentNode(img->rectangles, &root_node, valid);
+    addCircListToParentNode(img->circles, &root_node, valid);
+    addPathListToParentNode(img->paths, &root_node, valid);
+    addShapeListToParentNode(img->lines, LINE, &root_node, valid);
+    addShapeListToParentNode(img->ellipses, ELLIPSE, &root_node, valid);
+    addShapeListToParentNode(img->polylines, POLYLINE, &root_node, valid);
+    addShapeListToParentNode(img->polygons, POLYGON, &root_node, valid);
+    addGroupListToParentNode(img->groups, &root_node, valid);
+    addRawElementListToParentNode(img->otherElements, &root_node, valid);
+    if (valid != NULL && validRawElementListStruct(img->otherElements) == false) *valid = false;
 
     return doc;
 
@@ -147,16 +178,25 @@ xmlDocPtr createXMLFromStruct(const SVG* img){
     - other attributes in a group
     - parent can be either SVG, group, or shape with other attirbute list
 */
-void addAttrListToParentNode(List* list, xmlNodePtr* parent){
+void addAttrListToParentNode(List* list, xmlNodePtr* parent, bool* valid){
 
-    if (list == NULL || *parent == NULL) return;
+    if (list == NULL || *parent == NULL){
+        if (valid != NULL) *valid = false; // the lists must be initialized
+        return;
+    }
 
     void* elem;
     ListIterator iter = createIterator(list); // traverse through the other attributes
     while ((elem = nextElement(&iter)) != NULL){
         Attribute* attr = (Attribute*) elem;
-        // parent node, name="value"
-        xmlNewProp(*parent, BAD_CAST attr->name, BAD_CAST attr->value);
+        if (valid != NULL && validAttrStruct(attr) == false) *valid = false;
+        // parent node, name="value", or a namespace for xmlns:prefix="uri"
+        if (strncmp(attr->name, SVG_XMLNS_PREFIX, strlen(SVG_XMLNS_PREFIX)) == 0 && strlen(attr->name) > strlen(SVG_XMLNS_PREFIX)){
+            xmlNewNs(*parent, BAD_CAST attr->value, BAD_CAST (attr->name + strlen(SVG_XMLNS_PREFIX)));
+        }
+        else{
+            xmlNewProp(*parent, BAD_CAST attr->name, BAD_CAST attr->value);
+        }
     }
 
 }
@@ -166,9 +206,12 @@ void addAttrListToParentNode(List* list, xmlNodePtr* parent){
     adds the properties/attributes in the node,
     and adds that node to the parent node given
 */
-void addRectListToParentNode(List* rectList, xmlNodePtr* parent){
+void addRectListToParentNode(List* rectList, xmlNodePtr* parent, bool* valid){
 
-    if (rectList == NULL || *parent == NULL) return;
+    if (rectList == NULL || *parent == NULL){
+        if (valid != NULL) *valid = false; // the lists must be initialized
+        return;
+    }
 
     // 1. iterate through the struct list
     void* elem;
@@ -176,6 +219,7 @@ void addRectListToParentNode(List* rectList, xmlNodePtr* parent){
     while ((elem = nextElement(&iter)) != NULL){
 
         Rectangle* rect = (Rectangle*) elem;
+        if (valid != NULL && (checkString(rect->units) == false || checkRange(rect->width) == false || checkRange(rect->height) == false)) *valid = false;
 
         // 2. rectangle node, adding it to the parent (svg or group)
         xmlNodePtr node = xmlNewChild(*parent, NULL, BAD_CAST "rect", NULL);
@@ -192,7 +236,7 @@ void addRectListToParentNode(List* rectList, xmlNodePtr* parent){
         xmlNewProp(node, BAD_CAST "height", BAD_CAST height);
 
         // 4. adding other attributes to the rectangles
-        addAttrListToParentNode(rect->otherAttributes, &node);
+        addAttrListToParentNode(rect->otherAttributes, &node, valid);
 
         free(x);
         free(y);
@@ -206,9 +250,12 @@ void addRectListToParentNode(List* rectList, xmlNodePtr* parent){
     adds the properties/attributes in the node,
     and adds that node to the parent node given
 */
-void addCircListToParentNode(List* circList, xmlNodePtr* parent){
+void addCircListToParentNode(List* circList, xmlNodePtr* parent, bool* valid){
 
-    if (circList == NULL || *parent == NULL) return;
+    if (circList == NULL || *parent == NULL){
+        if (valid != NULL) *valid = false; // the lists must be initialized
+        return;
+    }
 
     // 1. iterate through the struct list
     void* elem;
@@ -216,6 +263,7 @@ void addCircListToParentNode(List* circList, xmlNodePtr* parent){
     while ((elem = nextElement(&iter)) != NULL){
 
         Circle* circ = (Circle*) elem;
+        if (valid != NULL && (checkString(circ->units) == false || checkRange(circ->r) == false)) *valid = false;
 
         // 2. circle node, adding it to the parent (svg or group)
         xmlNodePtr node = xmlNewChild(*parent, NULL, BAD_CAST "circle", NULL);
@@ -230,7 +278,7 @@ void addCircListToParentNode(List* circList, xmlNodePtr* parent){
         xmlNewProp(node, BAD_CAST "r", BAD_CAST r);
 
         // 4. adding other attributes to the circle
-        addAttrListToParentNode(circ->otherAttributes, &node);
+        addAttrListToParentNode(circ->otherAttributes, &node, valid);
 
         free(cx);
         free(cy);
@@ -243,9 +291,12 @@ void addCircListToParentNode(List* circList, xmlNodePtr* parent){
     adds the properties/attributes in the node,
     and adds that node to the parent node given
 */
-void addPathListToParentNode(List* pathList, xmlNodePtr* parent){
+void addPathListToParentNode(List* pathList, xmlNodePtr* parent, bool* valid){
 
-    if (pathList == NULL || *parent == NULL) return;
+    if (pathList == NULL || *parent == NULL){
+        if (valid != NULL) *valid = false; // the lists must be initialized
+        return;
+    }
 
     // 1. iterate through the struct list
     void* elem;
@@ -253,6 +304,7 @@ void addPathListToParentNode(List* pathList, xmlNodePtr* parent){
     while ((elem = nextElement(&iter)) != NULL){
 
         Path* path = (Path*) elem;
+        if (valid != NULL && checkString(path->data) == false) *valid = false;
 
         // 2. path node, adding it to the parent (svg or group)
         xmlNodePtr node = xmlNewChild(*parent, NULL, BAD_CAST "path", NULL);
@@ -261,7 +313,7 @@ void addPathListToParentNode(List* pathList, xmlNodePtr* parent){
         xmlNewProp(node, BAD_CAST "d", BAD_CAST path->data);
 
         // 4. adding other attributes to the path
-        addAttrListToParentNode(path->otherAttributes, &node);
+        addAttrListToParentNode(path->otherAttributes, &node, valid);
     }
 }
 
@@ -269,9 +321,12 @@ void addPathListToParentNode(List* pathList, xmlNodePtr* parent){
     this function is for adding items from a group struct
     it is recursive, as it calls itself when it reaches an inner group list
 */
-void addGroupListToParentNode(List* groupList, xmlNodePtr* parent){
+void addGroupListToParentNode(List* groupList, xmlNodePtr* parent, bool* valid){
 
-    if (groupList == NULL || *parent == NULL) return; // base case
+    if (groupList == NULL || *parent == NULL){ // base case
+        if (valid != NULL) *valid = false; // the lists must be initialized
+        return;
+    }
 
     // 1. iterate through the struct list
     void* elem;
@@ -285,11 +340,93 @@ void addGroupListToParentNode(List* groupList, xmlNodePtr* parent){
 
         // 2. call the other attribute rect, circle, path, functions with the
         // node as the parent in this case parent is a group node
-        addRectListToParentNode(group->rectangles, &node);
-        addCircListToParentNode(group->circles, &node);
-        addPathListToParentNode(group->paths, &node);
-        addGroupListToParentNode(group->groups, &node);
-        addAttrListToParentNode(group->otherAttributes, &node);
+        addRectListToParentNode(group->rectangles, &node, valid);
+        addCircListToParentNode(group->circles, &node, valid);
+        addPathListToParentNode(group->paths, &node, valid);
+        addShapeListToParentNode(group->lines, LINE, &node, valid);
+        addShapeListToParentNode(group->ellipses, ELLIPSE, &node, valid);
+        addShapeListToParentNode(group->polylines, POLYLINE, &node, valid);
+        addShapeListToParentNode(group->polygons, POLYGON, &node, valid);
+        addGroupListToParentNode(group->groups, &node, valid);
+        addRawElementListToParentNode(group->otherElements, &node, valid);
+        addAttrListToParentNode(group->otherAttributes, &node, valid);
+        if (valid != NULL && validRawElementListStruct(group->otherElements) == false) *valid = false;
+    }
+
+}
+
+// true if the node is a child of the type, the title and desc for SVG_IMG
+static bool rawAnchorNode(xmlNodePtr node, elementType type){
+
+    if (node->type != XML_ELEMENT_NODE) return false;
+    if (type == SVG_IMG) return xmlStrEqual(node->name, BAD_CAST "title") || xmlStrEqual(node->name, BAD_CAST "desc");
+
+    return xmlStrEqual(node->name, BAD_CAST pathElementName(type));
+}
+
+/*
+    the child of the parent a raw element goes after (see RawElement), NULL when it goes first,
+    or the last child when the parent has no such child
+    the search goes on from the child found for the type before, so the children are walked once for the whole list
+*/
+static xmlNodePtr rawElementParentAnchor(xmlNodePtr parent, const RawElement* raw, xmlNodePtr* found, int* counted){
+
+    int wanted = (raw->place.afterType == SVG_IMG) ? raw->place.afterIndex : raw->place.afterIndex + 1;
+    if (wanted <= 0) return NULL;
+
+    xmlNodePtr node = found[raw->place.afterType];
+    int count = counted[raw->place.afterType];
+    while (count < wanted){
+        node = (node == NULL) ? parent->children : node->next;
+        if (node == NULL) return xmlGetLastChild(parent);
+        if (rawAnchorNode(node, raw->place.afterType)) ++count;
+    }
+
+    found[raw->place.afterType] = node;
+    counted[raw->place.afterType] = count;
+    return node;
+}
+
+/*
+    the raw elements are parsed back into nodes in the context of the parent, so they use its namespaces,
+    and each is put after the child it was read after, so this is called once the other children are added
+    valid is set to false if one of them is not well formed xml
+    the list may be NULL, the svg or group has no other elements then
+*/
+void addRawElementListToParentNode(List* elementList, xmlNodePtr* parent, bool* valid){
+
+    if (elementList == NULL || *parent == NULL) return;
+
+    xmlNodePtr found[POLYGON + 1] = { NULL };
+    int counted[POLYGON + 1] = { 0 };
+    // the raw elements after the same child follow each other, each goes after the one before it
+    const RawElement* previous = NULL;
+    xmlNodePtr after = NULL;
+
+    void* elem;
+    ListIterator iter = createIterator(elementList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        RawElement* raw = (RawElement*) elem;
+
+        xmlNodePtr nodes = NULL;
+        if (xmlParseInNodeContext(*parent, raw->xml, (int)raw->length, 0, &nodes) != XML_ERR_OK){
+            xmlFreeNodeList(nodes);
+            if (valid != NULL) *valid = false;
+            continue;
+        }
+
+        bool sameChild = (previous != NULL && previous->place.afterType == raw->place.afterType && previous->place.afterIndex == raw->place.afterIndex);
+        if (sameChild == false) after = rawElementParentAnchor(*parent, raw, found, counted);
+        previous = raw;
+
+        xmlNodePtr next = NULL;
+        for (xmlNodePtr node = nodes; node != NULL; node = next){
+            next = node->next;
+            if (after != NULL) after = xmlAddNextSibling(after, node);
+            else if ((*parent)->children != NULL) after = xmlAddPrevSibling((*parent)->children, node);
+            else after = xmlAddChild(*parent, node);
+        }
     }
 
 }
@@ -303,13 +440,14 @@ void addGroupListToParentNode(List* groupList, xmlNodePtr* parent){
 */
 char* unitsWithNumber(float number, char units[]){
 
-    char* numWithUnits = malloc(50 + (strlen(units)) + 1); // max length of float, units, and \0
+    char numString[SVG_NUMBER_LENGTH];
+    formatNumber(numString, sizeof(numString), number, getWriteOptions().precision); // the precision writeSVG would use
 
-    sprintf(numWithUnits, "%f", number);
+    char* numWithUnits = malloc(strlen(numString) + strlen(units) + 1); // number, units, and \0
+    if (numWithUnits == NULL) return NULL;
 
-    if (strlen(units) > 0){
-        strcat(numWithUnits, units);
-    }
+    strcpy(numWithUnits, numString);
+    strcat(numWithUnits, units);
 
     return numWithUnits;
 
@@ -348,6 +486,9 @@ bool validSVGStruct(const SVG* svg){ // const means it cannot be changes
     if ((isListEmpty(svg->paths) == 0) && (validPathListStruct(svg->paths) == false)) return false;
     if ((isListEmpty(svg->groups) == 0) && (validGroupListStruct(svg->groups) == false)) return false;
     if ((isListEmpty(svg->otherAttributes) == 0) && (validAttrListStruct(svg->otherAttributes) == false)) return false;
+    if (validRawElementListStruct(svg->otherElements) == false) return false;
+    if (validShapeListStruct(svg->lines, LINE) == false || validShapeListStruct(svg->ellipses, ELLIPSE) == false) return false;
+    if (validShapeListStruct(svg->polylines, POLYLINE) == false || validShapeListStruct(svg->polygons, POLYGON) == false) return false;
 
     // 4. success
     return true;
@@ -383,6 +524,22 @@ bool validAttrListStruct(List* otherAttributes){
 
 }
 
+// validates the raw elements, the list may be NULL, each element must hold some xml of the length it says
+bool validRawElementListStruct(List* otherElements){
+
+    if (otherElements == NULL) return true;
+
+    void* elem;
+    ListIterator iter = createIterator(otherElements);
+    while ((elem = nextElement(&iter)) != NULL){
+        RawElement* raw = (RawElement*) elem;
+        if (raw->length == 0 || strlen(raw->xml) != raw->length) return false;
+    }
+
+    return true;
+
+}
+
 // validates single rectangle structure
 bool validRectStruct(Rectangle* rect){
 
@@ -508,6 +665,9 @@ bool validGroupStruct(Group* group){
     if ((isListEmpty(group->paths) == 0) && (validPathListStruct(group->paths) == false)) return false;
     if ((isListEmpty(group->groups) == 0) && (validGroupListStruct(group->groups) == false)) return false;
     if ((isListEmpty(group->otherAttributes) == 0) && (validAttrListStruct(group->otherAttributes) == false)) return false;
+    if (validRawElementListStruct(group->otherElements) == false) return false;
+    if (validShapeListStruct(group->lines, LINE) == false || validShapeListStruct(group->ellipses, ELLIPSE) == false) return false;
+    if (validShapeListStruct(group->polylines, POLYLINE) == false || validShapeListStruct(group->polygons, POLYGON) == false) return false;
 
     return true;
 }
@@ -531,7 +691,7 @@ bool validGroupListStruct(List* groupList){
 }
 
 // validates that a string is initialized and may be empty
-bool checkString(char* string){
+bool checkString(const char* string){
 
     if (string == NULL) return false;
     if ((validChar(string) == 0) && (strcmp(string, "") != 0)) return false; // may be empty, may not be null
@@ -598,15 +758,15 @@ bool changeValueInAttr (List* attrList, Attribute* newAttribute){
     if (attrList == NULL || newAttribute == NULL) return false;
 
     bool found = false;
-    void* elem;
-    ListIterator iter = createIterator(attrList); // traverse through the other attributes
-    while ((elem = nextElement(&iter)) != NULL){
-        Attribute* attr = (Attribute*) elem;
+    for (Node* node = attrList->head; node != NULL; node = node->next){ // traverse through the other attributes
+        Attribute* attr = (Attribute*) node->data;
         if (strcasecmp(attr->name, newAttribute->name) == 0){
             found = true;
             if (validAttrStruct(newAttribute) == false) return false; // must check if the attribute is valid. if return is false do not need to free attribute
-            if (strlen(newAttribute->value) > strlen(attr->value)) return false; // cannot reallocate
-            strcpy(attr->value, newAttribute->value);
+            // in place when the value fits, otherwise the attribute is reallocated in the same node
+            attr = setAttributeValue(attr, newAttribute->value);
+            if (attr == NULL) return false;
+            node->data = attr;
             deleteAttribute((void*) newAttribute);
             break;
         }
@@ -619,144 +779,145 @@ bool changeValueInAttr (List* attrList, Attribute* newAttribute){
 }
 
 
-// loops through rectangles to change the value. if not present, checks other attributes list
+// changes the value in the rectangle at the index. if not present, checks other attributes list
 bool changeValueInRect (List* rectList, int index, Attribute* newAttribute){
 
     if (rectList == NULL || newAttribute == NULL) return false;
 
-    int i = 0;
-    void* elem;
-    ListIterator iter = createIterator(rectList); // traverse through the rects
-    while ((elem = nextElement(&iter)) != NULL){
-        Rectangle* rect = (Rectangle*) elem;
+    Rectangle* rect = (Rectangle*) getElementAt(rectList, index); // the rect struct that we want to adjust
+    if (rect == NULL) return false;
 
-        // reached the index of the rect struct that we want to adjust
-        if (i == index){
-            if (strcasecmp(newAttribute->name, "x") == 0){
-                bool valid = changeCoor(&(rect->x), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else if (strcasecmp(newAttribute->name, "y") == 0){
-                bool valid = changeCoor(&(rect->y), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else if (strcasecmp(newAttribute->name, "width") == 0){
-                bool valid = changeDimen(&(rect->width), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else if (strcasecmp(newAttribute->name, "height") == 0){
-                bool valid = changeDimen(&(rect->height), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else{
-                bool valid = changeValueInAttr(rect->otherAttributes, newAttribute);
-                if (valid == false) return false;
-                //changeValueInAttr is in charge of freeing the attribute depending on whther it is changed or appended
-            }
-            break;
-        }
-        ++i;
+    if (strcasecmp(newAttribute->name, "x") == 0){
+        bool valid = changeCoor(&(rect->x), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else if (strcasecmp(newAttribute->name, "y") == 0){
+        bool valid = changeCoor(&(rect->y), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else if (strcasecmp(newAttribute->name, "width") == 0){
+        bool valid = changeDimen(&(rect->width), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else if (strcasecmp(newAttribute->name, "height") == 0){
+        bool valid = changeDimen(&(rect->height), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else{
+        bool valid = changeValueInAttr(rect->otherAttributes, newAttribute);
+        if (valid == false) return false;
+        //changeValueInAttr is in charge of freeing the attribute depending on whther it is changed or appended
     }
 
     return true;
 }
 
-// loops through circles to change the value. if not present, checks other attributes list
+// changes the value in the circle at the index. if not present, checks other attributes list
 bool changeValueInCirc (List* circList, int index, Attribute* newAttribute){
 
     if (circList == NULL || newAttribute == NULL) return false;
 
-    int i = 0;
-    void* elem;
-    ListIterator iter = createIterator(circList); // traverse through the circle
-    while ((elem = nextElement(&iter)) != NULL){
-        Circle* circ = (Circle*) elem;
+    Circle* circ = (Circle*) getElementAt(circList, index); // the circle struct that we want to adjust
+    if (circ == NULL) return false;
 
-        // reached the index of the circle struct that we want to adjust
-        if (i == index){
-            if (strcasecmp(newAttribute->name, "cx") == 0){
-                bool valid = changeCoor(&(circ->cx), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else if (strcasecmp(newAttribute->name, "cy") == 0){
-                bool valid = changeCoor(&(circ->cy), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else if (strcasecmp(newAttribute->name, "r") == 0){
-                bool valid = changeDimen(&(circ->r), newAttribute->value);
-                if (valid == false) return false;
-                deleteAttribute((void*) newAttribute);
-            }
-            else{
-                bool valid = changeValueInAttr(circ->otherAttributes, newAttribute);
-                if (valid == false) return false;
-            }
-            break;
-        }
-        ++i;
+    if (strcasecmp(newAttribute->name, "cx") == 0){
+        bool valid = changeCoor(&(circ->cx), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else if (strcasecmp(newAttribute->name, "cy") == 0){
+        bool valid = changeCoor(&(circ->cy), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else if (strcasecmp(newAttribute->name, "r") == 0){
+        bool valid = changeDimen(&(circ->r), newAttribute->value);
+        if (valid == false) return false;
+        deleteAttribute((void*) newAttribute);
+    }
+    else{
+        bool valid = changeValueInAttr(circ->otherAttributes, newAttribute);
+        if (valid == false) return false;
     }
 
     return true;
 }
 
-// loops through paths to change the value. if not present, checks other attributes list
+// changes the value in the path at the index. if not present, checks other attributes list
 bool changeValueInPath (List* pathList, int index, Attribute* newAttribute){
 
     if (pathList == NULL || newAttribute == NULL) return false;
 
-    int i = 0;
-    void* elem;
-    ListIterator iter = createIterator(pathList); // traverse through the path
-    while ((elem = nextElement(&iter)) != NULL){
-        Path* path = (Path*) elem;
-
-        // reached the index of the path struct that we want to adjust
-        if (i == index){
-            if (strcasecmp(newAttribute->name, "d") == 0){
-                // check for validity
-                if (checkString(path->data) == false) return false; // may be empty, may not be null
-                if (strlen(newAttribute->value) > strlen(path->data)) return false; // cannot reallocate
-                strcpy(path->data, newAttribute->value);
-                deleteAttribute((void*) newAttribute);
-            }
-            else{
-                bool valid = changeValueInAttr(path->otherAttributes, newAttribute);
-                if (valid == false) return false;
-            }
-            break;
-        }
-        ++i;
+    Node* node = getNodeAt(pathList, index); // the path struct that we want to adjust
+    if (node == NULL) return false;
+    Path* path = (Path*) node->data;
+
+    if (strcasecmp(newAttribute->name, "d") == 0){
+        // check for validity
+        if (checkString(path->data) == false) return false; // may be empty, may not be null
+        // the path is given the string of the store with the new data
+        if (setPathData(path, newAttribute->value) == false) return false;
+        clearPathData(path); // the commands are read again from the new data
+        deleteAttribute((void*) newAttribute);
+    }
+    else{
+        bool valid = changeValueInAttr(path->otherAttributes, newAttribute);
+        if (valid == false) return false;
     }
 
     return true;
 }
 
-// loops through groups other attributes list to change the value. if not present, appends to list
+// changes the value in the other attributes list of the group at the index. if not present, appends to list
 bool changeValueInGroup (List* groupList, int index, Attribute* newAttribute){
 
     if (groupList == NULL || newAttribute == NULL) return false;
 
-    int i = 0;
-    bool found = false;
-    void* elem;
-    ListIterator iter = createIterator(groupList); // traverse through the path
-    while ((elem = nextElement(&iter)) != NULL){
-        Group* group = (Group*) elem;
+    Group* group = (Group*) getElementAt(groupList, index); // the group struct that we want to adjust
+    if (group == NULL) return false;
 
-        // reached the index of the path struct that we want to adjust
-        if (i == index){
-            // in a group, we do not modify items in the inner lists
-            found = changeValueInAttr(group->otherAttributes, newAttribute);
-            break;
-        }
-        ++i;
+    // in a group, we do not modify items in the inner lists
+    return changeValueInAttr(group->otherAttributes, newAttribute);
+}
+
+bool addComponentToGroup (List* groupList, int index, elementType type, void* newElement){
+
+    if (groupList == NULL || newElement == NULL) return false;
+
+    // the group struct that we want to add to
+    Group* group = (Group*) getElementAt(groupList, index);
+    if (group == NULL) return false; // index out of bounds
+
+    return addShapeToGroup(group, type, newElement);
+}
+
+// adds a valid shape to the end of its list in the group
+bool addShapeToGroup (Group* group, elementType type, void* newElement){
+
+    if (group == NULL || newElement == NULL) return false;
+
+    if (type == RECT && validRectStruct((Rectangle*)newElement) == true){
+        insertBack(group->rectangles, newElement);
+        return true;
+    }
+    else if (type == CIRC && validCircStruct((Circle*)newElement) == true){
+        insertBack(group->circles, newElement);
+        return true;
+    }
+    else if (type == PATH && validPathStruct((Path*)newElement) == true){
+        insertBack(group->paths, newElement);
+        return true;
+    }
+    else if (groupShapeList(group, type) != NULL && validShapeStruct(newElement, type) == true){
+        List** list = groupShapeList(group, type);
+        if (*list == NULL) *list = initShapeList(type);
+        insertBack(*list, newElement);
+        return true;
     }
 
-    return found;
+    return false; // not a valid component for a group
 }
@@ -0,0 +1,601 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelper.h"
+#include "SVGHelperA2.h"
+#include "SVGHelperJSON.h"
+#include "SVGShapes.h"
+#include "SVGTransform.h"
+#include "SVGElementPath.h"
+#include "SVGSpatial.h"
+
+/*
+    The JSON strings given to the wrapper functions are made by JSON.stringify in the server,
+    so only flat objects (and arrays of flat objects) need to be read here.
+    The skip functions return a pointer to the first character after the value, or NULL if the value is malformed
+*/
+const char* skipJSONSpaces(const char* json){
+
+    while (*json == ' ' || *json == '\t' || *json == '\n' || *json == '\r') ++json;
+    return json;
+}
+
+const char* skipJSONString(const char* json){
+
+    if (*json != '"') return NULL;
+    ++json;
+    while (*json != '\0' && *json != '"'){
+        if (*json == '\\' && *(json + 1) != '\0') ++json; // escaped character, including \"
+        ++json;
+    }
+    if (*json != '"') return NULL; // string never closed
+    return json + 1;
+}
+
+const char* skipJSONValue(const char* json){
+
+    json = skipJSONSpaces(json);
+
+    if (*json == '"') return skipJSONString(json);
+
+    if (*json == '{' || *json == '['){
+        // nested object or array, keep track of the depth so inner brackets are skipped
+        int depth = 0;
+        while (*json != '\0'){
+            if (*json == '"'){
+                json = skipJSONString(json);
+                if (json == NULL) return NULL;
+                continue;
+            }
+            if (*json == '{' || *json == '[') ++depth;
+            else if (*json == '}' || *json == ']'){
+                --depth;
+                if (depth == 0) return json + 1;
+            }
+            ++json;
+        }
+        return NULL;
+    }
+
+    // number, true, false or null
+    const char* start = json;
+    while (*json != '\0' && *json != ',' && *json != '}' && *json != ']' && *json != ' ' && *json != '\n' && *json != '\t' && *json != '\r') ++json;
+    if (json == start) return NULL;
+    return json;
+}
+
+// appends a unicode code point to a string as UTF-8, returns the number of bytes written
+int encodeUTF8(char* dest, unsigned int codePoint){
+
+    if (codePoint < 0x80){
+        dest[0] = (char)codePoint;
+        return 1;
+    }
+    if (codePoint < 0x800){
+        dest[0] = (char)(0xC0 | (codePoint >> 6));
+        dest[1] = (char)(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000){
+        dest[0] = (char)(0xE0 | (codePoint >> 12));
+        dest[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        dest[2] = (char)(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    dest[0] = (char)(0xF0 | (codePoint >> 18));
+    dest[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+    dest[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+    dest[3] = (char)(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+// reads the 4 hex digits of a \u escape before end, false if there are not exactly 4 of them
+static bool readJSONHex(const char* json, const char* end, unsigned int* value){
+
+    if (end - json < 4) return false;
+
+    *value = 0;
+    for (int i = 0; i < 4; ++i){
+        char c = json[i];
+        unsigned int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        *value = (*value << 4) | digit;
+    }
+    return true;
+}
+
+/*
+    copies the contents of a quoted JSON string (start points at the opening quote, end after the closing quote)
+    and replaces the escape sequences with the characters they represent
+    returns NULL for an escape JSON does not have, a \u without 4 hex digits, or a surrogate that is not in a pair
+    caller must free string
+*/
+char* copyJSONString(const char* start, const char* end){
+
+    char* string = malloc((end - start) + 1); // unescaping never makes the string longer
+    if (string == NULL) return NULL;
+
+    int length = 0;
+    bool valid = true;
+    const char* json = start + 1;
+    const char* last = end - 1; // the closing quote
+    while (valid && json < last){
+        if (*json != '\\'){
+            string[length++] = *json++;
+            continue;
+        }
+        ++json;
+        switch (*json){
+            case 'b': string[length++] = '\b'; break;
+            case 'f': string[length++] = '\f'; break;
+            case 'n': string[length++] = '\n'; break;
+            case 'r': string[length++] = '\r'; break;
+            case 't': string[length++] = '\t'; break;
+            case '"': case '\\': case '/': string[length++] = *json; break;
+            case 'u':{
+                unsigned int codePoint;
+                valid = readJSONHex(json + 1, last, &codePoint) && (codePoint < 0xDC00 || codePoint > 0xDFFF);
+                if (valid == false) break;
+                json += 4;
+
+                // a high surrogate must be followed by a low one, for the characters outside the basic plane
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF){
+                    unsigned int low;
+                    valid = (last - json > 2 && json[1] == '\\' && json[2] == 'u' && readJSONHex(json + 3, last, &low) && low >= 0xDC00 && low <= 0xDFFF);
+                    if (valid == false) break;
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    json += 6;
+                }
+                length += encodeUTF8(string + length, codePoint);
+                break;
+            }
+            default: valid = false; break;
+        }
+        ++json;
+    }
+
+    if (valid == false){
+        free(string);
+        return NULL;
+    }
+    string[length] = '\0';
+
+    return string;
+}
+
+/*
+    given a cursor inside a JSON array, returns a copy of the next object in the array
+    and moves the cursor past it
+    returns NULL when there are no more objects
+    caller must free string
+*/
+char* nextJSONObject(const char** cursor){
+
+    if (cursor == NULL || *cursor == NULL) return NULL;
+
+    // 1. the first object follows the opening bracket, and every other object a comma
+    const char* json = skipJSONSpaces(*cursor);
+    if (*json == '[' || *json == ','){
+        bool comma = (*json == ',');
+        json = skipJSONSpaces(json + 1);
+        if (*json != '{' && (comma || *json != ']')){
+            *cursor = NULL; // an empty element like [,{...}] or [{...},]
+            return NULL;
+        }
+    }
+    else if (*json == '{'){
+        *cursor = NULL; // two objects with no comma between them
+        return NULL;
+    }
+    if (*json != '{'){
+        *cursor = json;
+        return NULL;
+    }
+
+    // 2. find the end of the object and copy it
+    const char* end = skipJSONValue(json);
+    if (end == NULL){
+        *cursor = NULL;
+        return NULL;
+    }
+
+    char* object = malloc((end - json) + 1);
+    if (object == NULL) return NULL;
+    memcpy(object, json, end - json);
+    object[end - json] = '\0';
+
+    *cursor = end;
+    return object;
+}
+
+/*
+    returns the value for a key in a JSON object, strings are returned without their quotes
+    objects and arrays are returned as their JSON text
+    returns NULL if the key is not found
+    caller must free string
+*/
+char* getJSONValue(const char* object, const char* key){
+
+    if (object == NULL || key == NULL) return NULL;
+
+    const char* json = skipJSONSpaces(object);
+    if (*json != '{') return NULL;
+    json = skipJSONSpaces(json + 1);
+
+    while (*json == '"'){
+
+        // 1. the key
+        const char* keyEnd = skipJSONString(json);
+        if (keyEnd == NULL) return NULL;
+        bool match = ((size_t)(keyEnd - json - 2) == strlen(key)) && (strncmp(json + 1, key, keyEnd - json - 2) == 0);
+
+        json = skipJSONSpaces(keyEnd);
+        if (*json != ':') return NULL;
+        json = skipJSONSpaces(json + 1);
+
+        // 2. the value
+        const char* valueEnd = skipJSONValue(json);
+        if (valueEnd == NULL) return NULL;
+
+        if (match){
+            if (*json == '"') return copyJSONString(json, valueEnd);
+
+            char* value = malloc((valueEnd - json) + 1);
+            if (value == NULL) return NULL;
+            memcpy(value, json, valueEnd - json);
+            value[valueEnd - json] = '\0';
+            return value;
+        }
+
+        // 3. next pair
+        json = skipJSONSpaces(valueEnd);
+        if (*json != ',') return NULL;
+        json = skipJSONSpaces(json + 1);
+    }
+
+    return NULL;
+}
+
+// reads a number from a JSON object, returns false if it is missing or not a number
+bool getJSONFloat(const char* object, const char* key, float* number){
+
+    char* value = getJSONValue(object, key);
+    if (value == NULL) return false;
+
+    char* end;
+    float tmp = strtof(value, &end);
+    bool valid = (end != value) && (*end == '\0') && checkInvalid(tmp);
+    free(value);
+
+    if (valid) *number = tmp;
+    return valid;
+}
+
+bool getJSONInt(const char* object, const char* key, int* number){
+
+    float tmp;
+    if (getJSONFloat(object, key, &tmp) == false) return false;
+    *number = (int)tmp;
+    return true;
+}
+
+/*
+    returns the type of shape described by the "type" key of an object,
+    SVG_IMG is returned when the type is missing or not one of the shapes
+*/
+elementType JSONShapeType(const char* object){
+
+    char* type = getJSONValue(object, "type");
+    if (type == NULL) return SVG_IMG;
+
+    elementType elem = SVG_IMG;
+    if ((strcasecmp(type, "rect") == 0) || (strcasecmp(type, "rectangle") == 0)) elem = RECT;
+    else if ((strcasecmp(type, "circle") == 0) || (strcasecmp(type, "circ") == 0)) elem = CIRC;
+    else if (strcasecmp(type, "path") == 0) elem = PATH;
+
+    free(type);
+    return elem;
+}
+
+// copies the units of a shape, units are optional and are truncated to fit the field
+void getJSONUnits(const char* object, char units[50]){
+
+    strcpy(units, "");
+
+    char* value = getJSONValue(object, "units");
+    if (value == NULL) return;
+
+    if (checkString(value) == true){
+        strncpy(units, value, 49);
+        units[49] = '\0';
+    }
+    free(value);
+}
+
+/*
+    adds the attributes in a JSON array of the format [{"name":"fill","value":"red"}, ...]
+    to the other attributes list of a shape
+*/
+bool JSONtoAttrList(const char* array, List* otherAttributesList){
+
+    if (array == NULL || otherAttributesList == NULL) return false;
+
+    const char* cursor = array;
+    char* object;
+    while ((object = nextJSONObject(&cursor)) != NULL){
+
+        char* name = getJSONValue(object, "name");
+        char* value = getJSONValue(object, "value");
+        free(object);
+
+        Attribute* attr = otherAttributes(name, value);
+        free(name);
+        free(value);
+
+        if (attr == NULL || validChar(attr->name) == 0 || validAttrStruct(attr) == false){
+            deleteAttribute((void*)attr);
+            return false;
+        }
+        insertBack(otherAttributesList, (void*)attr);
+    }
+
+    // the whole array must have been read, otherwise the JSON was malformed
+    return cursor != NULL && *skipJSONSpaces(cursor) == ']';
+}
+
+/*
+    creates a rectangle, circle, or path from an object of the format
+    {"type":"rect","x":0,"y":0,"w":1,"h":1,"units":"cm","attributes":[...]}
+    {"type":"circle","cx":0,"cy":0,"r":1,"units":"","attributes":[...]}
+    {"type":"path","d":"M0 0 L 1 1","attributes":[...]}
+    width and height may also be given as "width" and "height"
+    the type of the new shape is given back through the type parameter
+    returns NULL if the object does not describe a valid shape
+*/
+void* JSONtoShape(const char* object, elementType* type){
+
+    if (object == NULL || type == NULL) return NULL;
+
+    void* shape = NULL;
+    List* otherAttributesList = NULL;
+
+    // 1. create the shape from its own values
+    *type = JSONShapeType(object);
+    if (*type == RECT){
+        Rectangle* rect = malloc(sizeof(Rectangle));
+        if (rect == NULL) return NULL;
+
+        rect->x = 0;
+        rect->y = 0;
+        getJSONFloat(object, "x", &(rect->x));
+        getJSONFloat(object, "y", &(rect->y));
+        if ((getJSONFloat(object, "w", &(rect->width)) == false) && (getJSONFloat(object, "width", &(rect->width)) == false)) rect->width = -1;
+        if ((getJSONFloat(object, "h", &(rect->height)) == false) && (getJSONFloat(object, "height", &(rect->height)) == false)) rect->height = -1;
+        getJSONUnits(object, rect->units);
+
+        rect->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+        otherAttributesList = rect->otherAttributes;
+        shape = rect;
+    }
+    else if (*type == CIRC){
+        Circle* circ = malloc(sizeof(Circle));
+        if (circ == NULL) return NULL;
+
+        circ->cx = 0;
+        circ->cy = 0;
+        getJSONFloat(object, "cx", &(circ->cx));
+        getJSONFloat(object, "cy", &(circ->cy));
+        if (getJSONFloat(object, "r", &(circ->r)) == false) circ->r = -1;
+        getJSONUnits(object, circ->units);
+
+        circ->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+        otherAttributesList = circ->otherAttributes;
+        shape = circ;
+    }
+    else if (*type == PATH){
+        Path* path = JSONtoPath(object);
+        if (path == NULL) return NULL;
+
+        otherAttributesList = path->otherAttributes;
+        shape = path;
+    }
+    else{
+        return NULL;
+    }
+
+    // 2. add the other attributes, if there are any
+    char* attributes = getJSONValue(object, "attributes");
+    bool valid = true;
+    if (attributes != NULL){
+        valid = JSONtoAttrList(attributes, otherAttributesList);
+        free(attributes);
+    }
+
+    // 3. validate the shape against the svgparser.h specifications
+    if (valid == true){
+        if (*type == RECT) valid = validRectStruct((Rectangle*)shape);
+        else if (*type == CIRC) valid = validCircStruct((Circle*)shape);
+        else valid = validPathStruct((Path*)shape);
+    }
+
+    if (valid == false){
+        if (*type == RECT) deleteRectangle(shape);
+        else if (*type == CIRC) deleteCircle(shape);
+        else deletePath(shape);
+        return NULL;
+    }
+
+    return shape;
+}
+
+/*
+    creates the shape of a JSON object and adds it to the svg, to the top level group of its "group" index,
+    or to the group of its "path" at any depth (see SVGElementPath.h)
+*/
+bool addJSONShape(SVG* img, const char* object){
+
+    if (img == NULL || object == NULL) return false;
+
+    elementType type;
+    void* shape = JSONtoShape(object, &type); // validates against restrictions
+    if (shape == NULL) return false;
+
+    char* path = getJSONValue(object, "path");
+    int groupIndex = -1;
+    getJSONInt(object, "group", &groupIndex);
+
+    bool added = true;
+    if (path != NULL){
+        added = addComponentAtPath(img, path, type, shape);
+    }
+    else if (groupIndex < 0){
+        addComponent(img, type, shape);
+    }
+    else{
+        added = addComponentToGroup(img->groups, groupIndex, type, shape);
+        if (added) shapeAdded(img, (Group*) getElementAt(img->groups, groupIndex), type, shape);
+    }
+    free(path);
+
+    if (added == false){
+        if (type == RECT) deleteRectangle(shape);
+        else if (type == CIRC) deleteCircle(shape);
+        else deletePath(shape);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+    creates every shape of a JSON array and adds it to the svg, a shape may target a top level group with a "group" index
+    @return false if a shape is invalid or the JSON is malformed, the shapes before it are already added
+*/
+bool addJSONShapes(SVG* img, const char* shapes){
+
+    if (img == NULL || shapes == NULL) return false;
+
+    const char* cursor = shapes;
+    char* object;
+    while ((object = nextJSONObject(&cursor)) != NULL){
+        bool added = addJSONShape(img, object);
+        free(object);
+        if (added == false) return false;
+    }
+
+    // the whole array must have been read, otherwise the JSON was malformed
+    return cursor != NULL && *skipJSONSpaces(cursor) == ']';
+}
+
+/*
+    applies one edit of the format {"op":"...", ...} to the svg, the edits are the same as the wrappers:
+        {"op":"title","value":"..."} and {"op":"description","value":"..."}
+        {"op":"attribute","component":"Rectangle","index":0,"name":"fill","value":"red"}, the index is required,
+            "SVG" for the svg itself which has no index
+        {"op":"attribute","path":"g0/rect1","name":"fill","value":"red"}, for an element in a group
+        {"op":"scale","component":"Circle","value":2}
+        {"op":"transform","translateX":0,"translateY":0,"angle":0,"scale":1}, the numbers left out do not move the shapes
+        {"op":"add","type":"circle","cx":1,"cy":2,"r":3,"group":0}, the same object as addShapesJSON, or with a "path"
+    @return false if the edit is unknown or cannot be applied
+*/
+bool applyJSONEdit(SVG* img, const char* edit){
+
+    if (img == NULL || edit == NULL) return false;
+
+    char* op = getJSONValue(edit, "op");
+    if (op == NULL) return false;
+
+    bool applied = false;
+
+    if (strcasecmp(op, "title") == 0 || strcasecmp(op, "description") == 0){
+        // 1. the title and description are checked like changeTitle
+        char* value = getJSONValue(edit, "value");
+        if (value != NULL && validChar(value) != 0 && strlen(value) < 256){
+            strcpy((strcasecmp(op, "title") == 0) ? img->title : img->description, value);
+            applied = true;
+        }
+        free(value);
+    }
+    else if (strcasecmp(op, "attribute") == 0){
+        // 2. set or add an attribute, like setNewAttributes
+        char* component = getJSONValue(edit, "component");
+        char* path = getJSONValue(edit, "path");
+        char* name = getJSONValue(edit, "name");
+        char* value = getJSONValue(edit, "value");
+        // the element of a component is named by its index, which must be given, only the svg itself has none
+        elementType type = componentTypeNamed(component);
+        int index = 0;
+        bool hasIndex = getJSONInt(edit, "index", &index) && index >= 0;
+        bool named = (path != NULL) || (component != NULL && (type == SVG_IMG || hasIndex));
+
+        Attribute* newAttribute = named ? otherAttributes(name, value) : NULL;
+        if (newAttribute != NULL && validAttrStruct(newAttribute)){
+            if (path != NULL) applied = setAttributeAtPath(img, path, newAttribute);
+            else applied = setAttribute(img, type, index, newAttribute);
+        }
+        if (applied == false && newAttribute != NULL) deleteAttribute((void*)newAttribute);
+
+        free(component);
+        free(path);
+        free(name);
+        free(value);
+    }
+    else if (strcasecmp(op, "scale") == 0){
+        // 3. scale every shape of the type, like scalePrimitives
+        char* component = getJSONValue(edit, "component");
+        elementType type = componentTypeNamed(component);
+        float scaleValue = 0;
+        if (type != SVG_IMG && type != GROUP && getJSONFloat(edit, "value", &scaleValue)){
+            applied = scaleShapes(img, type, scaleValue);
+        }
+        free(component);
+    }
+    else if (strcasecmp(op, "transform") == 0){
+        // 4. move every shape, like transformComponents
+        float translateX = 0, translateY = 0, angle = 0, scaleValue = 1;
+        getJSONFloat(edit, "translateX", &translateX);
+        getJSONFloat(edit, "translateY", &translateY);
+        getJSONFloat(edit, "angle", &angle);
+        getJSONFloat(edit, "scale", &scaleValue);
+
+        float matrix[6];
+        composeMatrix(translateX, translateY, angle, scaleValue, matrix);
+        applied = transformSVG(img, matrix, SVG_SHAPES_MASK);
+    }
+    else if (strcasecmp(op, "add") == 0){
+        applied = addJSONShape(img, edit);
+    }
+
+    free(op);
+    return applied;
+}
+
+/*
+    applies every edit of a JSON array to the svg in order
+    @return false if an edit cannot be applied or the JSON is malformed, the edits before it are already applied,
+    so the caller must throw the svg away
+*/
+bool applyJSONEdits(SVG* img, const char* edits){
+
+    if (img == NULL || edits == NULL) return false;
+
+    const char* cursor = edits;
+    char* object;
+    while ((object = nextJSONObject(&cursor)) != NULL){
+        bool applied = applyJSONEdit(img, object);
+        free(object);
+        if (applied == false) return false;
+    }
+
+    // the whole array must have been read, otherwise the JSON was malformed
+    return cursor != NULL && *skipJSONSpaces(cursor) == ']';
+}
@@ -0,0 +1,315 @@
+// Name: Haifaa Abushaaban
+
+#define _POSIX_C_SOURCE 200809L // fsync, ftruncate, fileno
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelperJSON.h"
+#include "SVGStringBuilder.h"
+#include "SVGJournal.h"
+
+// the names are in the order of JournalOp
+static const char* journalOpNames[] = {"unknown", "title", "description", "attribute", "scale", "transform", "add"};
+
+// the name of the journal of the file, which the caller must free
+char* journalName(const char* fileName){
+
+    if (fileName == NULL) return NULL;
+
+    char* name = malloc(strlen(fileName) + sizeof(SVG_JOURNAL_SUFFIX));
+    if (name == NULL) return NULL;
+
+    strcpy(name, fileName);
+    strcat(name, SVG_JOURNAL_SUFFIX);
+    return name;
+}
+
+bool journalExists(const char* fileName){
+
+    return journalSize(fileName) >= 0;
+}
+
+// the bytes in the journal of the file, or -1 if it has none
+long journalSize(const char* fileName){
+
+    char* name = journalName(fileName);
+    if (name == NULL) return -1;
+
+    struct stat fileStat;
+    long size = (stat(name, &fileStat) == 0) ? (long)fileStat.st_size : -1;
+
+    free(name);
+    return size;
+}
+
+// true if the file has no journal after the call
+bool removeJournal(const char* fileName){
+
+    char* name = journalName(fileName);
+    if (name == NULL) return false;
+
+    bool removed = (remove(name) == 0 || journalSize(fileName) < 0);
+
+    free(name);
+    return removed;
+}
+
+JournalOp journalOpNamed(const char* name){
+
+    if (name == NULL) return JOURNAL_UNKNOWN;
+
+    for (int op = JOURNAL_TITLE; op <= JOURNAL_ADD; ++op){
+        if (strcasecmp(name, journalOpNames[op]) == 0) return (JournalOp)op;
+    }
+
+    return JOURNAL_UNKNOWN;
+}
+
+const char* journalOpName(JournalOp op){
+
+    if (op < JOURNAL_UNKNOWN || op > JOURNAL_ADD) return journalOpNames[JOURNAL_UNKNOWN];
+    return journalOpNames[op];
+}
+
+uint32_t journalChecksum(const char* data, size_t length){
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i){
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// the svg as it is now, for the records made for it
+bool journalBaseOf(const char* fileName, JournalBase* base){
+
+    if (fileName == NULL || base == NULL) return false;
+
+    struct stat fileStat;
+    if (stat(fileName, &fileStat) != 0) return false;
+
+    base->device = (uint64_t)fileStat.st_dev;
+    base->inode = (uint64_t)fileStat.st_ino;
+    base->size = (int64_t)fileStat.st_size;
+    base->modified = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+    return true;
+}
+
+bool sameJournalBase(const JournalBase* first, const JournalBase* second){
+
+    return first->device == second->device && first->inode == second->inode &&
+           first->size == second->size && first->modified == second->modified;
+}
+
+/*
+    appends every edit of a JSON array (the format of applyJSONEdits) to the journal of the file, as one write
+    the edits must already have been checked, by applying them to the svg and validating it
+    @return false if an edit is not an object with a known op, or the records cannot be written, the journal is
+    then left as it was
+*/
+bool appendJournal(const char* fileName, const char* edits, time_t now){
+
+    if (fileName == NULL || edits == NULL) return false;
+
+    // 1. the records are made for the svg as it is now
+    JournalBase base;
+    if (journalBaseOf(fileName, &base) == false) return false;
+
+    StringBuilder records;
+    if (initBuilder(&records, strlen(edits) + 64) == false) return false;
+
+    // 2. one record for every edit
+    bool valid = true;
+    const char* cursor = edits;
+    char* object;
+    while (valid && (object = nextJSONObject(&cursor)) != NULL){
+        char* opName = getJSONValue(object, "op");
+        JournalRecord record = {SVG_JOURNAL_MAGIC, (uint32_t)strlen(object), (int64_t)now, base,
+                                journalOpNamed(opName), journalChecksum(object, strlen(object))};
+
+        valid = (record.op != JOURNAL_UNKNOWN);
+        appendBytes(&records, (const char*)&record, sizeof(JournalRecord));
+        appendBytes(&records, object, record.length);
+
+        free(opName);
+        free(object);
+    }
+    valid = valid && cursor != NULL && *skipJSONSpaces(cursor) == ']' && records.failed == false;
+    if (valid && records.length == 0){
+        freeBuilder(&records);
+        return true;
+    }
+
+    // 3. write them after the last whole record, a record that was cut off by a crash or a short write would
+    // otherwise end the journal before them
+    long oldSize = (valid) ? journalValidLength(fileName) : 0;
+    char* name = (valid) ? journalName(fileName) : NULL;
+    FILE* file = (name == NULL) ? NULL : fopen(name, "ab");
+    if (file != NULL){
+        fseek(file, 0, SEEK_END);
+        if (oldSize >= 0 && ftell(file) != oldSize && ftruncate(fileno(file), oldSize) != 0) valid = false;
+
+        valid = valid && fwrite(records.data, 1, records.length, file) == records.length && fflush(file) == 0 && fsync(fileno(file)) == 0;
+        if (valid == false && oldSize >= 0 && ftruncate(fileno(file), oldSize) != 0) valid = false;
+
+        fclose(file);
+    }
+    else{
+        valid = false;
+    }
+
+    free(name);
+    freeBuilder(&records);
+    return valid;
+}
+
+/*
+    reads the next record of the journal
+    @return the edit, which the caller must free, or NULL at the end of the journal or at a record that is not whole
+*/
+char* readJournalRecord(FILE* file, JournalRecord* record){
+
+    if (file == NULL || record == NULL) return NULL;
+
+    if (fread(record, sizeof(JournalRecord), 1, file) != 1) return NULL;
+    if (record->magic != SVG_JOURNAL_MAGIC || record->length == 0 || record->length > SVG_JOURNAL_MAX_EDIT) return NULL;
+
+    char* edit = malloc(record->length + 1);
+    if (edit == NULL) return NULL;
+
+    if (fread(edit, 1, record->length, file) != record->length || journalChecksum(edit, record->length) != record->checksum){
+        free(edit);
+        return NULL;
+    }
+    edit[record->length] = '\0';
+
+    return edit;
+}
+
+// the bytes of the journal up to the end of its last whole record, 0 if it has none
+long journalValidLength(const char* fileName){
+
+    char* name = journalName(fileName);
+    FILE* file = (name == NULL) ? NULL : fopen(name, "rb");
+    free(name);
+    if (file == NULL) return 0;
+
+    long length = 0;
+    JournalRecord record;
+    char* edit;
+    while ((edit = readJournalRecord(file, &record)) != NULL){
+        length += sizeof(JournalRecord) + record.length;
+        free(edit);
+    }
+
+    fclose(file);
+    return length;
+}
+
+/*
+    applies the records of the journal of the file that were made for the svg as it is now
+    an edit that cannot be applied ends the journal like a broken record, the svg keeps the edits before it
+    @return the number of edits applied
+*/
+int replayJournal(SVG* img, const char* fileName){
+
+    if (img == NULL || fileName == NULL) return 0;
+
+    JournalBase base;
+    if (journalBaseOf(fileName, &base) == false) return 0;
+
+    char* name = journalName(fileName);
+    FILE* file = (name == NULL) ? NULL : fopen(name, "rb");
+    free(name);
+    if (file == NULL) return 0;
+
+    int applied = 0;
+    JournalRecord record;
+    char* edit;
+    while ((edit = readJournalRecord(file, &record)) != NULL){
+        // records from before the svg was last written are already in it
+        bool current = sameJournalBase(&record.base, &base);
+        bool done = (current) ? applyJSONEdit(img, edit) : true;
+        if (done && current) ++applied;
+
+        free(edit);
+        if (done == false) break;
+    }
+
+    fclose(file);
+    return applied;
+}
+
+// the time of the first record of the journal, or 0 if it has none
+time_t journalStarted(const char* fileName){
+
+    char* name = journalName(fileName);
+    FILE* file = (name == NULL) ? NULL : fopen(name, "rb");
+    free(name);
+    if (file == NULL) return 0;
+
+    JournalRecord record;
+    time_t started = (fread(&record, sizeof(JournalRecord), 1, file) == 1 && record.magic == SVG_JOURNAL_MAGIC) ? (time_t)record.time : 0;
+
+    fclose(file);
+    return started;
+}
+
+bool journalNeedsCompaction(const char* fileName, time_t now){
+
+    long size = journalSize(fileName);
+    if (size < 0) return false;
+    if (size >= SVG_JOURNAL_MAX_BYTES) return true;
+
+    time_t started = journalStarted(fileName);
+    return started != 0 && now - started >= SVG_JOURNAL_MAX_SECONDS;
+}
+
+/*
+    the records of the journal that apply to the svg as it is now, as a JSON array of
+    {"type":"attribute","time":1700000000,"edit":{...}}, the type, summary and date of the MODIFICATION table
+    @return "[]" if the file has no journal
+*/
+char* journalToJSON(const char* fileName){
+
+    if (fileName == NULL) return NULL;
+
+    JournalBase base;
+    if (journalBaseOf(fileName, &base) == false) return NULL;
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 256) == false) return NULL;
+    appendChar(&builder, '[');
+
+    char* name = journalName(fileName);
+    FILE* file = (name == NULL) ? NULL : fopen(name, "rb");
+    free(name);
+
+    if (file != NULL){
+        bool first = true;
+        JournalRecord record;
+        char* edit;
+        while ((edit = readJournalRecord(file, &record)) != NULL){
+            if (sameJournalBase(&record.base, &base)){
+                appendFormat(&builder, "%s{\"type\":\"%s\",\"time\":%lld,\"edit\":", (first) ? "" : ",", journalOpName(record.op), (long long)record.time);
+                appendString(&builder, edit); // the edit was read from the server as JSON, and checked before it was written
+                appendChar(&builder, '}');
+                first = false;
+            }
+            free(edit);
+        }
+        fclose(file);
+    }
+
+    appendChar(&builder, ']');
+    return finishBuilder(&builder);
+}
@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <math.h>
 #include <libxml/parser.h>
@@ -9,6 +10,12 @@
 
 #include "SVGHelper.h"
 #include "SVGParser.h"
+#include "SVGStringBuilder.h"
+#include "SVGCompress.h"
+#include "SVGShapes.h"
+#include "SVGSpatial.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
 
 void dummyDeleteRectangle(void* data){}
 void dummyDeleteCircle(void* data){}
@@ -25,7 +32,7 @@ SVG* createSVG(const char* filename){
     xmlNode *root_element = NULL;
     int valid = 0;
 
-    doc = xmlReadFile(filename, NULL, 0); // parse the file and get the DOM
+    doc = readSVGFile(filename); // parse the file and get the DOM, decompressing .svgz files
     if (doc == NULL){
         return NULL;
     }
@@ -61,6 +68,16 @@ SVG* createSVG(const char* filename){
     svg->paths = initializeList(&pathToString, &deletePath, &comparePaths);
     svg->groups = initializeList(&groupToString, &deleteGroup, &compareGroups);
     svg->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    svg->otherElements = initializeList(&rawElementToString, &deleteRawElement, &compareRawElements);
+    svg->lines = initShapeList(LINE);
+    svg->ellipses = initShapeList(ELLIPSE);
+    svg->polylines = initShapeList(POLYLINE);
+    svg->polygons = initShapeList(POLYGON);
+    svg->version = 0;
+    svg->spatial = NULL;
+    svg->boundsVersion = 0;
+    svg->areas = NULL;
+    svg->pathCounts = NULL;
 
     valid = getElementNames(root_element, svg); // root node of the tree, the svg we want to traverse
     if (valid == 0){
@@ -79,44 +96,14 @@ SVG* createSVG(const char* filename){
 
 char* SVGToString(const SVG* img){
 
-    char* tmpStr;
-    SVG* tmp;
-    int len;
-
     if (img == NULL){
         return NULL;
     }
 
-    tmp = (SVG*)img;
-
-    char* namespace = tmp->namespace;
-    char* title = tmp->title;
-    char* description = tmp->description;
-    char* rectList = toString(tmp->rectangles);
-    char* circList = toString(tmp->circles);
-    char* pathList = toString(tmp->paths);
-    char* groupList = toString(tmp->groups);
-    char* attrList = toString(tmp->otherAttributes);
-
-    len = strlen(namespace) + strlen(title) + strlen(description) + strlen(rectList) + strlen(circList) + strlen(pathList) + strlen(groupList) + strlen(attrList) + 9 + 24; // 8 '\n', \0
-    tmpStr = (char*) malloc(sizeof(char) * len);
-    if (tmpStr == NULL){
-        free(rectList);
-        free(circList);
-        free(pathList);
-        free(groupList);
-        free(attrList);
-        return NULL;
-    }
-    sprintf(tmpStr, "N: %s\nT: %s\nD: %s\nR: %s\nC: %s\nP: %s\nG: %s\nA: %s\n", namespace, title, description, rectList, circList, pathList, groupList, attrList);
-
-    free(rectList);
-    free(circList);
-    free(pathList);
-    free(groupList);
-    free(attrList);
-
-    return tmpStr;
+    StringBuilder builder;
+    if (initBuilder(&builder, 1024) == false) return NULL;
+    appendSVGString(&builder, img);
+    return finishBuilder(&builder);
 
 }
 
@@ -128,6 +115,14 @@ void deleteSVG(SVG* img){
     if (img->paths != NULL) freeList(img->paths);
     if (img->groups != NULL) freeList(img->groups);
     if (img->otherAttributes != NULL) freeList(img->otherAttributes);
+    if (img->otherElements != NULL) freeList(img->otherElements);
+    if (img->lines != NULL) freeList(img->lines);
+    if (img->ellipses != NULL) freeList(img->ellipses);
+    if (img->polylines != NULL) freeList(img->polylines);
+    if (img->polygons != NULL) freeList(img->polygons);
+    if (img->spatial != NULL) deleteSpatialIndex(img->spatial);
+    if (img->areas != NULL) deleteAreaIndex(img->areas);
+    if (img->pathCounts != NULL) deletePathCounts(img->pathCounts);
     if (img != NULL) free(img);
 
 }
@@ -146,29 +141,43 @@ void deleteAttribute( void* data){
 
 char* attributeToString( void* data){
 
-    char* tmpStr;
-    Attribute* tmp;
-    int len;
-
     if (data == NULL){
         return NULL;
     }
 
-    tmp = (Attribute*)data;
+    StringBuilder builder;
+    if (initBuilder(&builder, 64) == false) return NULL;
+    appendAttributeString(&builder, (Attribute*)data);
+    return finishBuilder(&builder);
+}
+
+int compareAttributes(const void *first, const void *second){ return 0; }
 
-    len = strlen(tmp->name) + strlen(tmp->value) + 7; // 7 for the ", ' ', =, \n, \0
+void deleteRawElement(void* data){
 
-    tmpStr = (char*) malloc(sizeof(char) * len);
-    if (tmpStr == NULL){
-        return NULL;
+    if (data == NULL){
+        return;
     }
+    free(data);
+
+}
 
-    sprintf(tmpStr, "%s = \"%s\"\n", tmp->name, tmp->value);
+char* rawElementToString(void* data){
 
-    return tmpStr;
+    if (data == NULL){
+        return NULL;
+    }
+
+    RawElement* raw = (RawElement*)data;
+    char* string = malloc(raw->length + 1);
+    if (string == NULL){
+        return NULL;
+    }
+    memcpy(string, raw->xml, raw->length + 1);
+    return string;
 }
 
-int compareAttributes(const void *first, const void *second){ return 0; }
+int compareRawElements(const void *first, const void *second){ return 0; }
 
 void deleteGroup(void* data){
 
@@ -183,42 +192,25 @@ void deleteGroup(void* data){
     if (tmp->paths != NULL) freeList(tmp->paths);
     if (tmp->groups != NULL) freeList(tmp->groups);
     if (tmp->otherAttributes != NULL) freeList(tmp->otherAttributes);
+    if (tmp->otherElements != NULL) freeList(tmp->otherElements);
+    if (tmp->lines != NULL) freeList(tmp->lines);
+    if (tmp->ellipses != NULL) freeList(tmp->ellipses);
+    if (tmp->polylines != NULL) freeList(tmp->polylines);
+    if (tmp->polygons != NULL) freeList(tmp->polygons);
     if (tmp != NULL) free(tmp);
 
 }
 
 char* groupToString( void* data){
 
-    char* tmpStr;
-    Group* tmp;
-    int len;
-
     if (data == NULL){
         return NULL;
     }
 
-    tmp = (Group*)data;
-
-    char* rectList = toString(tmp->rectangles);
-    char* circList = toString(tmp->circles);
-    char* pathList = toString(tmp->paths);
-    char* groupList = toString(tmp->groups);
-    char* attrList = toString(tmp->otherAttributes);
-
-    len = strlen(rectList) + strlen(circList) + strlen(pathList) + strlen(groupList) + strlen(attrList) + 72; // '\n', \0
-    tmpStr = (char*) malloc(sizeof(char) * len);
-    if (tmpStr == NULL){
-        return NULL;
-    }
-    sprintf(tmpStr, "Rectangles:\n(%s)\nCircles:\n(%s)\nPaths:\n(%s)\nSubgroups:\n(%s)\nOtherAttributes:\n(%s)\n", rectList, circList, pathList, groupList, attrList);
-
-    free(rectList);
-    free(circList);
-    free(pathList);
-    free(groupList);
-    free(attrList);
-
-    return tmpStr;
+    StringBuilder builder;
+    if (initBuilder(&builder, 256) == false) return NULL;
+    appendGroupString(&builder, (Group*)data);
+    return finishBuilder(&builder);
 
 }
 
@@ -240,29 +232,14 @@ void deleteRectangle(void* data){
 
 char* rectangleToString(void* data){
 
-    char* tmpStr;
-    Rectangle* tmp;
-    int len;
-
     if (data == NULL){
         return NULL;
     }
 
-    tmp = (Rectangle*)data;
-
-    char* attrList = toString(tmp->otherAttributes);
-
-    // 4 floats (35 characters each * 4 = 140) + 50 char + (6 * 5 = 30) + 1 newline + 1 null = 222 + list attributes
-    len = 222 + strlen(attrList);
-
-    tmpStr = (char*) malloc(sizeof(char) * len);
-    if (tmpStr == NULL){
-        return NULL;
-    }
-    sprintf(tmpStr, "x = \"%f\"\ny = \"%f\"\nwidth = \"%f\"\nheight = \"%f\"\nunits = \"%s\"\n%s\n", tmp->x, tmp->y, tmp->width, tmp->height, tmp->units, attrList);
-
-    free(attrList);
-    return tmpStr;
+    StringBuilder builder;
+    if (initBuilder(&builder, 256) == false) return NULL;
+    appendRectangleString(&builder, (Rectangle*)data);
+    return finishBuilder(&builder);
 
 }
 
@@ -283,74 +260,132 @@ void deleteCircle(void* data){
 
 char* circleToString(void* data){
 
-    char* tmpStr;
-    Circle* tmp;
-    int len;
-
     if (data == NULL){
         return NULL;
     }
 
-    tmp = (Circle*)data;
+    StringBuilder builder;
+    if (initBuilder(&builder, 256) == false) return NULL;
+    appendCircleString(&builder, (Circle*)data);
+    return finishBuilder(&builder);
 
-    char* attrList = toString(tmp->otherAttributes);
+}
+
+int compareCircles(const void *first, const void *second){ return 0; }
 
-    // 3 floats (35 characters each * 3 = 105) + 50 char + (6 * 4 = 24) + 4 = 181 + list attributes
-    len = 183 + strlen(attrList);
+void deletePath(void* data){
 
-    tmpStr = (char*) malloc(sizeof(char) * len);
-    if (tmpStr == NULL){
+    Path* tmp;
+    if (data == NULL){
+        return;
+    }
+    tmp = (Path*)data;
+    if (tmp->otherAttributes != NULL) freeList (tmp->otherAttributes);
+    free(tmp->parsed);
+    releasePathData(tmp->data);
+    free(tmp);
+
+}
+
+char* pathToString(void* data){
+
+    if (data == NULL){
         return NULL;
     }
-    sprintf(tmpStr, "cx = \"%f\"\ncy = \"%f\"\nr = \"%f\"\nunits = \"%s\"\n%s\n", tmp->cx, tmp->cy, tmp->r, tmp->units, attrList);
 
-    free(attrList);
-    return tmpStr;
+    StringBuilder builder;
+    if (initBuilder(&builder, 64) == false) return NULL;
+    appendPathString(&builder, (Path*)data);
+    return finishBuilder(&builder);
 
 }
 
-int compareCircles(const void *first, const void *second){ return 0; }
+int comparePaths(const void *first, const void *second){ return 0; }
 
-void deletePath(void* data){
+void deleteLine(void* data){
 
-    Path* tmp;
+    Line* tmp;
     if (data == NULL){
         return;
     }
-    tmp = (Path*)data;
+    tmp = (Line*)data;
+
     if (tmp->otherAttributes != NULL) freeList (tmp->otherAttributes);
     free(tmp);
 
 }
 
-char* pathToString(void* data){
+char* lineToString(void* data){
 
-    char* tmpStr;
-    Path* tmp;
-    int len;
+    if (data == NULL){
+        return NULL;
+    }
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 256) == false) return NULL;
+    appendLineString(&builder, (Line*)data);
+    return finishBuilder(&builder);
+
+}
+
+int compareLines(const void *first, const void *second){ return 0; }
+
+void deleteEllipse(void* data){
+
+    Ellipse* tmp;
+    if (data == NULL){
+        return;
+    }
+    tmp = (Ellipse*)data;
+
+    if (tmp->otherAttributes != NULL) freeList (tmp->otherAttributes);
+    free(tmp);
+
+}
+
+char* ellipseToString(void* data){
 
     if (data == NULL){
         return NULL;
     }
 
-    tmp = (Path*)data;
+    StringBuilder builder;
+    if (initBuilder(&builder, 256) == false) return NULL;
+    appendEllipseString(&builder, (Ellipse*)data);
+    return finishBuilder(&builder);
+
+}
+
+int compareEllipses(const void *first, const void *second){ return 0; }
+
+// used for both polylines and polygons, the points are in the same allocation as the struct
+void deletePolyline(void* data){
+
+    Polyline* tmp;
+    if (data == NULL){
+        return;
+    }
+    tmp = (Polyline*)data;
+
+    if (tmp->otherAttributes != NULL) freeList (tmp->otherAttributes);
+    free(tmp);
 
-    char* attrList = toString(tmp->otherAttributes);
+}
 
-    len = strlen(tmp->data) + strlen(attrList) + 9; // 7 for the ", ' ', =, \n, \0
+char* polylineToString(void* data){
 
-    tmpStr = (char*) malloc(sizeof(char) * len);
-    if (tmpStr == NULL){
+    if (data == NULL){
         return NULL;
     }
-    sprintf(tmpStr, "d = \"%s\"\n%s\n", tmp->data, attrList);
 
-    free(attrList);
-    return tmpStr;
+    StringBuilder builder;
+    if (initBuilder(&builder, 64) == false) return NULL;
+    appendPolylineString(&builder, (Polyline*)data);
+    return finishBuilder(&builder);
 
 }
 
-int comparePaths(const void *first, const void *second){ return 0; }
+int comparePolylines(const void *first, const void *second){ return 0; }
 
 /**
  * The get functions have similar format. They:
@@ -439,6 +474,31 @@ List* getGroups(const SVG* img){ // again with these groups smh
 
 }
 
+// the lines, ellipses, polylines and polygons lists may be NULL in the structs, getShapes takes them as empty
+List* getLines(const SVG* img){
+
+    return getShapes(img, LINE);
+
+}
+
+List* getEllipses(const SVG* img){
+
+    return getShapes(img, ELLIPSE);
+
+}
+
+List* getPolylines(const SVG* img){
+
+    return getShapes(img, POLYLINE);
+
+}
+
+List* getPolygons(const SVG* img){
+
+    return getShapes(img, POLYGON);
+
+}
+
 /**
  * The summaries functions have similar format. They:
  * 1. traverse shape list in img to compare with the search value
@@ -450,7 +510,10 @@ int numRectsWithArea(const SVG* img, float area){
 
     if (img == NULL) return 0;
 
-    int count = 0;
+    // one lookup in the area histogram kept in the svg, the shapes are counted one by one when it is not up to date
+    int count = countShapesWithArea(img, RECT, area);
+    if (count >= 0) return count;
+
     int areaR = (int)(ceil(area));
     count = findNumShape(img->rectangles, &compareRectAreas, &areaR);
     count += compareInGroups(img->groups, &compareRectAreas, &areaR, "rect");
@@ -461,7 +524,9 @@ int numCirclesWithArea(const SVG* img, float area){
 
     if (img == NULL) return 0;
 
-    int count = 0;
+    int count = countShapesWithArea(img, CIRC, area);
+    if (count >= 0) return count;
+
     int areaC = (int)(ceil(area));
     count = findNumShape(img->circles, &compareCircAreas, &areaC);
     count += compareInGroups(img->groups, &compareCircAreas, &areaC, "circ");
@@ -470,9 +535,12 @@ int numCirclesWithArea(const SVG* img, float area){
 
 int numPathsWithdata(const SVG* img, const char* data){
 
-    if (img == NULL) return 0;
+    if (img == NULL || data == NULL) return 0;
+
+    // one lookup in the path counts kept in the svg, the paths are compared one by one when they are not up to date
+    int count = countPathsWithData(img, data);
+    if (count >= 0) return count;
 
-    int count = 0;
     count = findNumShape(img->paths, &comparePathData, data);
     count += compareInGroups(img->groups, &comparePathData, data, "path");
     return count;
@@ -504,6 +572,7 @@ int numAttr(const SVG* img){
     count += getRectAttrLen(img->rectangles);
     count += getCircAttrLen(img->circles);
     count += getPathAttrLen(img->paths);
+    count += getShapesAttrLen(img->lines, img->ellipses, img->polylines, img->polygons);
     count += getGroupAttrLen(img->groups);
     return count;
 
@@ -19,12 +19,24 @@
 #include "SVGParser.h"
 #include "SVGHelper.h"
 #include "SVGHelperA2.h"
+#include "SVGHelperJSON.h"
+#include "SVGStringBuilder.h"
+#include "SVGWriter.h"
+#include "SVGCompress.h"
+#include "SVGFormat.h"
+#include "SVGShapes.h"
+#include "SVGJournal.h"
+#include "SVGSpatial.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
+#include "SVGBounds.h"
 
 #define LIBXML_SCHEMAS_ENABLED
 
 /*
     createValidSVG first creates an xml tree, then validates the svg file against the schema file,
-    then calls create svg for the svg file to create an svg struct if the file is valid
+    then calls create svg for the svg file to create an svg struct if the file is valid,
+    and applies the edits in the journal of the file (see SVGJournal.h)
 */
 SVG* createValidSVG(const char* fileName, const char* schemaFile){
 
@@ -32,7 +44,7 @@ SVG* createValidSVG(const char* fileName, const char* schemaFile){
 
     // 1. parse the file and get the DOM
     xmlDocPtr doc = NULL;
-    doc = xmlReadFile(fileName, NULL, 0);
+    doc = readSVGFile(fileName);
     if (doc == NULL){
         xmlCleanupParser(); // free global variables allocated by parser in the validateFileSVG() function
         return NULL;
@@ -55,32 +67,46 @@ SVG* createValidSVG(const char* fileName, const char* schemaFile){
         return NULL;
     }
 
+    // 4. the edits that were appended to the journal instead of written to the file
+    replayJournal(svg, fileName);
+
     return svg;
 }
 
 /*
     writes an svg struct to a file in the svg format
+    the struct is streamed straight to the file through a buffered writer, no xmlDoc is built
     assumes that the struct has been validated!
 */
 bool writeSVG(const SVG* img, const char* fileName){
 
-    if (img == NULL || fileName == NULL) return false;
+    return writeSVGWithOptions(img, fileName, getWriteOptions());
+}
 
-    // 1. create the xml doc from the svg
-    xmlDocPtr doc = createXMLFromStruct(img);
-    if (doc == NULL){
-        xmlCleanupParser();
+bool writeSVGWithOptions(const SVG* img, const char* fileName, SVGWriteOptions options){
+
+    if (img == NULL || fileName == NULL || validWriteOptions(options) == false) return false;
+
+    // 1. open the file, the writer holds the output buffer so it is not put on the stack
+    SVGWriter* writer = malloc(sizeof(SVGWriter));
+    if (writer == NULL) return false;
+    if (openWriter(writer, fileName) == false){
+        free(writer);
         return false;
     }
+    writer->options = options;
 
-    // 2. save contents to a file
-    xmlSaveFormatFileEnc(fileName, doc, "UTF-8", 1);
+    // 2. write the contents to the file
+    writeSVGStruct(writer, img);
 
-    // 3. free the document
-    xmlFreeDoc(doc);
-    xmlCleanupParser(); // free global variables allocated by parser in the createXMLFromStruct() function
+    // 3. flush and close the file
+    bool written = closeWriter(writer);
+    free(writer);
 
-    return true;
+    // the file has everything now, so a journal of older edits is not needed
+    if (written) removeJournal(fileName);
+
+    return written;
 }
 
 /*
@@ -117,6 +143,33 @@ bool validateSVG(const SVG* img, const char* schemaFile){
     return true;
 }
 
+/*
+    does validateSVG and writeSVG, the xml tree is built once while checking the structs and is only used to validate
+    against the schema, the file is then streamed from the structs by writeSVG so one writer makes all the files
+*/
+bool validateAndWriteSVG(const SVG* img, const char* schemaFile, const char* fileName){
+
+    if (img == NULL || schemaFile == NULL || fileName == NULL) return false;
+
+    // 1. convert the svg to an xml doc, checking the structs against the svgparser.h specifications on the way
+    bool valid = true;
+    xmlDocPtr doc = createXMLFromStructChecked(img, &valid);
+    if (doc == NULL){
+        xmlCleanupParser();
+        return false;
+    }
+
+    // 2. validate the xml doc against the schema
+    if (valid) valid = validateFileSVG(doc, schemaFile);
+
+    xmlFreeDoc(doc);
+    xmlCleanupParser(); // free global variables allocated by parser in the createXMLFromStruct() and validateFileSVG() functions
+
+    // 3. write the file from the structs, which removes the journal too
+    if (valid == false) return false;
+    return writeSVG(img, fileName);
+}
+
 bool setAttribute(SVG* img, elementType elemType, int elemIndex, Attribute* newAttribute){
 
     if (img == NULL || newAttribute == NULL) return false;
@@ -124,40 +177,45 @@ bool setAttribute(SVG* img, elementType elemType, int elemIndex, Attribute* newA
     // 1. valid attribute strings
     if ((validChar(newAttribute->name) == 0) || (strcmp(newAttribute->name, "") == 0) || (validChar(newAttribute->value) == 0) || (strcmp(newAttribute->value, "") == 0)) return false;
 
+    // a rectangle or circle that is resized is moved to its new area in the area histogram, and a path whose data is set
+    // to its new data in the path counts
+    List* changedList = (elemType == RECT || elemType == CIRC || elemType == PATH) ? svgComponentList(img, elemType) : NULL;
+    void* changed = (changedList != NULL && elemIndex >= 0 && elemIndex < getLength(changedList)) ? getElementAt(changedList, elemIndex) : NULL;
+    AreaChange areaChange;
+    PathChange pathChange;
+    beginAreaChange(img, elemType, changed, &areaChange);
+    beginPathChange(img, elemType, changed, &pathChange);
+    if (geometryAttribute(newAttribute->name)) touchSVG(img); // the attribute may be freed below
+
     // 2. check the type
+    bool valid = false;
     if (elemType == SVG_IMG){
-        bool valid = changeValueInAttr(img->otherAttributes, newAttribute);
-        if (valid == false) return false;
+        valid = changeValueInAttr(img->otherAttributes, newAttribute);
     }
     else if (elemType == RECT){
         // 3. check if index is out of bounds
-        if (getLength(img->rectangles) <= elemIndex) return false;
         // 4. separate function for changing value in order to check for validity of the new attribute
         //    the functions are in charge of freeing the newAttribute attribute depending on whether it was appended or not
-        bool valid = changeValueInRect(img->rectangles, elemIndex, newAttribute);
-        if (valid == false) return false;
-
+        if (getLength(img->rectangles) > elemIndex) valid = changeValueInRect(img->rectangles, elemIndex, newAttribute);
     }
     else if (elemType == CIRC){
-        if (getLength(img->circles) <= elemIndex) return false;
-        bool valid = changeValueInCirc(img->circles, elemIndex, newAttribute);
-        if (valid == false) return false;
+        if (getLength(img->circles) > elemIndex) valid = changeValueInCirc(img->circles, elemIndex, newAttribute);
     }
     else if (elemType == PATH){
-        if (getLength(img->paths) <= elemIndex) return false;
-        bool valid = changeValueInPath(img->paths, elemIndex, newAttribute);
-        if (valid == false) return false;
+        if (getLength(img->paths) > elemIndex) valid = changeValueInPath(img->paths, elemIndex, newAttribute);
     }
     else if (elemType == GROUP){
-        if (getLength(img->groups) <= elemIndex) return false;
-        bool valid = changeValueInGroup(img->groups, elemIndex, newAttribute);
-        if (valid == false) return false;
+        if (getLength(img->groups) > elemIndex) valid = changeValueInGroup(img->groups, elemIndex, newAttribute);
     }
-    else{ // not the appropriate element
-        return false;
+    else if (elemType == LINE || elemType == ELLIPSE || elemType == POLYLINE || elemType == POLYGON){
+        List* list = *svgShapeList(img, elemType);
+        if (list != NULL && getLength(list) > elemIndex) valid = changeValueInShape(list, elemType, elemIndex, newAttribute);
     }
+    // otherwise not the appropriate element
 
-    return true;
+    endAreaChange(&areaChange);
+    endPathChange(&pathChange);
+    return valid;
 
 }
 
@@ -198,7 +256,19 @@ void addComponent(SVG* img, elementType type, void* newElement){
         }
         insertBack(img->paths, (void*)newPath);
     }
+    else if (type == LINE || type == ELLIPSE || type == POLYLINE || type == POLYGON){
+        if (validShapeStruct(newElement, type) == false) return;
+        // the list is created when the svg has none of the type yet
+        List** list = svgShapeList(img, type);
+        if (*list == NULL) *list = initShapeList(type);
+        insertBack(*list, newElement);
+    }
+    else{
+        return;
+    }
 
+    // 4. the element was added, the index of the shapes takes it without being made again
+    shapeAdded(img, NULL, type, newElement);
 }
 
 char* attrToJSON(const Attribute *a){ // const means it cannot be changed and it is safe to use
@@ -211,10 +281,15 @@ char* attrToJSON(const Attribute *a){ // const means it cannot be changed and it
     }
 
     // assuming that these attributes are validated using the validate svg function and that they are not NULL and are initialized
-    char* attrString = malloc(strlen(a->name) + strlen(a->value) + 31); // 31 characters for words, quotes, commas, semicolons, \0
-    if (attrString == NULL) return NULL; // cannot allocate string
-    sprintf(attrString, "{\"name\":\"%s\",\"value\":\"%s\"}", a->name, a->value);
-    return attrString;
+    // the name and value are escaped, so quotes and backslashes in values like style do not break the JSON
+    StringBuilder builder;
+    if (initBuilder(&builder, strlen(a->name) + strlen(a->value) + 31) == false) return NULL; // 31 characters for words, quotes, commas, semicolons, \0
+    appendString(&builder, "{\"name\":\"");
+    appendJSONString(&builder, a->name);
+    appendString(&builder, "\",\"value\":\"");
+    appendJSONString(&builder, a->value);
+    appendString(&builder, "\"}");
+    return finishBuilder(&builder);
 
 }
 
@@ -228,10 +303,12 @@ char* circleToJSON(const Circle *c){
     }
 
     // 3 floats, 35 characters each, 1 int, 10 characters, 41 characters for words, quotes, commas, semicolons, \0
-    char* circString = malloc(strlen(c->units) + 156);
-    if (circString == NULL) return NULL; // cannot allocate string
-    sprintf(circString, "{\"cx\":%.2f,\"cy\":%.2f,\"r\":%.2f,\"numAttr\":%d,\"units\":\"%s\"}", c->cx, c->cy, c->r, getLength(c->otherAttributes), c->units);
-    return circString;
+    StringBuilder builder;
+    if (initBuilder(&builder, strlen(c->units) + 156) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"cx\":%.2f,\"cy\":%.2f,\"r\":%.2f,\"numAttr\":%d,\"units\":\"", c->cx, c->cy, c->r, getLength(c->otherAttributes));
+    appendJSONString(&builder, c->units);
+    appendString(&builder, "\"}");
+    return finishBuilder(&builder);
 
 }
 
@@ -245,10 +322,12 @@ char* rectToJSON(const Rectangle *r){
     }
 
     // 4 floats, 35 characters each, 1 int, 10 characters, 44 characters for words, quotes, commas, semicolons, \0
-    char* rectString = malloc(strlen(r->units) + 194);
-    if (rectString == NULL) return NULL; // cannot allocate string
-    sprintf(rectString, "{\"x\":%.2f,\"y\":%.2f,\"w\":%.2f,\"h\":%.2f,\"numAttr\":%d,\"units\":\"%s\"}", r->x, r->y, r->width, r->height, getLength(r->otherAttributes), r->units);
-    return rectString;
+    StringBuilder builder;
+    if (initBuilder(&builder, strlen(r->units) + 194) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"x\":%.2f,\"y\":%.2f,\"w\":%.2f,\"h\":%.2f,\"numAttr\":%d,\"units\":\"", r->x, r->y, r->width, r->height, getLength(r->otherAttributes));
+    appendJSONString(&builder, r->units);
+    appendString(&builder, "\"}");
+    return finishBuilder(&builder);
 
 
 }
@@ -263,11 +342,13 @@ char* pathToJSON(const Path *p){
     }
 
     // 1 int, 10 characters, 21 characters for words, quotes, commas, semicolons, \0
-    char* pathString = malloc(strlen(p->data) + 31);
-    if (pathString == NULL) return NULL; // cannot allocate string
-    sprintf(pathString, "{\"d\":\"%.64s\",\"numAttr\":%d}", p->data, getLength(p->otherAttributes));
-
-    return pathString;
+    // the whole path data is exported, escaped, the clean spans between escapes are copied with memcpy
+    StringBuilder builder;
+    if (initBuilder(&builder, strlen(p->data) + 31) == false) return NULL; // cannot allocate string
+    appendString(&builder, "{\"d\":\"");
+    appendJSONString(&builder, p->data);
+    appendFormat(&builder, "\",\"numAttr\":%d}", getLength(p->otherAttributes));
+    return finishBuilder(&builder);
 
 }
 
@@ -280,11 +361,78 @@ char* groupToJSON(const Group *g){
         return groupString;
     }
 
-    // 2 int, 10 characters, 25 characters for words, quotes, commas, semicolons, \0
-    char* groupString = malloc(20 + 25);
-    if (groupString == NULL) return NULL; // cannot allocate string
-    sprintf(groupString, "{\"children\":%d,\"numAttr\":%d}", (getLength(g->rectangles) + getLength(g->circles) + getLength(g->paths) + getLength(g->groups)), getLength(g->otherAttributes));
-    return groupString;
+    // the group does not know the version of its svg, so the box it keeps may be out of date and is found again
+    Bounds bounds;
+    findGroupBounds(g, &bounds);
+
+    // 2 int, 10 characters, 4 floats, 35 characters each, 60 characters for words, quotes, commas, semicolons, \0
+    StringBuilder builder;
+    if (initBuilder(&builder, 20 + 140 + 60) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"children\":%d,\"numAttr\":%d,\"bounds\":", numGroupChildren(g), getLength(g->otherAttributes));
+    appendBoundsJSON(&builder, &bounds);
+    appendChar(&builder, '}');
+    return finishBuilder(&builder);
+
+}
+
+char* lineToJSON(const Line *l){
+
+    if (l == NULL){
+        char* lineString = malloc(strlen("{}") + 1);
+        if (lineString == NULL) return NULL; // cannot allocate string
+        sprintf(lineString, "{}");
+        return lineString;
+    }
+
+    // 4 floats, 35 characters each, 1 int, 10 characters, 47 characters for words, quotes, commas, semicolons, \0
+    StringBuilder builder;
+    if (initBuilder(&builder, strlen(l->units) + 197) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"x1\":%.2f,\"y1\":%.2f,\"x2\":%.2f,\"y2\":%.2f,\"numAttr\":%d,\"units\":\"", l->x1, l->y1, l->x2, l->y2, getLength(l->otherAttributes));
+    appendJSONString(&builder, l->units);
+    appendString(&builder, "\"}");
+    return finishBuilder(&builder);
+
+}
+
+char* ellipseToJSON(const Ellipse *e){
+
+    if (e == NULL){
+        char* ellipseString = malloc(strlen("{}") + 1);
+        if (ellipseString == NULL) return NULL; // cannot allocate string
+        sprintf(ellipseString, "{}");
+        return ellipseString;
+    }
+
+    // 4 floats, 35 characters each, 1 int, 10 characters, 47 characters for words, quotes, commas, semicolons, \0
+    StringBuilder builder;
+    if (initBuilder(&builder, strlen(e->units) + 197) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"cx\":%.2f,\"cy\":%.2f,\"rx\":%.2f,\"ry\":%.2f,\"numAttr\":%d,\"units\":\"", e->cx, e->cy, e->rx, e->ry, getLength(e->otherAttributes));
+    appendJSONString(&builder, e->units);
+    appendString(&builder, "\"}");
+    return finishBuilder(&builder);
+
+}
+
+// used for both polylines and polygons
+char* polylineToJSON(const Polyline *p){
+
+    if (p == NULL){
+        char* polyString = malloc(strlen("{}") + 1);
+        if (polyString == NULL) return NULL; // cannot allocate string
+        sprintf(polyString, "{}");
+        return polyString;
+    }
+
+    // 1 float, 36 characters with the comma, for each number, 2 int, 10 characters, 39 characters for words, quotes, commas, semicolons, \0
+    StringBuilder builder;
+    if (initBuilder(&builder, 36 * 2 * p->numPoints + 59) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"numPoints\":%d,\"points\":[", p->numPoints);
+    for (int i = 0; i < 2 * p->numPoints; ++i){
+        if (i > 0) appendChar(&builder, ',');
+        appendFormat(&builder, "%.2f", p->points[i]);
+    }
+    appendFormat(&builder, "],\"numAttr\":%d}", getLength(p->otherAttributes));
+    return finishBuilder(&builder);
 
 }
 
@@ -329,12 +477,28 @@ char* SVGtoJSON(const SVG* img){
     int numGroups = getLength(groupList);
     freeList(groupList);
 
-    // 4 int, 10 characters, 49 characters for words, quotes, commas, semicolons, \0
-    char* svgString = malloc(40 + 49);
-    if (svgString == NULL) return NULL; // cannot allocate string
-    sprintf(svgString, "{\"numRect\":%d,\"numCirc\":%d,\"numPaths\":%d,\"numGroups\":%d}", numRect, numCirc, numPaths, numGroups);
+    // the lines, ellipses, polylines and polygons, getShapes does not fail for a NULL list
+    int numShapes[4] = {0, 0, 0, 0};
+    elementType shapeTypes[4] = { LINE, ELLIPSE, POLYLINE, POLYGON };
+    for (int i = 0; i < 4; ++i){
+        List* shapeList = getShapes(img, shapeTypes[i]);
+        if (shapeList == NULL) return NULL;
+        numShapes[i] = getLength(shapeList);
+        freeList(shapeList);
+    }
 
-    return svgString;
+    Bounds bounds;
+    findSVGBounds(img, &bounds);
+
+    // 8 int, 10 characters, 4 floats, 35 characters each, 125 characters for words, quotes, commas, semicolons, \0
+    StringBuilder builder;
+    if (initBuilder(&builder, 80 + 140 + 125) == false) return NULL; // cannot allocate string
+    appendFormat(&builder, "{\"numRect\":%d,\"numCirc\":%d,\"numPaths\":%d,\"numGroups\":%d,\"numLines\":%d,\"numEllipses\":%d,\"numPolylines\":%d,\"numPolygons\":%d,\"bounds\":",
+            numRect, numCirc, numPaths, numGroups, numShapes[0], numShapes[1], numShapes[2], numShapes[3]);
+    appendBoundsJSON(&builder, &bounds);
+    appendChar(&builder, '}');
+
+    return finishBuilder(&builder);
 
 }
 
@@ -638,6 +802,70 @@ char* groupListToJSON(const List *list){
 
 }
 
+char* lineListToJSON(const List *list){
+
+    return shapeListToJSON(list, LINE);
+
+}
+
+char* ellipseListToJSON(const List *list){
+
+    return shapeListToJSON(list, ELLIPSE);
+
+}
+
+// used for both polylines and polygons
+char* polylineListToJSON(const List *list){
+
+    return shapeListToJSON(list, POLYLINE);
+
+}
+
+/*
+    converts part of a shape list into a JSON object of the format
+    {"total":numInList,"offset":offset,"items":[...]}
+    with at most limit items starting at offset, the items are in the same format as the ...ListToJSON functions
+    the items are found through getElementAt, so only the page that is returned is converted
+*/
+char* listToJSONRange(const List *list, elementType type, int offset, int limit){
+
+    List* shapeList = (List *) list;
+    int total = (list == NULL) ? 0 : getLength(shapeList);
+    if (offset < 0) offset = 0;
+    if (limit < 0) limit = 0;
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 64 + 64 * (limit < total ? limit : total)) == false) return NULL;
+    appendFormat(&builder, "{\"total\":%d,\"offset\":%d,\"items\":[", total, offset);
+
+    // 1. convert each element of the page
+    for (int i = offset; (i < total) && (i - offset < limit); ++i){
+
+        void* elem = getElementAt(shapeList, i);
+        char* currElem = NULL;
+        if (type == RECT) currElem = rectToJSON((Rectangle*)elem);
+        else if (type == CIRC) currElem = circleToJSON((Circle*)elem);
+        else if (type == PATH) currElem = pathToJSON((Path*)elem);
+        else if (type == GROUP) currElem = groupToJSON((Group*)elem);
+        else currElem = shapeToJSON(elem, type);
+        if (currElem == NULL){
+            freeBuilder(&builder);
+            return NULL; // cannot allocate string, or not a shape type
+        }
+
+        // 2. add the element string and the comma
+        if (i > offset) appendChar(&builder, ',');
+        appendString(&builder, currElem);
+        free(currElem);
+    }
+
+    // 3. add the ending brackets
+    appendString(&builder, "]}");
+
+    return finishBuilder(&builder);
+
+}
+
 SVG* JSONtoSVG(const char* svgString){
 
     if (svgString == NULL) return NULL;
@@ -649,7 +877,7 @@ SVG* JSONtoSVG(const char* svgString){
     // 2. parse the string given and add/initialize the values for the struct
     char* tempSVGString = malloc(strlen(svgString) + 1); // temp string since strtok is destrutive
     if (tempSVGString == NULL){
-        deleteSVG(svg);
+        free(svg); // none of its lists are made yet
         return NULL; // cannot allocate string
     }
     strcpy(tempSVGString, svgString);
@@ -683,6 +911,16 @@ SVG* JSONtoSVG(const char* svgString){
     svg->paths = initializeList(&pathToString, &deletePath, &comparePaths);
     svg->groups = initializeList(&groupToString, &deleteGroup, &compareGroups);
     svg->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    svg->otherElements = initializeList(&rawElementToString, &deleteRawElement, &compareRawElements);
+    svg->lines = initShapeList(LINE);
+    svg->ellipses = initShapeList(ELLIPSE);
+    svg->polylines = initShapeList(POLYLINE);
+    svg->polygons = initShapeList(POLYGON);
+    svg->version = 0;
+    svg->spatial = NULL;
+    svg->boundsVersion = 0;
+    svg->areas = NULL;
+    svg->pathCounts = NULL;
 
     free(tempSVGString);
 
@@ -861,3 +1099,39 @@ Circle* JSONtoCircle(const char* svgString){
     return circ;
 
 }
+
+Path* JSONtoPath(const char* svgString){
+
+    if (svgString == NULL) return NULL;
+
+    // based on format: {"d":"dataStr"}, the path data may contain any characters so it is read by its key
+
+    // 1. get the path data
+    char* data = getJSONValue(svgString, "d");
+    if (data == NULL) return NULL; // path data must not be NULL
+
+    // 2. create path struct with the data of the store
+    Path* path = (Path*) (malloc(sizeof(Path)));
+    if (path == NULL){
+        free(data);
+        return NULL;
+    }
+    path->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    path->parsed = NULL;
+    path->data = storePathData(data);
+    free(data);
+    if (path->data == NULL){
+        deletePath(path);
+        return NULL;
+    }
+
+    // 3. Validate the path struct against the svgparser.h specifications using the helper function
+    bool valid = validPathStruct(path);
+    if (valid == false){
+        deletePath(path);
+        return NULL;
+    }
+
+    return path;
+
+}
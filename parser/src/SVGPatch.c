@@ -0,0 +1,454 @@
+// Name: Haifaa Abushaaban
+
+#define _POSIX_C_SOURCE 200809L // open, mmap
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelperA2.h"
+#include "SVGStringBuilder.h"
+#include "SVGWriter.h"
+#include "SVGPatch.h"
+#include "SVGJournal.h"
+
+// maps the whole file into memory read only, so the scan and the splice never copy it
+bool mapFile(const char* fileName, const char** data, size_t* length){
+
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0){
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    *data = (const char*) map;
+    *length = fileStat.st_size;
+    return true;
+}
+
+void unmapFile(const char* data, size_t length){
+
+    munmap((void*) data, length);
+}
+
+// checks if the string is at pos, the file is not NUL terminated so the length is checked first
+bool stringAt(const char* data, size_t length, size_t pos, const char* string){
+
+    size_t stringLength = strlen(string);
+    return (pos + stringLength <= length) && (memcmp(data + pos, string, stringLength) == 0);
+}
+
+// returns the position of the next string at or after pos, or length if there is none
+size_t findString(const char* data, size_t length, size_t pos, const char* string){
+
+    while (pos < length){
+        const char* found = memchr(data + pos, string[0], length - pos);
+        if (found == NULL) break;
+        pos = found - data;
+        if (stringAt(data, length, pos, string)) return pos;
+        ++pos;
+    }
+
+    return length;
+}
+
+// given the < of a start tag, returns one past its >, or 0 if the tag does not end
+size_t endOfTag(const char* data, size_t length, size_t pos, bool* selfClosing){
+
+    char quote = '\0';
+    for (size_t i = pos + 1; i < length; ++i){
+        char c = data[i];
+        if (quote != '\0'){
+            if (c == quote) quote = '\0';
+        }
+        else if (c == '"' || c == '\''){
+            quote = c;
+        }
+        else if (c == '>'){
+            *selfClosing = (data[i - 1] == '/');
+            return i + 1;
+        }
+        else if (c == '<'){
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+// compares the name of the tag at pos without its prefix, ignoring case like getElementNames does
+bool tagNameIs(const char* data, size_t length, size_t pos, const char* name){
+
+    size_t start = pos + 1;
+    size_t end = start;
+    while (end < length && !isspace((unsigned char)data[end]) && data[end] != '/' && data[end] != '>'){
+        if (data[end] == ':') start = end + 1;
+        ++end;
+    }
+
+    return (end - start == strlen(name)) && (strncasecmp(data + start, name, end - start) == 0);
+}
+
+/*
+    true if the xml declaration of the file, the tag from pos to end, has no encoding or says UTF-8,
+    the new value is written as utf-8 so a file in any other encoding needs the full edit
+*/
+static bool utf8Declaration(const char* data, size_t end, size_t pos){
+
+    size_t encoding = findString(data, end, pos, "encoding");
+    if (encoding == end) return true;
+
+    // the value after the = and the spaces around it, in either quotes
+    size_t value = encoding + strlen("encoding");
+    while (value < end && (isspace((unsigned char)data[value]) || data[value] == '=')) ++value;
+    if (value >= end || (data[value] != '"' && data[value] != '\'')) return false;
+
+    const char* close = memchr(data + value + 1, data[value], end - value - 1);
+    size_t length = (close == NULL) ? 0 : (size_t)(close - (data + value + 1));
+
+    return (length == 5 && strncasecmp(data + value + 1, "UTF-8", 5) == 0) || (length == 4 && strncasecmp(data + value + 1, "UTF8", 4) == 0);
+}
+
+/*
+    scans the file for the root svg, every title and desc that createSVG reads, and the target element
+    the elements are numbered the way getElementNames fills the lists: in document order, anywhere outside of a group
+    returns false if the file has something the scan does not handle, like a DOCTYPE that could declare entities
+    or an encoding other than UTF-8
+*/
+bool scanSVGSpans(SVGSpans* spans){
+
+    const char* data = spans->data;
+    size_t length = spans->length;
+
+    spans->numTitles = 0;
+    spans->numDescs = 0;
+    spans->targetFound = false;
+
+    int depth = 0; // number of open elements
+    int groupDepth = 0; // depth of the outermost open group, 0 when not in a group
+    int rawDepth = 0; // depth of the open element createSVG keeps as raw xml, 0 when not in one
+    int counts[GROUP + 1] = {0}; // elements found of each type outside of groups
+    ElementSpan* open = NULL; // the title or desc whose content is being read
+    int openDepth = 0;
+    bool rootFound = false;
+
+    // a compressed file has to be written again compressed, which is the full edit
+    if (stringAt(data, length, 0, "\x1F\x8B")) return false;
+
+    size_t pos = 0;
+    if (stringAt(data, length, 0, "\xEF\xBB\xBF")) pos = 3; // byte order mark
+
+    while (pos < length){
+
+        const char* next = memchr(data + pos, '<', length - pos);
+        if (next == NULL) break;
+        pos = next - data;
+
+        // 1. markup that is not an element
+        if (stringAt(data, length, pos, "<!--") || stringAt(data, length, pos, "<![CDATA[") || stringAt(data, length, pos, "<?")){
+            const char* endString = (data[pos + 1] == '?') ? "?>" : (data[pos + 2] == '-') ? "-->" : "]]>";
+            size_t end = findString(data, length, pos + 2, endString);
+            if (end == length) return false;
+            if (stringAt(data, length, pos, "<?xml ") && utf8Declaration(data, end, pos) == false) return false;
+            if (open != NULL) open->simple = false;
+            pos = end + strlen(endString);
+            continue;
+        }
+        if (stringAt(data, length, pos, "<!")) return false;
+
+        // 2. end tags
+        if (stringAt(data, length, pos, "</")){
+            const char* end = memchr(data + pos, '>', length - pos);
+            if (end == NULL || depth == 0) return false;
+            if (open != NULL && depth == openDepth){
+                open->content.end = pos;
+                open = NULL;
+            }
+            if (depth == groupDepth) groupDepth = 0;
+            if (depth == rawDepth) rawDepth = 0;
+            --depth;
+            pos = end - data + 1;
+            if (depth == 0) break;
+            continue;
+        }
+
+        // 3. start tags
+        bool selfClosing = false;
+        size_t end = endOfTag(data, length, pos, &selfClosing);
+        if (end == 0) return false;
+        if (open != NULL) open->simple = false;
+
+        ElementSpan element;
+        element.tag.start = pos;
+        element.tag.end = end;
+        element.content.start = end;
+        element.content.end = end;
+        element.selfClosing = selfClosing;
+        element.simple = true;
+
+        if (depth == 0){
+            // the root has to be exactly <svg, so the small document made by validPatch can end with </svg>
+            if (rootFound || stringAt(data, length, pos, "<svg") == false || tagNameIs(data, length, pos, "svg") == false) return false;
+            spans->root = element;
+            rootFound = true;
+        }
+        else if (groupDepth == 0 && rawDepth == 0){
+            if (depth != 1){
+                // only the children of the svg are read, anything deeper is inside a title or desc
+            }
+            else if (tagNameIs(data, length, pos, "title")){
+                spans->title = element;
+                ++(spans->numTitles);
+                if (selfClosing == false){
+                    open = &(spans->title);
+                    openDepth = depth + 1;
+                }
+            }
+            else if (tagNameIs(data, length, pos, "desc")){
+                spans->desc = element;
+                ++(spans->numDescs);
+                if (selfClosing == false){
+                    open = &(spans->desc);
+                    openDepth = depth + 1;
+                }
+            }
+            else {
+                elementType type = SVG_IMG;
+                if (tagNameIs(data, length, pos, "rect")) type = RECT;
+                else if (tagNameIs(data, length, pos, "circle")) type = CIRC;
+                else if (tagNameIs(data, length, pos, "path")) type = PATH;
+                else if (tagNameIs(data, length, pos, "g")) type = GROUP;
+
+                if (type != SVG_IMG){
+                    if (type == spans->targetType && counts[type] == spans->targetIndex){
+                        spans->target = element;
+                        spans->targetFound = true;
+                    }
+                    ++counts[type];
+                    if (type == GROUP && selfClosing == false) groupDepth = depth + 1;
+                }
+                else if (selfClosing == false) rawDepth = depth + 1; // nothing inside it is read by createSVG
+            }
+        }
+
+        if (selfClosing == false) ++depth;
+        pos = end;
+    }
+
+    return rootFound && depth == 0;
+}
+
+/*
+    finds the value of an attribute in the start tag of the element, the span includes the quotes
+    the name is compared without its prefix and ignoring case, like changeValueInAttr
+*/
+bool findAttributeSpan(const char* data, const ElementSpan* element, const char* name, ByteSpan* value){
+
+    size_t i = element->tag.start + 1;
+    size_t end = element->tag.end - 1; // the >
+
+    // 1. skip the element name
+    while (i < end && !isspace((unsigned char)data[i]) && data[i] != '/') ++i;
+
+    // 2. read each name="value"
+    while (i < end){
+
+        while (i < end && isspace((unsigned char)data[i])) ++i;
+        if (i >= end || data[i] == '/') break;
+
+        size_t nameStart = i;
+        size_t localStart = i;
+        while (i < end && data[i] != '=' && !isspace((unsigned char)data[i])){
+            if (data[i] == ':') localStart = i + 1;
+            ++i;
+        }
+        size_t nameEnd = i;
+
+        while (i < end && isspace((unsigned char)data[i])) ++i;
+        if (i >= end || data[i] != '=') return false;
+        ++i;
+        while (i < end && isspace((unsigned char)data[i])) ++i;
+        if (i >= end || (data[i] != '"' && data[i] != '\'')) return false;
+
+        char quote = data[i];
+        size_t valueStart = i;
+        ++i;
+        while (i < end && data[i] != quote) ++i;
+        if (i >= end) return false;
+        ++i;
+
+        // 3. a namespace declaration is never the attribute asked for, xmlns:xlink would otherwise match xlink
+        bool namespaceDecl = (nameEnd - nameStart >= 5) && (strncmp(data + nameStart, "xmlns", 5) == 0);
+        if (namespaceDecl == false && nameEnd - localStart == strlen(name) && strncasecmp(data + localStart, name, nameEnd - localStart) == 0){
+            value->start = valueStart;
+            value->end = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+    checks the edit against the schema in a document with only the svg start tag and the edited element:
+    <svg ...><element .../></svg>, then the new value is set in the element with libxml2 and the document is validated
+    name is the attribute to change, or NULL to change the text of the element
+*/
+bool validPatch(const SVGSpans* spans, const ElementSpan* element, const char* name, const char* value, const char* schemaFile){
+
+    // 1. the start tags without their > or />
+    size_t rootLength = spans->root.tag.end - spans->root.tag.start - (spans->root.selfClosing ? 2 : 1);
+    size_t elementLength = element->tag.end - element->tag.start - (element->selfClosing ? 2 : 1);
+
+    StringBuilder builder;
+    if (initBuilder(&builder, rootLength + elementLength + 16) == false) return false;
+    appendBytes(&builder, spans->data + spans->root.tag.start, rootLength);
+    appendChar(&builder, '>');
+    appendBytes(&builder, spans->data + element->tag.start, elementLength);
+    appendString(&builder, "/></svg>");
+    char* xml = finishBuilder(&builder);
+    if (xml == NULL) return false;
+
+    // 2. parse the small document
+    xmlDocPtr doc = xmlReadMemory(xml, strlen(xml), NULL, NULL, 0);
+    free(xml);
+    if (doc == NULL){
+        xmlCleanupParser();
+        return false;
+    }
+
+    xmlNodePtr node = xmlDocGetRootElement(doc)->children;
+    while (node != NULL && node->type != XML_ELEMENT_NODE) node = node->next;
+    if (node == NULL){
+        xmlFreeDoc(doc);
+        xmlCleanupParser();
+        return false;
+    }
+
+    // 3. make the change
+    bool changed = false;
+    if (name == NULL){
+        xmlNodeAddContent(node, BAD_CAST value);
+        changed = true;
+    }
+    else {
+        for (xmlAttrPtr attr = node->properties; attr != NULL && changed == false; attr = attr->next){
+            if (strcasecmp((char*) attr->name, name) == 0){
+                xmlSetNsProp(node, attr->ns, attr->name, BAD_CAST value);
+                changed = true;
+            }
+        }
+    }
+
+    // 4. validate it
+    bool valid = changed && validateFileSVG(doc, schemaFile);
+
+    xmlFreeDoc(doc);
+    xmlCleanupParser();
+    return valid;
+}
+
+/*
+    writes the file again as the bytes before the span, the escaped value, and the bytes after the span
+    the write goes through openWriter and closeWriter, so it replaces the file atomically like writeSVG
+    an attribute value is written with its quotes, since the span of an attribute includes them
+*/
+bool spliceFile(const char* fileName, const char* data, size_t length, ByteSpan span, const char* value, bool attribute){
+
+    SVGWriter* writer = malloc(sizeof(SVGWriter));
+    if (writer == NULL) return false;
+    if (openWriter(writer, fileName) == false){
+        free(writer);
+        return false;
+    }
+
+    writeBytes(writer, data, span.start);
+    if (attribute) writeBytes(writer, "\"", 1);
+    writeEscaped(writer, value, attribute);
+    if (attribute) writeBytes(writer, "\"", 1);
+    writeBytes(writer, data + span.end, length - span.end);
+
+    bool written = closeWriter(writer);
+    free(writer);
+
+    return written;
+}
+
+// replaces the text of the title or desc, elementName is "title" or "desc"
+bool patchTitleDesc(const char* fileName, const char* elementName, const char* newValue, const char* schemaFile){
+
+    if (fileName == NULL || elementName == NULL || newValue == NULL || schemaFile == NULL) return false;
+
+    // an empty title is left out of the file, which needs the full write
+    if (strlen(newValue) == 0) return false;
+    // the edits in a journal come after the file, so they are written into it with the full write first
+    if (journalExists(fileName)) return false;
+
+    SVGSpans spans;
+    spans.targetType = SVG_IMG;
+    spans.targetIndex = -1;
+    if (mapFile(fileName, &(spans.data), &(spans.length)) == false) return false;
+
+    // 1. find the one element to change, it has to have only text in it
+    bool title = (strcmp(elementName, "title") == 0);
+    bool patched = scanSVGSpans(&spans);
+    ElementSpan* element = title ? &(spans.title) : &(spans.desc);
+    int count = title ? spans.numTitles : spans.numDescs;
+    patched = patched && count == 1 && element->selfClosing == false && element->simple;
+
+    // 2. check the change and write it
+    patched = patched && validPatch(&spans, element, NULL, newValue, schemaFile);
+    patched = patched && spliceFile(fileName, spans.data, spans.length, element->content, newValue, false);
+
+    unmapFile(spans.data, spans.length);
+    return patched;
+}
+
+/*
+    replaces the value of an attribute the element already has, the same element setAttribute would change
+    adding an attribute, and the numbers with units of rectangles and circles, need the full edit
+*/
+bool patchAttribute(const char* fileName, elementType type, int index, const char* name, const char* value, const char* schemaFile){
+
+    if (fileName == NULL || name == NULL || value == NULL || schemaFile == NULL || index < 0) return false;
+    if (type != RECT && type != CIRC && type != PATH && type != GROUP) return false;
+
+    if (type == RECT && (strcasecmp(name, "x") == 0 || strcasecmp(name, "y") == 0 || strcasecmp(name, "width") == 0 || strcasecmp(name, "height") == 0)) return false;
+    if (type == CIRC && (strcasecmp(name, "cx") == 0 || strcasecmp(name, "cy") == 0 || strcasecmp(name, "r") == 0)) return false;
+    if (journalExists(fileName)) return false;
+
+    SVGSpans spans;
+    spans.targetType = type;
+    spans.targetIndex = index;
+    if (mapFile(fileName, &(spans.data), &(spans.length)) == false) return false;
+
+    // 1. find the element and the attribute
+    ByteSpan valueSpan;
+    bool patched = scanSVGSpans(&spans) && spans.targetFound;
+    patched = patched && findAttributeSpan(spans.data, &(spans.target), name, &valueSpan);
+
+    // 2. check the change and write it
+    patched = patched && validPatch(&spans, &(spans.target), name, value, schemaFile);
+    patched = patched && spliceFile(fileName, spans.data, spans.length, valueSpan, value, true);
+
+    unmapFile(spans.data, spans.length);
+    return patched;
+}
@@ -0,0 +1,401 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGFormat.h"
+#include "SVGHelper.h"
+#include "SVGPathData.h"
+#include "SVGPathStore.h"
+
+// the number of numbers each command takes, -1 for a letter that is not a command
+int numArgs(char command){
+
+    switch (command){
+        case 'M': case 'm': case 'L': case 'l': case 'T': case 't': return 2;
+        case 'H': case 'h': case 'V': case 'v': return 1;
+        case 'C': case 'c': return 6;
+        case 'S': case 's': case 'Q': case 'q': return 4;
+        case 'A': case 'a': return 7;
+        case 'Z': case 'z': return 0;
+        default: return -1;
+    }
+}
+
+// true for the characters that separate the numbers of the path data
+bool pathSpace(char c){
+
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+/*
+    reads one number of the path data at the cursor, and moves the cursor past it
+    the extent of the number is found first, whole numbers of up to 7 digits are exact in a float and are
+    added up directly, any other number goes to strtof, which reads the same extent
+    @return false if there is no number at the cursor
+*/
+bool readPathNumber(const char** cursor, float* number){
+
+    const char* start = *cursor;
+    const char* c = start;
+
+    // 1. find the extent: sign, digits, point and digits, exponent
+    if (*c == '+' || *c == '-') ++c;
+    const char* digits = c;
+    long whole = 0;
+    while (*c >= '0' && *c <= '9'){
+        whole = (c - digits < 9) ? whole * 10 + (*c - '0') : whole;
+        ++c;
+    }
+    int numDigits = (int)(c - digits);
+    bool simple = true;
+
+    if (*c == '.'){
+        simple = false;
+        ++c;
+        const char* fraction = c;
+        while (*c >= '0' && *c <= '9') ++c;
+        numDigits += (int)(c - fraction);
+    }
+    if (numDigits == 0) return false;
+
+    if (*c == 'e' || *c == 'E'){
+        const char* exponent = c + 1;
+        if (*exponent == '+' || *exponent == '-') ++exponent;
+        if (*exponent >= '0' && *exponent <= '9'){
+            simple = false;
+            c = exponent;
+            while (*c >= '0' && *c <= '9') ++c;
+        }
+    }
+
+    // 2. convert it
+    if (simple && numDigits <= 7){
+        *number = (*start == '-') ? -(float)whole : (float)whole;
+    }
+    else {
+        char* end = NULL;
+        *number = strtof(start, &end);
+        if (end != c || isfinite(*number) == 0) return false;
+    }
+
+    *cursor = c;
+    return true;
+}
+
+// the large arc and sweep flags of an arc are one character, so "a1 1 0 01 5 5" is read as 0, 1 and 5
+bool readPathFlag(const char** cursor, float* number){
+
+    if (**cursor != '0' && **cursor != '1') return false;
+
+    *number = (float)(**cursor - '0');
+    ++(*cursor);
+    return true;
+}
+
+/*
+    reads the whole path data into one PathData, the text is read twice, once to count and once to fill in
+    the data must start with a move to, and any mistake in it returns NULL, so the parse always gives back the same path
+    caller must free the PathData
+*/
+PathData* parsePathData(const char* data){
+
+    if (data == NULL) return NULL;
+
+    PathData* pathData = NULL;
+    int numCommands = 0;
+    int numCoords = 0;
+
+    for (int pass = 0; pass < 2; ++pass){
+
+        const char* c = data;
+        char command = '\0';
+        numCommands = 0;
+        numCoords = 0;
+
+        while (true){
+
+            // 1. skip the spaces, a comma can only be between two numbers
+            while (pathSpace(*c)) ++c;
+            if (*c == '\0') break;
+
+            // 2. a new command, or the same one again
+            if (numArgs(*c) >= 0){
+                command = *c;
+                ++c;
+                while (pathSpace(*c)) ++c;
+            }
+            else if (command == '\0' || command == 'Z' || command == 'z'){
+                free(pathData);
+                return NULL; // numbers with no command for them
+            }
+            else if (command == 'M'){
+                command = 'L'; // the pairs after a move to are line tos
+            }
+            else if (command == 'm'){
+                command = 'l';
+            }
+
+            if (numCommands == 0 && command != 'M' && command != 'm'){
+                free(pathData);
+                return NULL;
+            }
+
+            // 3. the numbers of the segment
+            int args = numArgs(command);
+            for (int i = 0; i < args; ++i){
+                float number = 0;
+                if (i > 0){
+                    while (pathSpace(*c)) ++c;
+                    if (*c == ','){
+                        ++c;
+                        while (pathSpace(*c)) ++c;
+                    }
+                }
+
+                bool flag = (command == 'A' || command == 'a') && (i == 3 || i == 4);
+                bool read = flag ? readPathFlag(&c, &number) : readPathNumber(&c, &number);
+                if (read == false){
+                    free(pathData);
+                    return NULL;
+                }
+                if (pathData != NULL) pathData->coords[numCoords] = number;
+                ++numCoords;
+            }
+
+            if (pathData != NULL) pathData->commands[numCommands] = command;
+            ++numCommands;
+
+            // 4. a comma after the last number of a segment when more numbers follow
+            while (pathSpace(*c)) ++c;
+            if (*c == ',' && args > 0) ++c;
+        }
+
+        // 5. after counting, allocate the struct with the numbers and then the commands
+        if (pass == 0){
+            pathData = malloc(sizeof(PathData) + sizeof(float) * numCoords + numCommands);
+            if (pathData == NULL) return NULL;
+            pathData->coords = (float*)(pathData + 1);
+            pathData->commands = (char*)(pathData->coords + numCoords);
+        }
+    }
+
+    pathData->numCommands = numCommands;
+    pathData->numCoords = numCoords;
+
+    return pathData;
+}
+
+/*
+    writes a number with the fewest characters: the fewest digits that read back as the same float, no 0 before the point,
+    and no space before it when it is the first number after a letter, or when its sign or point already ends the last number
+    lastHasPoint is whether the last number written has a point, it is updated for this one
+*/
+void appendPathNumber(StringBuilder* builder, float number, bool first, bool* lastHasPoint){
+
+    char buffer[SVG_NUMBER_LENGTH];
+    formatNumber(buffer, sizeof(buffer), number, SVG_PRECISION_SHORTEST);
+
+    // 1. 0.5 is .5 and -0.5 is -.5
+    char* text = buffer;
+    if (text[0] == '0' && text[1] == '.') ++text;
+    else if (text[0] == '-' && text[1] == '0' && text[2] == '.'){
+        text[1] = '-';
+        ++text;
+    }
+
+    // 2. the separator, only when the number would run into the last one
+    if (first == false && text[0] != '-' && (text[0] != '.' || *lastHasPoint == false)) appendChar(builder, ' ');
+    *lastHasPoint = (strchr(text, '.') != NULL);
+
+    appendString(builder, text);
+}
+
+/*
+    writes the path data back as the shortest d text, a command letter is left out when the segment before
+    it has the same command, or it is the line to after a move to
+    caller must free the string
+*/
+char* pathDataToString(const PathData* pathData){
+
+    if (pathData == NULL) return NULL;
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 4 * pathData->numCoords + pathData->numCommands + 1) == false) return NULL;
+
+    const float* coords = pathData->coords;
+    char last = '\0';
+    bool lastHasPoint = false;
+
+    for (int i = 0; i < pathData->numCommands; ++i){
+
+        char command = pathData->commands[i];
+        int args = numArgs(command);
+
+        // 1. the letter, when it cannot be left out
+        bool implicit = args > 0 && ((command == last && command != 'M' && command != 'm') ||
+                                     (command == 'L' && last == 'M') || (command == 'l' && last == 'm'));
+        if (implicit == false) appendChar(&builder, command);
+
+        // 2. the numbers
+        for (int j = 0; j < args; ++j){
+            appendPathNumber(&builder, coords[j], (implicit == false && j == 0), &lastHasPoint);
+        }
+
+        last = command;
+        coords += args;
+    }
+
+    return finishBuilder(&builder);
+}
+
+/*
+    the parse of the path, made the first time it is asked for and kept in the path until the data changes
+    @return NULL if the data cannot be read
+*/
+PathData* getPathData(Path* path){
+
+    if (path == NULL) return NULL;
+
+    if (path->parsed == NULL) path->parsed = parsePathData(path->data);
+
+    return path->parsed;
+}
+
+// frees the parse kept in the path, it must be called when the data is changed
+void clearPathData(Path* path){
+
+    if (path == NULL) return;
+
+    free(path->parsed);
+    path->parsed = NULL;
+}
+
+/*
+    replaces the data of the path with the string of the store with the new data, and gives the old one back,
+    so the paths with the same data share it. The parse kept in the path is not changed
+    @return false, with the path not changed, if the data cannot be stored
+*/
+bool setPathData(Path* path, const char* data){
+
+    if (path == NULL || data == NULL) return false;
+
+    const char* stored = storePathData(data);
+    if (stored == NULL) return false;
+
+    releasePathData(path->data);
+    path->data = stored;
+    return true;
+}
+
+/*
+    scales the path about its first point, the same way scaleRectangles keeps x and y:
+    the absolute points move away from the first point, the relative numbers and arc radii are multiplied
+    the first move to is absolute even when it is written as m, so it stays where it is
+*/
+void scalePathData(PathData* pathData, float scaleValue){
+
+    if (pathData == NULL || pathData->numCommands == 0) return;
+
+    float* coords = pathData->coords;
+    float x0 = coords[0];
+    float y0 = coords[1];
+
+    for (int i = 0; i < pathData->numCommands; ++i){
+
+        char command = pathData->commands[i];
+        int args = numArgs(command);
+
+        if (i == 0){
+            // the first point is the center of the scale
+        }
+        else if (command == 'A' || command == 'a'){
+            coords[0] *= fabsf(scaleValue); // the radii, the rotation and flags do not change
+            coords[1] *= fabsf(scaleValue);
+            if (command == 'A'){
+                coords[5] = x0 + (coords[5] - x0) * scaleValue;
+                coords[6] = y0 + (coords[6] - y0) * scaleValue;
+            }
+            else {
+                coords[5] *= scaleValue;
+                coords[6] *= scaleValue;
+            }
+        }
+        else if (command == 'H'){
+            coords[0] = x0 + (coords[0] - x0) * scaleValue;
+        }
+        else if (command == 'V'){
+            coords[0] = y0 + (coords[0] - y0) * scaleValue;
+        }
+        else if (command >= 'A' && command <= 'Z'){
+            for (int j = 0; j < args; j += 2){
+                coords[j] = x0 + (coords[j] - x0) * scaleValue;
+                coords[j + 1] = y0 + (coords[j + 1] - y0) * scaleValue;
+            }
+        }
+        else {
+            for (int j = 0; j < args; ++j) coords[j] *= scaleValue;
+        }
+
+        coords += args;
+    }
+}
+
+/*
+    scales every path in the list and writes the scaled data back in the shortest form
+    @return false if a path cannot be read or written, the paths before it are already scaled
+*/
+bool scalePathList(List* pathList, float scaleValue){
+
+    if (pathList == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(pathList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Path* path = (Path*) elem;
+        PathData* pathData = getPathData(path);
+        if (pathData == NULL) return false;
+
+        scalePathData(pathData, scaleValue);
+        if (updatePath(path) == false) return false;
+    }
+
+    return true;
+}
+
+/*
+    writes the changed parse of the path back into its data in the shortest form
+    @return false if the data cannot be written, the parse is then freed so it is read again from the old data
+*/
+bool updatePath(Path* path){
+
+    if (path == NULL) return false;
+
+    char* data = pathDataToString(path->parsed);
+    bool valid = (data != NULL && setPathData(path, data));
+    free(data);
+    if (valid == false) clearPathData(path); // the parse is still the parse of the new data otherwise
+
+    return valid;
+}
+
+// like getElementGroups, scales the paths of the groups and their subgroups
+bool scaleGroupPaths(List* groupList, float scaleValue){
+
+    if (groupList == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(groupList);
+    while ((elem = nextElement(&iter)) != NULL){
+        Group* group = (Group*) elem;
+        if (scalePathList(group->paths, scaleValue) == false) return false;
+        if (scaleGroupPaths(group->groups, scaleValue) == false) return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,331 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <stddef.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGPathStore.h"
+
+// the buckets of the store, a power of 2 of them so the hash wraps with a mask
+static PathString** storeBuckets = NULL;
+static int storeCapacity = 0;
+static int storeUsed = 0;
+
+// the FNV-1a hash of the data, of its letters in lower case when foldCase is true
+uint32_t hashPathData(const char* data, bool foldCase){
+
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)data; *c != '\0'; ++c){
+        hash ^= foldCase ? (uint32_t)tolower(*c) : *c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// the string of the store that holds the data, the data must be a string of the store
+static PathString* storedString(const char* data){
+
+    return (PathString*)(data - offsetof(PathString, data));
+}
+
+static bool growStore(void){
+
+    int capacity = (storeCapacity == 0) ? SVG_PATH_STORE_MIN : storeCapacity * 2;
+    PathString** buckets = calloc(capacity, sizeof(PathString*));
+    if (buckets == NULL) return false;
+
+    // the strings are moved to the buckets of their hash in the bigger store
+    for (int i = 0; i < storeCapacity; ++i){
+        PathString* string = storeBuckets[i];
+        while (string != NULL){
+            PathString* next = string->next;
+            uint32_t bucket = string->hash & (uint32_t)(capacity - 1);
+            string->next = buckets[bucket];
+            buckets[bucket] = string;
+            string = next;
+        }
+    }
+
+    free(storeBuckets);
+    storeBuckets = buckets;
+    storeCapacity = capacity;
+    return true;
+}
+
+/*
+    the string of the store with the same text as the data, put in the store if no path has it yet,
+    the caller has it until it gives it back with releasePathData
+    @return NULL if the data is NULL or cannot be stored
+*/
+const char* storePathData(const char* data){
+
+    if (data == NULL) return NULL;
+
+    // 1. the string is found by the hash of its text
+    uint32_t hash = hashPathData(data, false);
+    if (storeCapacity > 0){
+        for (PathString* string = storeBuckets[hash & (uint32_t)(storeCapacity - 1)]; string != NULL; string = string->next){
+            if (string->hash == hash && strcmp(string->data, data) == 0){
+                ++string->refs;
+                return string->data;
+            }
+        }
+    }
+
+    // 2. otherwise it is copied into the store
+    if ((storeUsed + 1) * 4 > storeCapacity * 3 && growStore() == false) return NULL;
+
+    size_t length = strlen(data);
+    PathString* string = malloc(sizeof(PathString) + length + 1);
+    if (string == NULL) return NULL;
+
+    string->hash = hash;
+    string->caseHash = hashPathData(data, true);
+    string->refs = 1;
+    memcpy(string->data, data, length + 1);
+
+    uint32_t bucket = hash & (uint32_t)(storeCapacity - 1);
+    string->next = storeBuckets[bucket];
+    storeBuckets[bucket] = string;
+    ++storeUsed;
+
+    return string->data;
+}
+
+// one more holder of the string of the store, which gives it back with releasePathData
+const char* retainPathData(const char* data){
+
+    if (data == NULL) return NULL;
+
+    ++storedString(data)->refs;
+    return data;
+}
+
+// gives back the string of the store, it is freed when nothing else has it
+void releasePathData(const char* data){
+
+    if (data == NULL) return;
+
+    PathString* string = storedString(data);
+    if (--string->refs > 0) return;
+
+    // 1. the string is taken out of its bucket
+    PathString** link = &storeBuckets[string->hash & (uint32_t)(storeCapacity - 1)];
+    while (*link != string) link = &(*link)->next;
+    *link = string->next;
+    free(string);
+
+    // 2. the buckets are freed with the last string, so nothing is left once every svg is deleted
+    if (--storeUsed == 0){
+        free(storeBuckets);
+        storeBuckets = NULL;
+        storeCapacity = 0;
+    }
+}
+
+// the paths and tables that have the string of the store
+int pathDataRefs(const char* data){
+
+    return (data == NULL) ? 0 : storedString(data)->refs;
+}
+
+static bool initPathCounts(PathCounts* counts, int capacity){
+
+    // a power of 2, so the probe wraps with a mask
+    int size = SVG_PATH_COUNTS_MIN;
+    while (size < capacity && size < (1 << 30)) size *= 2;
+
+    counts->buckets = calloc(size, sizeof(PathCountBucket));
+    if (counts->buckets == NULL) return false;
+
+    counts->capacity = size;
+    counts->used = 0;
+    return true;
+}
+
+static void freePathCountBuckets(PathCountBucket* buckets, int capacity){
+
+    for (int i = 0; i < capacity; ++i){
+        releasePathData(buckets[i].data);
+    }
+    free(buckets);
+}
+
+// the bucket of the data with the hash of its text in lower case, or the unused bucket it would go in
+static PathCountBucket* findPathCountBucket(const PathCounts* counts, const char* data, uint32_t caseHash){
+
+    uint32_t mask = (uint32_t)counts->capacity - 1;
+    uint32_t i = caseHash & mask;
+
+    while (counts->buckets[i].data != NULL && strcasecmp(counts->buckets[i].data, data) != 0){
+        i = (i + 1) & mask;
+    }
+
+    return &counts->buckets[i];
+}
+
+static bool growPathCounts(PathCounts* counts){
+
+    PathCounts grown;
+    if (initPathCounts(&grown, counts->capacity * 2) == false) return false;
+
+    for (int i = 0; i < counts->capacity; ++i){
+        const char* data = counts->buckets[i].data;
+        if (data == NULL) continue;
+
+        *findPathCountBucket(&grown, data, storedString(data)->caseHash) = counts->buckets[i];
+        ++grown.used;
+    }
+
+    // the strings are in the new buckets, so they are not given back
+    free(counts->buckets);
+    counts->buckets = grown.buckets;
+    counts->capacity = grown.capacity;
+    counts->used = grown.used;
+    return true;
+}
+
+/*
+    adds count paths to the data, a string of the store, or takes them away when count is negative
+    the data whose count goes to 0 keeps its bucket, so the data after it in the probe are still found
+*/
+bool addPathCount(PathCounts* counts, const char* data, int count){
+
+    if (counts == NULL || counts->buckets == NULL || data == NULL) return false;
+
+    if ((counts->used + 1) * 4 > counts->capacity * 3 && growPathCounts(counts) == false) return false;
+
+    PathCountBucket* bucket = findPathCountBucket(counts, data, storedString(data)->caseHash);
+    if (bucket->data == NULL){
+        bucket->data = retainPathData(data);
+        bucket->count = 0;
+        ++counts->used;
+    }
+
+    bucket->count += count;
+    if (bucket->count < 0) bucket->count = 0;
+    return true;
+}
+
+// the paths with the data, any string, with the case of its letters left out
+int pathCount(const PathCounts* counts, const char* data){
+
+    if (counts == NULL || counts->buckets == NULL || data == NULL) return 0;
+
+    return findPathCountBucket(counts, data, hashPathData(data, true))->count;
+}
+
+// makes the counts of the svg as it is now, the caller keeps them in the svg or frees them with deletePathCounts
+PathCounts* buildPathCounts(const SVG* img){
+
+    if (img == NULL) return NULL;
+
+    List* paths = getPaths(img);
+    if (paths == NULL) return NULL;
+
+    PathCounts* counts = malloc(sizeof(PathCounts));
+    bool valid = (counts != NULL && initPathCounts(counts, getLength(paths) * 2));
+    if (counts != NULL && valid == false){
+        free(counts);
+        counts = NULL;
+    }
+
+    void* elem;
+    ListIterator iter = createIterator(paths);
+    while (valid && (elem = nextElement(&iter)) != NULL){
+        valid = addPathCount(counts, ((Path*)elem)->data, 1);
+    }
+    freeList(paths);
+
+    if (valid == false){
+        deletePathCounts(counts);
+        return NULL;
+    }
+
+    counts->version = img->version;
+    return counts;
+}
+
+// the counts of the svg, made again when a change to the svg since they were made has made them out of date
+PathCounts* getPathCounts(SVG* img){
+
+    if (img == NULL) return NULL;
+    if (pathCountsCurrent(img)) return img->pathCounts;
+
+    deletePathCounts(img->pathCounts);
+    img->pathCounts = buildPathCounts(img);
+    return img->pathCounts;
+}
+
+bool pathCountsCurrent(const SVG* img){
+
+    return img != NULL && img->pathCounts != NULL && img->pathCounts->version == img->version;
+}
+
+void deletePathCounts(PathCounts* counts){
+
+    if (counts == NULL) return;
+
+    freePathCountBuckets(counts->buckets, counts->capacity);
+    free(counts);
+}
+
+/*
+    counts a shape that was added when it is a path, current is whether the counts were up to date before it was added
+    (the svg has been touched since), the counts are then up to date again
+*/
+void countPathData(SVG* img, elementType type, void* shape, bool current){
+
+    if (img == NULL || img->pathCounts == NULL || current == false) return;
+
+    if (type != PATH || addPathCount(img->pathCounts, ((Path*)shape)->data, 1)) img->pathCounts->version = img->version;
+}
+
+/*
+    called before a shape is changed, with the shape, or with NULL when the change moves no path,
+    endPathChange is then called after the change, before anything else changes the svg
+*/
+void beginPathChange(SVG* img, elementType type, void* shape, PathChange* change){
+
+    change->img = img;
+    change->current = pathCountsCurrent(img);
+    change->path = (type == PATH) ? (Path*)shape : NULL;
+    // the old data is kept until the end, the path may give it back to the store when it is set
+    change->data = (change->path == NULL) ? NULL : retainPathData(change->path->data);
+}
+
+// moves the path from its old data to its new one, the counts are then up to date again
+void endPathChange(PathChange* change){
+
+    const char* data = change->data;
+    change->data = NULL;
+
+    if (change->current && change->img->pathCounts != NULL){
+        PathCounts* counts = change->img->pathCounts;
+        bool valid = true;
+        if (change->path != NULL && change->path->data != data){
+            valid = addPathCount(counts, data, -1) && addPathCount(counts, change->path->data, 1);
+        }
+        if (valid) counts->version = change->img->version;
+    }
+
+    releasePathData(data);
+}
+
+/*
+    the number of paths of the svg and its groups with the data, with the case of its letters left out like the query
+    the svg is const so the counts are only read, they are made by getPathCounts
+    @return -1 if the svg has no counts that are up to date, the caller then compares the paths itself
+*/
+int countPathsWithData(const SVG* img, const char* data){
+
+    if (pathCountsCurrent(img) == false) return -1;
+
+    return pathCount(img->pathCounts, data);
+}
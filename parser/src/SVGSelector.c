@@ -0,0 +1,680 @@
+// Name: Haifaa Abushaaban
+
+#define _POSIX_C_SOURCE 200809L // strdup
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <stddef.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGShapes.h"
+#include "SVGFormat.h"
+#include "SVGTransform.h"
+#include "SVGElementPath.h"
+#include "SVGStringBuilder.h"
+#include "SVGSelector.h"
+
+// the numbers of the structs that are read like attributes
+static const struct {
+    elementType type;
+    const char* name;
+    size_t offset;
+} selectorFields[] = {
+    {RECT, "x", offsetof(Rectangle, x)}, {RECT, "y", offsetof(Rectangle, y)},
+    {RECT, "width", offsetof(Rectangle, width)}, {RECT, "height", offsetof(Rectangle, height)},
+    {CIRC, "cx", offsetof(Circle, cx)}, {CIRC, "cy", offsetof(Circle, cy)}, {CIRC, "r", offsetof(Circle, r)},
+    {LINE, "x1", offsetof(Line, x1)}, {LINE, "y1", offsetof(Line, y1)},
+    {LINE, "x2", offsetof(Line, x2)}, {LINE, "y2", offsetof(Line, y2)},
+    {ELLIPSE, "cx", offsetof(Ellipse, cx)}, {ELLIPSE, "cy", offsetof(Ellipse, cy)},
+    {ELLIPSE, "rx", offsetof(Ellipse, rx)}, {ELLIPSE, "ry", offsetof(Ellipse, ry)},
+};
+
+// the order the lists of a group or of the svg are walked in, the groups last so their elements follow them
+static const elementType selectorOrder[] = {RECT, CIRC, PATH, LINE, ELLIPSE, POLYLINE, POLYGON, GROUP};
+
+// The value of an attribute of an element, as text and as a number when it is one
+typedef struct {
+    const char* text;
+    bool numeric;
+    float number;
+    char buffer[32];
+    // the text when it was made for the test, freed after it
+    char* owned;
+} SelectorValue;
+
+// The state of a plan that is run over an svg
+typedef struct {
+    const Selector* selector;
+
+    // the svg and the groups that the elements being walked are in, the svg first
+    elementType* ancestorTypes;
+    void** ancestors;
+    int depth;
+    int maxDepth;
+
+    // the elements found, kept only when keep is true, otherwise they are only counted
+    bool keep;
+    SelectorMatch* matches;
+    int count;
+    int maxMatches;
+    bool failed;
+} SelectorRun;
+
+// Functions to read the text of a selector
+
+static void skipSelectorSpaces(const char** cursor){
+
+    while (isspace((unsigned char)**cursor)) ++(*cursor);
+}
+
+static bool selectorNameChar(char c){
+
+    return isalnum((unsigned char)c) || c == '-' || c == '_' || c == ':' || c == '.';
+}
+
+// a copy of the name at the cursor, NULL if there is no name there
+static char* readSelectorName(const char** cursor){
+
+    const char* start = *cursor;
+    while (selectorNameChar(**cursor)) ++(*cursor);
+
+    size_t length = *cursor - start;
+    if (length == 0) return NULL;
+
+    char* name = malloc(length + 1);
+    if (name == NULL) return NULL;
+
+    memcpy(name, start, length);
+    name[length] = '\0';
+    return name;
+}
+
+// a copy of the value at the cursor, in quotes or up to the bracket or a space, NULL if there is no value there
+static char* readSelectorValue(const char** cursor){
+
+    const char* start = *cursor;
+    size_t length;
+
+    if (**cursor == '"' || **cursor == '\''){
+        char quote = **cursor;
+        const char* end = strchr(start + 1, quote);
+        if (end == NULL) return NULL;
+
+        ++start;
+        length = end - start;
+        *cursor = end + 1;
+    }
+    else {
+        while (**cursor != '\0' && **cursor != ']' && isspace((unsigned char)**cursor) == 0) ++(*cursor);
+        length = *cursor - start;
+        if (length == 0) return NULL;
+    }
+
+    char* value = malloc(length + 1);
+    if (value == NULL) return NULL;
+
+    memcpy(value, start, length);
+    value[length] = '\0';
+    return value;
+}
+
+static bool readSelectorOp(const char** cursor, selectorOp* op){
+
+    // the two letter operators first, so <= is not read as <
+    static const struct {
+        const char* text;
+        selectorOp op;
+    } ops[] = {
+        {"^=", SELECT_PREFIX}, {"$=", SELECT_SUFFIX}, {"*=", SELECT_CONTAINS}, {"!=", SELECT_NOT_EQUAL},
+        {"<=", SELECT_LESS_EQUAL}, {">=", SELECT_GREATER_EQUAL}, {"=", SELECT_EQUAL}, {"<", SELECT_LESS}, {">", SELECT_GREATER}
+    };
+
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); ++i){
+        size_t length = strlen(ops[i].text);
+        if (strncmp(*cursor, ops[i].text, length) == 0){
+            *op = ops[i].op;
+            *cursor += length;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void freeSelectorStep(SelectorStep* step){
+
+    for (int i = 0; i < step->numTests; ++i){
+        free(step->tests[i].name);
+        free(step->tests[i].value);
+    }
+    free(step->tests);
+}
+
+// reads a test after its [, up to and past its ]
+static bool readSelectorTest(const char** cursor, SelectorTest* test){
+
+    test->value = NULL;
+    test->numeric = false;
+    test->number = 0;
+    test->op = SELECT_HAS;
+
+    // 1. the name of the attribute
+    skipSelectorSpaces(cursor);
+    test->name = readSelectorName(cursor);
+    if (test->name == NULL) return false;
+
+    // 2. the operator and the value, if it is not only [name]
+    skipSelectorSpaces(cursor);
+    if (**cursor != ']'){
+        if (readSelectorOp(cursor, &test->op) == false) return false;
+
+        skipSelectorSpaces(cursor);
+        test->value = readSelectorValue(cursor);
+        if (test->value == NULL) return false;
+
+        // 3. the value is a number when all of it is read as one
+        char* end;
+        test->number = strtof(test->value, &end);
+        test->numeric = (end != test->value && *end == '\0' && isfinite(test->number));
+
+        // the comparisons need numbers
+        if (test->op >= SELECT_LESS && test->numeric == false) return false;
+        skipSelectorSpaces(cursor);
+    }
+
+    if (**cursor != ']') return false;
+    ++(*cursor);
+    return true;
+}
+
+// reads a step, an element name or * and the tests after it
+static bool readSelectorStep(const char** cursor, SelectorStep* step){
+
+    step->anyType = true;
+    step->type = SVG_IMG;
+    step->tests = NULL;
+    step->numTests = 0;
+
+    // 1. the element name, which may be left out when there is a test
+    if (**cursor == '*'){
+        ++(*cursor);
+    }
+    else if (**cursor != '['){
+        const char* start = *cursor;
+        while (isalpha((unsigned char)**cursor)) ++(*cursor);
+
+        size_t length = *cursor - start;
+        if (length == 0) return false;
+
+        step->type = pathElementType(start, length);
+        step->anyType = false;
+        if (step->type == SVG_IMG && (length != 3 || strncasecmp(start, "svg", 3) != 0)) return false; // not an element of the svg
+    }
+
+    // 2. the tests
+    while (**cursor == '['){
+        ++(*cursor);
+
+        SelectorTest* tests = realloc(step->tests, sizeof(SelectorTest) * (step->numTests + 1));
+        if (tests == NULL) return false;
+        step->tests = tests;
+
+        bool valid = readSelectorTest(cursor, &step->tests[step->numTests]);
+        ++step->numTests; // freed with the step even when it was not read
+        if (valid == false) return false;
+    }
+
+    return true;
+}
+
+// reads the steps of one selector of the list, up to a comma or the end
+static bool readSelectorChain(const char** cursor, SelectorChain* chain){
+
+    chain->steps = NULL;
+    chain->numSteps = 0;
+    bool child = false;
+
+    while (true){
+        SelectorStep* steps = realloc(chain->steps, sizeof(SelectorStep) * (chain->numSteps + 1));
+        if (steps == NULL) return false;
+        chain->steps = steps;
+
+        SelectorStep* step = &chain->steps[chain->numSteps];
+        bool valid = readSelectorStep(cursor, step);
+        step->child = child;
+        ++chain->numSteps;
+        if (valid == false) return false;
+
+        // a step is followed by > for a child, by spaces for a descendant, or by the end of the selector
+        const char* end = *cursor;
+        skipSelectorSpaces(cursor);
+        if (**cursor == '\0' || **cursor == ',') return true;
+
+        child = (**cursor == '>');
+        if (child){
+            ++(*cursor);
+            skipSelectorSpaces(cursor);
+        }
+        else if (*cursor == end){
+            return false; // two steps with nothing between them
+        }
+    }
+}
+
+void deleteSelector(Selector* selector){
+
+    if (selector == NULL) return;
+
+    for (int i = 0; i < selector->numChains; ++i){
+        for (int j = 0; j < selector->chains[i].numSteps; ++j){
+            freeSelectorStep(&selector->chains[i].steps[j]);
+        }
+        free(selector->chains[i].steps);
+    }
+    free(selector->chains);
+    free(selector);
+}
+
+/*
+    compiles the text of a selector into the plan that is run over an svg, see SVGSelector.h
+    @return NULL if the text is not a selector, the caller frees the plan with deleteSelector
+*/
+Selector* compileSelector(const char* text){
+
+    if (text == NULL) return NULL;
+
+    Selector* selector = calloc(1, sizeof(Selector));
+    if (selector == NULL) return NULL;
+
+    const char* cursor = text;
+    bool valid = true;
+
+    // 1. the selectors of the list
+    while (valid){
+        skipSelectorSpaces(&cursor);
+
+        SelectorChain* chains = realloc(selector->chains, sizeof(SelectorChain) * (selector->numChains + 1));
+        if (chains == NULL){
+            valid = false;
+            break;
+        }
+        selector->chains = chains;
+
+        valid = readSelectorChain(&cursor, &selector->chains[selector->numChains]);
+        ++selector->numChains;
+
+        if (valid == false || *cursor == '\0') break;
+        ++cursor; // the comma
+    }
+
+    if (valid == false){
+        deleteSelector(selector);
+        return NULL;
+    }
+
+    // 2. the types of the elements the plan can find, so the walk reads no other lists
+    for (int i = 0; i < selector->numChains; ++i){
+        const SelectorStep* last = &selector->chains[i].steps[selector->chains[i].numSteps - 1];
+        selector->typeMask |= last->anyType ? (SVG_ELEMENT_MASK(SVG_IMG) | SVG_ELEMENT_MASK(GROUP) | SVG_SHAPES_MASK) : SVG_ELEMENT_MASK(last->type);
+    }
+
+    return selector;
+}
+
+// Functions to run the plan
+
+static void setSelectorNumber(SelectorValue* value, float number){
+
+    value->numeric = true;
+    value->number = number;
+    snprintf(value->buffer, sizeof(value->buffer), "%g", number);
+    value->text = value->buffer;
+}
+
+// the value of the attribute of the element, false if the element does not have it
+static bool readElementValue(elementType type, void* element, const char* name, SelectorValue* value){
+
+    value->owned = NULL;
+    value->numeric = false;
+
+    // 1. the numbers of the structs
+    for (size_t i = 0; i < sizeof(selectorFields) / sizeof(selectorFields[0]); ++i){
+        if (selectorFields[i].type == type && strcasecmp(selectorFields[i].name, name) == 0){
+            setSelectorNumber(value, *(const float*)((const char*)element + selectorFields[i].offset));
+            return true;
+        }
+    }
+
+    // 2. the attributes that are kept in their own fields, and the made up ones
+    if (type == PATH && strcasecmp(name, "d") == 0){
+        value->text = ((Path*)element)->data;
+    }
+    else if ((type == POLYLINE || type == POLYGON) && strcasecmp(name, "points") == 0){
+        value->owned = pointsToString((Polyline*)element, SVG_PRECISION_SHORTEST);
+        if (value->owned == NULL) return false;
+        value->text = value->owned;
+    }
+    else if (strcasecmp(name, "area") == 0 && (type == RECT || type == CIRC || type == ELLIPSE)){
+        if (type == RECT) setSelectorNumber(value, ((Rectangle*)element)->width * ((Rectangle*)element)->height);
+        else if (type == CIRC) setSelectorNumber(value, SVG_PI * ((Circle*)element)->r * ((Circle*)element)->r);
+        else setSelectorNumber(value, SVG_PI * ((Ellipse*)element)->rx * ((Ellipse*)element)->ry);
+        return true;
+    }
+    else if (type == GROUP && strcasecmp(name, "len") == 0){
+        setSelectorNumber(value, numGroupChildren((Group*)element));
+        return true;
+    }
+    else {
+        // 3. the other attributes
+        List* attributes = (type == SVG_IMG) ? ((SVG*)element)->otherAttributes : shapeOtherAttributes(element, type);
+        if (attributes == NULL) return false;
+
+        Attribute* attr = NULL;
+        void* elem;
+        ListIterator iter = createIterator(attributes);
+        while ((elem = nextElement(&iter)) != NULL){
+            if (strcasecmp(((Attribute*)elem)->name, name) == 0){
+                attr = (Attribute*)elem;
+                break;
+            }
+        }
+        if (attr == NULL) return false;
+
+        value->text = attr->value;
+    }
+
+    // 4. a value like 10 or 10px is a number too
+    char* end;
+    value->number = strtof(value->text, &end);
+    value->numeric = (end != value->text && isfinite(value->number));
+    return true;
+}
+
+static bool passSelectorTest(const SelectorTest* test, elementType type, void* element){
+
+    SelectorValue value;
+    if (readElementValue(type, element, test->name, &value) == false) return false;
+
+    bool pass = false;
+    size_t textLength = strlen(value.text);
+    size_t valueLength = (test->value == NULL) ? 0 : strlen(test->value);
+
+    switch (test->op){
+        case SELECT_HAS:
+            pass = true;
+            break;
+        case SELECT_EQUAL:
+        case SELECT_NOT_EQUAL:
+            pass = (test->numeric && value.numeric) ? (value.number == test->number) : (strcmp(value.text, test->value) == 0);
+            if (test->op == SELECT_NOT_EQUAL) pass = !pass;
+            break;
+        case SELECT_PREFIX:
+            pass = (strncmp(value.text, test->value, valueLength) == 0);
+            break;
+        case SELECT_SUFFIX:
+            pass = (textLength >= valueLength && strcmp(value.text + textLength - valueLength, test->value) == 0);
+            break;
+        case SELECT_CONTAINS:
+            pass = (strstr(value.text, test->value) != NULL);
+            break;
+        case SELECT_LESS:
+            pass = value.numeric && value.number < test->number;
+            break;
+        case SELECT_LESS_EQUAL:
+            pass = value.numeric && value.number <= test->number;
+            break;
+        case SELECT_GREATER:
+            pass = value.numeric && value.number > test->number;
+            break;
+        case SELECT_GREATER_EQUAL:
+            pass = value.numeric && value.number >= test->number;
+            break;
+    }
+
+    free(value.owned);
+    return pass;
+}
+
+// true if the element is of the type of the step and passes all of its tests
+bool matchSelectorStep(const SelectorStep* step, elementType type, void* element){
+
+    if (step == NULL || element == NULL) return false;
+    if (step->anyType == false && step->type != type) return false;
+
+    for (int i = 0; i < step->numTests; ++i){
+        if (passSelectorTest(&step->tests[i], type, element) == false) return false;
+    }
+
+    return true;
+}
+
+// true if the steps before step match the ancestors before depth, the element of step having matched
+static bool matchSelectorAncestors(const SelectorRun* run, const SelectorChain* chain, int step, int depth){
+
+    if (step == 0) return true;
+
+    const SelectorStep* previous = &chain->steps[step - 1];
+    for (int d = depth - 1; d >= 0; --d){
+        if (matchSelectorStep(previous, run->ancestorTypes[d], run->ancestors[d]) && matchSelectorAncestors(run, chain, step - 1, d)) return true;
+        if (chain->steps[step].child) return false; // only the parent can match
+    }
+
+    return false;
+}
+
+static bool selectedElement(const SelectorRun* run, elementType type, void* element){
+
+    for (int i = 0; i < run->selector->numChains; ++i){
+        const SelectorChain* chain = &run->selector->chains[i];
+        if (matchSelectorStep(&chain->steps[chain->numSteps - 1], type, element) && matchSelectorAncestors(run, chain, chain->numSteps - 1, run->depth)) return true;
+    }
+
+    return false;
+}
+
+// the element path of the element at index in the list of its type in the group with the path prefix
+static char* selectorElementPath(const char* prefix, elementType type, int index){
+
+    if (type == SVG_IMG) return strdup("svg");
+
+    const char* name = pathElementName(type);
+    char* path = malloc(strlen(prefix) + strlen(name) + 16);
+    if (path == NULL) return NULL;
+
+    sprintf(path, "%s%s%s%d", prefix, (prefix[0] == '\0') ? "" : "/", name, index);
+    return path;
+}
+
+static void addSelectorMatch(SelectorRun* run, elementType type, void* element, Group* parent, int index, const char* prefix){
+
+    if (run->keep){
+        if (run->count == run->maxMatches){
+            int maxMatches = (run->maxMatches == 0) ? 16 : run->maxMatches * 2;
+            SelectorMatch* matches = realloc(run->matches, sizeof(SelectorMatch) * maxMatches);
+            if (matches == NULL){
+                run->failed = true;
+                return;
+            }
+            run->matches = matches;
+            run->maxMatches = maxMatches;
+        }
+
+        SelectorMatch* match = &run->matches[run->count];
+        match->type = type;
+        match->element = element;
+        match->parent = parent;
+        match->index = index;
+        match->path = selectorElementPath(prefix, type, index);
+        if (match->path == NULL){
+            run->failed = true;
+            return;
+        }
+    }
+
+    ++run->count;
+}
+
+static bool pushSelectorAncestor(SelectorRun* run, elementType type, void* element){
+
+    if (run->depth == run->maxDepth){
+        int maxDepth = (run->maxDepth == 0) ? 8 : run->maxDepth * 2;
+        elementType* types = realloc(run->ancestorTypes, sizeof(elementType) * maxDepth);
+        if (types == NULL) return false;
+        run->ancestorTypes = types;
+
+        void** ancestors = realloc(run->ancestors, sizeof(void*) * maxDepth);
+        if (ancestors == NULL) return false;
+        run->ancestors = ancestors;
+        run->maxDepth = maxDepth;
+    }
+
+    run->ancestorTypes[run->depth] = type;
+    run->ancestors[run->depth] = element;
+    ++run->depth;
+    return true;
+}
+
+// tests the elements of the group, or of the svg when the group is NULL, and walks into its groups
+static void selectInContainer(SelectorRun* run, SVG* img, Group* parent, const char* prefix){
+
+    for (size_t i = 0; i < sizeof(selectorOrder) / sizeof(selectorOrder[0]) && run->failed == false; ++i){
+
+        // 1. only the lists of the types the plan can find, and the groups to walk into
+        elementType type = selectorOrder[i];
+        bool wanted = (run->selector->typeMask & SVG_ELEMENT_MASK(type)) != 0;
+        if (wanted == false && type != GROUP) continue;
+
+        List* list = containerList(img, parent, type);
+        if (list == NULL) continue;
+
+        void* elem;
+        ListIterator iter = createIterator(list);
+        for (int index = 0; run->failed == false && (elem = nextElement(&iter)) != NULL; ++index){
+            if (wanted && selectedElement(run, type, elem)) addSelectorMatch(run, type, elem, parent, index, prefix);
+            if (type != GROUP) continue;
+
+            // 2. the elements of the group have it as their parent, and its path before theirs
+            char* groupPath = NULL;
+            if (run->keep){
+                groupPath = selectorElementPath(prefix, GROUP, index);
+                if (groupPath == NULL){
+                    run->failed = true;
+                    break;
+                }
+            }
+
+            if (pushSelectorAncestor(run, GROUP, elem) == false) run->failed = true;
+            else {
+                selectInContainer(run, img, (Group*)elem, run->keep ? groupPath : "");
+                --run->depth;
+            }
+            free(groupPath);
+        }
+    }
+}
+
+// runs the plan over the svg and all its groups, the matches are kept in the run when keep is true
+static bool runSelector(SVG* img, const Selector* selector, SelectorRun* run, bool keep){
+
+    memset(run, 0, sizeof(SelectorRun));
+    run->selector = selector;
+    run->keep = keep;
+
+    if ((selector->typeMask & SVG_ELEMENT_MASK(SVG_IMG)) && selectedElement(run, SVG_IMG, img)) addSelectorMatch(run, SVG_IMG, img, NULL, 0, "");
+
+    if (run->failed == false && pushSelectorAncestor(run, SVG_IMG, img)) selectInContainer(run, img, NULL, "");
+    else run->failed = true;
+
+    free(run->ancestorTypes);
+    free(run->ancestors);
+    return run->failed == false;
+}
+
+// the number of elements of the svg and all its groups the plan finds, -1 if it cannot be run
+int countSelected(SVG* img, const Selector* selector){
+
+    if (img == NULL || selector == NULL) return -1;
+
+    SelectorRun run;
+    if (runSelector(img, selector, &run, false) == false) return -1;
+    return run.count;
+}
+
+/*
+    the elements of the svg and all its groups the plan finds, the groups before the elements in them
+    @return NULL if the plan cannot be run, the caller frees the matches with freeSelectorMatches
+*/
+SelectorMatch* selectElements(SVG* img, const Selector* selector, int* count){
+
+    if (img == NULL || selector == NULL || count == NULL) return NULL;
+
+    SelectorRun run;
+    bool valid = runSelector(img, selector, &run, true);
+    if (valid && run.matches == NULL) run.matches = malloc(sizeof(SelectorMatch)); // nothing found is not a failure
+    if (valid == false || run.matches == NULL){
+        freeSelectorMatches(run.matches, run.count); // a match whose path could not be made is not counted
+        return NULL;
+    }
+
+    *count = run.count;
+    return run.matches;
+}
+
+void freeSelectorMatches(SelectorMatch* matches, int count){
+
+    if (matches == NULL) return;
+
+    for (int i = 0; i < count; ++i){
+        free(matches[i].path);
+    }
+    free(matches);
+}
+
+// [{"path":"g0/rect1","type":"rect"},...]
+char* selectorMatchesToJSON(const SelectorMatch* matches, int count){
+
+    if (matches == NULL) return NULL;
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 64 + 48 * count) == false) return NULL;
+    appendChar(&builder, '[');
+
+    for (int i = 0; i < count; ++i){
+        appendFormat(&builder, "%s{\"path\":\"%s\",\"type\":\"%s\"}", (i == 0) ? "" : ",", matches[i].path, pathElementName(matches[i].type));
+    }
+
+    appendChar(&builder, ']');
+    return finishBuilder(&builder);
+}
+
+// compiles the selector and counts what it finds in the svg, -1 if it is not a selector
+int countSelectorMatches(SVG* img, const char* text){
+
+    Selector* selector = compileSelector(text);
+    if (selector == NULL) return -1;
+
+    int count = countSelected(img, selector);
+    deleteSelector(selector);
+    return count;
+}
+
+// compiles the selector and finds its elements in the svg, in the JSON of selectorMatchesToJSON
+char* selectToJSON(SVG* img, const char* text){
+
+    Selector* selector = compileSelector(text);
+    if (selector == NULL) return NULL;
+
+    int count = 0;
+    SelectorMatch* matches = selectElements(img, selector, &count);
+    deleteSelector(selector);
+    if (matches == NULL) return NULL;
+
+    char* json = selectorMatchesToJSON(matches, count);
+    freeSelectorMatches(matches, count);
+    return json;
+}
@@ -0,0 +1,668 @@
+// Name: Haifaa Abushaaban
+
+#define _POSIX_C_SOURCE 200809L // stat with nanoseconds, strdup
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelper.h"
+#include "SVGHelperA2.h"
+#include "SVGHelperJSON.h"
+#include "SVGShapes.h"
+#include "SVGTransform.h"
+#include "SVGJournal.h"
+#include "SVGElementPath.h"
+#include "SVGSpatial.h"
+#include "SVGSelector.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
+#include "SVGSession.h"
+
+static SVGSession sessions[SVG_MAX_SESSIONS];
+static int nextHandle = 1;
+
+// the open session with the handle, or NULL
+SVGSession* findSession(int handle){
+
+    if (handle <= 0) return NULL;
+
+    for (int i = 0; i < SVG_MAX_SESSIONS; ++i){
+        if (sessions[i].handle == handle) return &sessions[i];
+    }
+
+    return NULL;
+}
+
+// the open session of the file, or NULL
+SVGSession* findSessionNamed(const char* fileName){
+
+    for (int i = 0; i < SVG_MAX_SESSIONS; ++i){
+        if (sessions[i].handle != 0 && strcmp(sessions[i].fileName, fileName) == 0) return &sessions[i];
+    }
+
+    return NULL;
+}
+
+// keeps the time, size and inode of the file and the size of its journal, so fileChanged can tell when something else writes them
+bool statSession(SVGSession* session){
+
+    struct stat fileStat;
+    if (stat(session->fileName, &fileStat) != 0) return false;
+
+    session->modified = fileStat.st_mtim.tv_sec;
+    session->modifiedNanos = fileStat.st_mtim.tv_nsec;
+    session->size = fileStat.st_size;
+    session->inode = fileStat.st_ino;
+    session->journalSize = journalSize(session->fileName);
+    return true;
+}
+
+// true if the file is not the one the session read or wrote last, files are replaced by a rename so the inode changes too
+bool fileChanged(const SVGSession* session){
+
+    struct stat fileStat;
+    if (stat(session->fileName, &fileStat) != 0) return true;
+
+    return fileStat.st_mtim.tv_sec != session->modified || fileStat.st_mtim.tv_nsec != session->modifiedNanos ||
+           fileStat.st_size != session->size || fileStat.st_ino != session->inode ||
+           journalSize(session->fileName) != session->journalSize;
+}
+
+// reads the file into the session, any edits that are not written are dropped
+bool loadSession(SVGSession* session){
+
+    unloadSession(session);
+    initBuilder(&(session->edits), 0);
+
+    // 1. stat first, so a write between the stat and the read is seen as a change the next time
+    if (statSession(session) == false) return false;
+
+    session->img = createValidSVG(session->fileName, SVG_SESSION_SCHEMA);
+    return session->img != NULL;
+}
+
+void unloadSession(SVGSession* session){
+
+    deleteSVG(session->img);
+    session->img = NULL;
+    session->dirty = false;
+    // no edits are kept until the file is read again
+    freeBuilder(&(session->edits));
+    session->edits.failed = true;
+}
+
+/*
+    writes the edits of the session to the file, with one xml tree like the other wrappers
+    @return false if the file was changed by something else since it was read, so the other change is not overwritten,
+    or if the svg is not valid or cannot be written
+*/
+bool flushSession(SVGSession* session){
+
+    if (session->img == NULL || session->dirty == false) return true;
+    if (fileChanged(session)) return false;
+
+    if (validateAndWriteSVG(session->img, SVG_SESSION_SCHEMA, session->fileName) == false) return false;
+
+    session->dirty = false;
+    statSession(session);
+
+    // the file has the edits now
+    if (session->edits.data != NULL){
+        session->edits.length = 0;
+        session->edits.data[0] = '\0';
+    }
+    return true;
+}
+
+void freeSession(SVGSession* session){
+
+    unloadSession(session);
+    free(session->fileName);
+    memset(session, 0, sizeof(SVGSession));
+}
+
+/*
+    writes and frees the structs of the sessions not used for SVG_SESSION_IDLE_SECONDS, the handles stay open
+    a session whose journal is too old is written even when it has no edits of its own, which compacts the journal
+*/
+void sweepSessions(time_t now){
+
+    for (int i = 0; i < SVG_MAX_SESSIONS; ++i){
+        SVGSession* session = &sessions[i];
+        if (session->handle == 0 || session->img == NULL) continue;
+        if (now - session->lastUsed < SVG_SESSION_IDLE_SECONDS) continue;
+
+        if (session->dirty == false && fileChanged(session) == false && journalNeedsCompaction(session->fileName, now)) session->dirty = true;
+
+        if (flushSession(session)) unloadSession(session); // kept when it cannot be written, so the edits are not lost
+    }
+}
+
+/*
+    the session of the handle, ready to be read or edited: the file is read again when the struct was freed
+    after being idle, or when something else changed the file and the session has no edits of its own
+    @return NULL if the handle is not open or the file cannot be read
+*/
+SVGSession* useSession(int handle){
+
+    time_t now = time(NULL);
+    sweepSessions(now);
+
+    SVGSession* session = findSession(handle);
+    if (session == NULL) return NULL;
+
+    if (session->img == NULL || (session->dirty == false && fileChanged(session))){
+        if (loadSession(session) == false) return NULL;
+    }
+
+    session->lastUsed = now;
+    return session;
+}
+
+/*
+    reads the file again and applies the edits of the session that are not written yet, they must leave the svg
+    valid like when they were made
+    @return false if they cannot all be applied, the session then has the file as it is like after svgRevert
+*/
+bool restoreSession(SVGSession* session){
+
+    // 1. the edits are taken out of the session, reading the file starts new ones
+    StringBuilder edits = session->edits;
+    session->edits.data = NULL;
+    bool kept = (edits.data != NULL && edits.failed == false);
+
+    if (loadSession(session) == false || kept == false || edits.length == 0){
+        freeBuilder(&edits);
+        return kept && session->img != NULL;
+    }
+
+    // 2. they are applied again as one array
+    StringBuilder array;
+    initBuilder(&array, edits.length + 2);
+    appendChar(&array, '[');
+    appendBytes(&array, edits.data, edits.length);
+    appendChar(&array, ']');
+    char* json = finishBuilder(&array);
+
+    bool applied = (json != NULL) && applyJSONEdits(session->img, json) && validateSVG(session->img, SVG_SESSION_SCHEMA);
+    free(json);
+
+    if (applied == false){
+        freeBuilder(&edits);
+        loadSession(session);
+        return false;
+    }
+
+    freeBuilder(&(session->edits));
+    session->edits = edits;
+    session->dirty = true;
+    return true;
+}
+
+/*
+    the end of every edit: the svg must still be valid against the schema, like the wrappers check before they write
+    an edit that could not be applied or left the svg invalid is taken out of the edits of the session, and is
+    undone by reading the file again and applying the edits before it (see restoreSession)
+*/
+bool finishEdit(SVGSession* session, bool applied){
+
+    if (applied && validateSVG(session->img, SVG_SESSION_SCHEMA)){
+        session->dirty = true;
+        return true;
+    }
+
+    if (session->edits.data != NULL && session->edits.failed == false){
+        session->edits.length = session->editStart;
+        session->edits.data[session->editStart] = '\0';
+    }
+
+    restoreSession(session);
+    return false;
+}
+
+// starts an edit in the edits of the session, {"op":"<op>", its fields are appended and endSessionEdit closes it
+void beginSessionEdit(SVGSession* session, const char* op){
+
+    StringBuilder* edits = &(session->edits);
+    session->editStart = edits->length;
+
+    if (edits->length > 0) appendChar(edits, ',');
+    appendString(edits, "{\"op\":\"");
+    appendJSONString(edits, op);
+    appendChar(edits, '"');
+}
+
+void appendEditString(SVGSession* session, const char* name, const char* value){
+
+    appendFormat(&(session->edits), ",\"%s\":\"", name);
+    appendJSONString(&(session->edits), value);
+    appendChar(&(session->edits), '"');
+}
+
+void endSessionEdit(SVGSession* session){
+
+    appendChar(&(session->edits), '}');
+}
+
+/*
+    adds every object of a JSON array to the edits of the session, as it is when op is NULL,
+    or with the op added in front of its fields, like the shapes of addShapesJSON are "add" edits
+*/
+void logSessionEdits(SVGSession* session, const char* edits, const char* op){
+
+    StringBuilder* log = &(session->edits);
+    session->editStart = log->length;
+
+    const char* cursor = edits;
+    char* object;
+    while ((object = nextJSONObject(&cursor)) != NULL){
+
+        if (log->length > 0) appendChar(log, ',');
+        if (op == NULL) appendString(log, object);
+        else {
+            // the fields of the object after its {
+            const char* fields = skipJSONSpaces(object + 1);
+            appendString(log, "{\"op\":\"");
+            appendJSONString(log, op);
+            appendChar(log, '"');
+            if (*fields != '}') appendChar(log, ',');
+            appendString(log, fields);
+        }
+        free(object);
+    }
+}
+
+/**
+    The svgOpen function reads a file for the session functions below
+    @return the handle, or 0 if the file cannot be read or there are already SVG_MAX_SESSIONS files open
+*/
+int svgOpen(char* filename){
+
+    if (filename == NULL) return 0;
+
+    time_t now = time(NULL);
+    sweepSessions(now);
+
+    // 1. the file is already open, one more reference to it
+    SVGSession* session = findSessionNamed(filename);
+    if (session != NULL){
+        if (useSession(session->handle) == NULL) return 0;
+        ++session->refCount;
+        return session->handle;
+    }
+
+    // 2. otherwise a free slot
+    for (int i = 0; i < SVG_MAX_SESSIONS && session == NULL; ++i){
+        if (sessions[i].handle == 0) session = &sessions[i];
+    }
+    if (session == NULL) return 0;
+
+    session->fileName = strdup(filename);
+    if (session->fileName == NULL) return 0;
+
+    if (loadSession(session) == false){
+        freeSession(session);
+        return 0;
+    }
+
+    session->handle = nextHandle++;
+    session->refCount = 1;
+    session->lastUsed = now;
+    return session->handle;
+}
+
+bool svgFlush(int handle){
+
+    SVGSession* session = findSession(handle);
+    if (session == NULL) return false;
+
+    session->lastUsed = time(NULL);
+    return flushSession(session);
+}
+
+// writes the edits of every session, for when the server stops
+bool svgFlushSessions(void){
+
+    bool flushed = true;
+    for (int i = 0; i < SVG_MAX_SESSIONS; ++i){
+        if (sessions[i].handle != 0 && flushSession(&sessions[i]) == false) flushed = false;
+    }
+
+    return flushed;
+}
+
+/**
+    The svgClose function closes one reference to the file, the last one writes the edits and frees the session
+    @return false if the edits could not be written, they are dropped
+*/
+bool svgClose(int handle){
+
+    SVGSession* session = findSession(handle);
+    if (session == NULL) return false;
+
+    --session->refCount;
+    if (session->refCount > 0) return true;
+
+    bool flushed = flushSession(session);
+    freeSession(session);
+    return flushed;
+}
+
+// drops the edits that are not written, and reads the file again
+bool svgRevert(int handle){
+
+    SVGSession* session = findSession(handle);
+    if (session == NULL) return false;
+
+    session->lastUsed = time(NULL);
+    return loadSession(session);
+}
+
+void svgSweepSessions(void){
+
+    sweepSessions(time(NULL));
+}
+
+// the getters are the same as the wrappers that take a file name, without reading the file
+char* svgGetJSON(int handle){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return SVGtoJSON(session->img);
+}
+
+char* svgGetTitle(int handle){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return strdup(session->img->title);
+}
+
+char* svgGetDescr(int handle){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return strdup(session->img->description);
+}
+
+// one page of the components of the type in the svg (not in its groups), like getRectsJSONRange
+char* svgGetComponentsJSON(int handle, char* componentType, int offset, int limit){
+
+    elementType type = componentTypeNamed(componentType);
+    if (type == SVG_IMG) return NULL;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return listToJSONRange(svgComponentList(session->img, type), type, offset, limit);
+}
+
+char* svgGetAttributesJSON(int handle, char* componentType, int index){
+
+    elementType type = componentTypeNamed(componentType);
+    if (type == SVG_IMG) return NULL;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    List* list = svgComponentList(session->img, type);
+    void* elem = (list == NULL || index < 0 || index >= getLength(list)) ? NULL : getElementAt(list, index);
+
+    return attrListToJSON(shapeOtherAttributes(elem, type));
+}
+
+/*
+    the edits are the same as the wrappers that take a file name, they are kept in the session until svgFlush,
+    and each is added to the edits of the session in the format of applyJSONEdit before finishEdit
+*/
+bool svgSetTitle(int handle, char* newValue){
+
+    if (newValue == NULL || validChar(newValue) == 0 || strlen(newValue) >= 256) return false;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    strcpy(session->img->title, newValue);
+    beginSessionEdit(session, "title");
+    appendEditString(session, "value", newValue);
+    endSessionEdit(session);
+    return finishEdit(session, true);
+}
+
+bool svgSetDescr(int handle, char* newValue){
+
+    if (newValue == NULL || validChar(newValue) == 0 || strlen(newValue) >= 256) return false;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    strcpy(session->img->description, newValue);
+    beginSessionEdit(session, "description");
+    appendEditString(session, "value", newValue);
+    endSessionEdit(session);
+    return finishEdit(session, true);
+}
+
+bool svgSetAttribute(int handle, char* componentType, int componentNumber, char* newName, char* newValue){
+
+    // 1. create new attribute value, and validate it
+    Attribute* newAttribute = otherAttributes(newName, newValue);
+    if (newAttribute == NULL) return false;
+    if (validAttrStruct(newAttribute) == false){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    // 2. set or add the attribute, nothing is changed when it cannot be set
+    if (setAttribute(session->img, componentTypeNamed(componentType), componentNumber, newAttribute) == false){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    // 3. a NULL component is the svg itself, like componentTypeNamed
+    beginSessionEdit(session, "attribute");
+    appendEditString(session, "component", (componentType == NULL) ? "SVG" : componentType);
+    appendFormat(&(session->edits), ",\"index\":%d", componentNumber);
+    appendEditString(session, "name", newName);
+    appendEditString(session, "value", newValue);
+    endSessionEdit(session);
+    return finishEdit(session, true);
+}
+
+bool svgSetAttributeAtPath(int handle, char* elementPath, char* newName, char* newValue){
+
+    // 1. create new attribute value, and validate it
+    Attribute* newAttribute = otherAttributes(newName, newValue);
+    if (newAttribute == NULL) return false;
+    if (validAttrStruct(newAttribute) == false){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    // 2. set or add the attribute of the element at the path, nothing is changed when it cannot be set
+    if (setAttributeAtPath(session->img, elementPath, newAttribute) == false){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    beginSessionEdit(session, "attribute");
+    appendEditString(session, "path", elementPath);
+    appendEditString(session, "name", newName);
+    appendEditString(session, "value", newValue);
+    endSessionEdit(session);
+    return finishEdit(session, true);
+}
+
+bool svgAddShapesJSON(int handle, char* shapes){
+
+    if (shapes == NULL) return false;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    bool applied = addJSONShapes(session->img, shapes);
+    logSessionEdits(session, shapes, "add");
+    return finishEdit(session, applied);
+}
+
+// all the edits apply or none do, a failed batch is undone like any failed edit
+bool svgApplyEditsJSON(int handle, char* edits){
+
+    if (edits == NULL) return false;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    bool applied = applyJSONEdits(session->img, edits);
+    logSessionEdits(session, edits, NULL);
+    return finishEdit(session, applied);
+}
+
+/*
+    the same as svgApplyEditsJSON, but the edits are appended to the journal of the file right away instead of
+    waiting for svgFlush, and the whole file is only written when the journal needs compaction
+*/
+bool svgJournalEditsJSON(int handle, char* edits){
+
+    if (edits == NULL) return false;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    // 1. the edits the session has not written come before these, so they are written first, and the journal
+    // then has every edit the file does not, in order, for when a failed edit reads the file again
+    if (session->dirty && flushSession(session) == false) return false;
+
+    // 2. the edits are checked like any edit, and only written when they all apply
+    time_t now = time(NULL);
+    bool valid = applyJSONEdits(session->img, edits) && validateSVG(session->img, SVG_SESSION_SCHEMA);
+    if (valid == false || fileChanged(session) || appendJournal(session->fileName, edits, now) == false){
+        loadSession(session);
+        return false;
+    }
+
+    // 3. the journal grew by this session's own edits
+    statSession(session);
+
+    // 4. the whole file is written, which removes the journal
+    if (journalNeedsCompaction(session->fileName, now)){
+        session->dirty = true;
+        return flushSession(session);
+    }
+
+    return true;
+}
+
+bool svgScale(int handle, char* componentType, float scaleValue){
+
+    elementType type = componentTypeNamed(componentType);
+    if (type == SVG_IMG || type == GROUP) return false;
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    bool applied = scaleShapes(session->img, type, scaleValue);
+    beginSessionEdit(session, "scale");
+    appendEditString(session, "component", componentType);
+    appendFormat(&(session->edits), ",\"value\":%.9g", scaleValue);
+    endSessionEdit(session);
+    return finishEdit(session, applied);
+}
+
+bool svgTransform(int handle, float translateX, float translateY, float angle, float scaleValue){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return false;
+
+    float matrix[6];
+    composeMatrix(translateX, translateY, angle, scaleValue, matrix);
+    bool applied = transformSVG(session->img, matrix, SVG_SHAPES_MASK);
+
+    // the numbers are written with the digits that read back as the same floats
+    beginSessionEdit(session, "transform");
+    appendFormat(&(session->edits), ",\"translateX\":%.9g,\"translateY\":%.9g,\"angle\":%.9g,\"scale\":%.9g", translateX, translateY, angle, scaleValue);
+    endSessionEdit(session);
+    return finishEdit(session, applied);
+}
+
+// the queries of the shapes use the index kept in the svg of the session, which is made once for all of them
+char* svgQueryRegionJSON(int handle, float x, float y, float width, float height){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return queryRegionToJSON(session->img, x, y, width, height);
+}
+
+char* svgHitTestJSON(int handle, float x, float y){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return hitTestToJSON(session->img, x, y);
+}
+
+/*
+    the number of rectangles or circles of the svg of the session with the area, like numRectsWithArea
+    the histogram of the areas is made by the first count and kept in the svg, the edits keep it up to date
+    @return -1 if the session or the type is not valid
+*/
+int svgNumShapesWithArea(int handle, char* componentType, float area){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return -1;
+
+    elementType type = componentTypeNamed(componentType);
+    if (type != RECT && type != CIRC) return -1;
+
+    getAreaIndex(session->img); // if it cannot be made the shapes are counted one by one
+    return (type == RECT) ? numRectsWithArea(session->img, area) : numCirclesWithArea(session->img, area);
+}
+
+// the number of paths of the svg of the session with the data, like numPathsWithdata, the counts are kept like the histogram
+int svgNumPathsWithData(int handle, char* data){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return -1;
+
+    getPathCounts(session->img); // if they cannot be made the paths are compared one by one
+    return numPathsWithdata(session->img, data);
+}
+
+// the selectors are run over the svg of the session, see selectCount
+int svgSelectCount(int handle, char* selector){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return -1;
+
+    return countSelectorMatches(session->img, selector);
+}
+
+char* svgSelectJSON(int handle, char* selector){
+
+    SVGSession* session = useSession(handle);
+    if (session == NULL) return NULL;
+
+    return selectToJSON(session->img, selector);
+}
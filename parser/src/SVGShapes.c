@@ -0,0 +1,782 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelper.h"
+#include "SVGHelperA2.h"
+#include "SVGFormat.h"
+#include "SVGShapes.h"
+#include "SVGPathData.h"
+#include "SVGSpatial.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
+
+// Functions to create the structs and lists:
+
+List* initShapeList(elementType type){
+
+    if (type == LINE) return initializeList(&lineToString, &deleteLine, &compareLines);
+    if (type == ELLIPSE) return initializeList(&ellipseToString, &deleteEllipse, &compareEllipses);
+    if (type == POLYLINE || type == POLYGON) return initializeList(&polylineToString, &deletePolyline, &comparePolylines);
+    return NULL;
+}
+
+// returns the field of the svg that holds the list of the type, so a NULL list can be created when it is first needed
+List** svgShapeList(SVG* img, elementType type){
+
+    if (img == NULL) return NULL;
+    if (type == LINE) return &(img->lines);
+    if (type == ELLIPSE) return &(img->ellipses);
+    if (type == POLYLINE) return &(img->polylines);
+    if (type == POLYGON) return &(img->polygons);
+    return NULL;
+}
+
+// the list of the svg for any component type, unlike svgShapeList it also gives the rectangles, circles, paths and groups
+List* svgComponentList(const SVG* img, elementType type){
+
+    if (img == NULL) return NULL;
+    if (type == RECT) return img->rectangles;
+    if (type == CIRC) return img->circles;
+    if (type == PATH) return img->paths;
+    if (type == GROUP) return img->groups;
+
+    List** list = svgShapeList((SVG*)img, type);
+    return (list == NULL) ? NULL : *list;
+}
+
+List** groupShapeList(Group* group, elementType type){
+
+    if (group == NULL) return NULL;
+    if (type == LINE) return &(group->lines);
+    if (type == ELLIPSE) return &(group->ellipses);
+    if (type == POLYLINE) return &(group->polylines);
+    if (type == POLYGON) return &(group->polygons);
+    return NULL;
+}
+
+const char* shapeElementName(elementType type){
+
+    if (type == LINE) return "line";
+    if (type == ELLIPSE) return "ellipse";
+    if (type == POLYLINE) return "polyline";
+    if (type == POLYGON) return "polygon";
+    return NULL;
+}
+
+// the type of the component names the server uses, SVG_IMG for the svg itself or any other name
+elementType componentTypeNamed(const char* componentType){
+
+    if (componentType == NULL) return SVG_IMG;
+
+    if (strcasecmp(componentType, "Rectangle") == 0) return RECT;
+    if (strcasecmp(componentType, "Circle") == 0) return CIRC;
+    if (strcasecmp(componentType, "Path") == 0) return PATH;
+    if (strcasecmp(componentType, "Group") == 0) return GROUP;
+    if (strcasecmp(componentType, "Line") == 0) return LINE;
+    if (strcasecmp(componentType, "Ellipse") == 0) return ELLIPSE;
+    if (strcasecmp(componentType, "Polyline") == 0) return POLYLINE;
+    if (strcasecmp(componentType, "Polygon") == 0) return POLYGON;
+
+    return SVG_IMG;
+}
+
+/*
+    reads the numbers of a points attribute, separated by spaces and/or a comma, like "0,0 10,5 20 0"
+    the numbers are stored in points when it is not NULL, at most maxNumbers of them,
+    so it is called once with NULL to count the numbers and once to fill the array
+    reading stops at the first thing that is not a number, like svg renderers do, and end is set to it
+    @return the number of numbers read
+*/
+int parsePoints(const char* string, float* points, int maxNumbers, const char** end){
+
+    int count = 0;
+    const char* cursor = string;
+
+    while (cursor != NULL){
+
+        // 1. skip the spaces, and at most one comma between two numbers
+        while (isspace((unsigned char)*cursor)) ++cursor;
+        if (count > 0 && *cursor == ','){
+            ++cursor;
+            while (isspace((unsigned char)*cursor)) ++cursor;
+        }
+
+        // 2. read the number
+        char* numberEnd = NULL;
+        float number = strtof(cursor, &numberEnd);
+        if (numberEnd == cursor || checkInvalid(number) == false) break;
+
+        if (points != NULL && count < maxNumbers) points[count] = number;
+        ++count;
+        cursor = numberEnd;
+    }
+
+    if (end != NULL) *end = cursor;
+    return count;
+}
+
+/**
+ * This function will return a line struct with its attributes when given a node
+ * coordinates that are not given are 0, like rectangles
+ */
+Line* lineAttributes(xmlNode *cur_node){
+
+    if (cur_node == NULL) return NULL;
+
+    xmlAttr *attr;
+    Line* line = malloc(sizeof(Line));
+    if (line == NULL){
+        return NULL;
+    }
+
+    line->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    line->place = (ElementPlace){ SVG_IMG, 0, -1 };
+    strcpy(line->units, "");
+
+    int valid[4] = {0, 0, 0, 0}; // x1, y1, x2, y2
+
+    for (attr = cur_node->properties; attr != NULL; attr = attr->next) {
+        xmlNode *value = attr->children;
+        char *attrName = (char*)(attr->name);
+        char *cont = (char*)(value->content);
+
+        if (strcasecmp(attrName, "x1") == 0) valid[0] = numberWithUnits(&(line->x1), line->units, cont);
+        else if (strcasecmp(attrName, "y1") == 0) valid[1] = numberWithUnits(&(line->y1), line->units, cont);
+        else if (strcasecmp(attrName, "x2") == 0) valid[2] = numberWithUnits(&(line->x2), line->units, cont);
+        else if (strcasecmp(attrName, "y2") == 0) valid[3] = numberWithUnits(&(line->y2), line->units, cont);
+        else insertBack(line->otherAttributes, (void*)otherAttributes (attrName, cont));
+    }
+
+    if (valid[0] == 0) line->x1 = 0;
+    if (valid[1] == 0) line->y1 = 0;
+    if (valid[2] == 0) line->x2 = 0;
+    if (valid[3] == 0) line->y2 = 0;
+
+    return line;
+}
+
+/**
+ * This function will return an ellipse struct with its attributes when given a node
+ * the center is 0 when it is not given, and so are the radii, which do not draw the ellipse
+ */
+Ellipse* ellipseAttributes(xmlNode *cur_node){
+
+    if (cur_node == NULL) return NULL;
+
+    xmlAttr *attr;
+    Ellipse* ellipse = malloc(sizeof(Ellipse));
+    if (ellipse == NULL){
+        return NULL;
+    }
+
+    ellipse->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    ellipse->place = (ElementPlace){ SVG_IMG, 0, -1 };
+    strcpy(ellipse->units, "");
+
+    int valid[4] = {0, 0, 0, 0}; // cx, cy, rx, ry
+
+    for (attr = cur_node->properties; attr != NULL; attr = attr->next) {
+        xmlNode *value = attr->children;
+        char *attrName = (char*)(attr->name);
+        char *cont = (char*)(value->content);
+
+        if (strcasecmp(attrName, "cx") == 0) valid[0] = numberWithUnits(&(ellipse->cx), ellipse->units, cont);
+        else if (strcasecmp(attrName, "cy") == 0) valid[1] = numberWithUnits(&(ellipse->cy), ellipse->units, cont);
+        else if (strcasecmp(attrName, "rx") == 0) valid[2] = numberWithUnits(&(ellipse->rx), ellipse->units, cont);
+        else if (strcasecmp(attrName, "ry") == 0) valid[3] = numberWithUnits(&(ellipse->ry), ellipse->units, cont);
+        else insertBack(ellipse->otherAttributes, (void*)otherAttributes (attrName, cont));
+    }
+
+    if (valid[0] == 0) ellipse->cx = 0;
+    if (valid[1] == 0) ellipse->cy = 0;
+    if (valid[2] == 0) ellipse->rx = 0;
+    if (valid[3] == 0) ellipse->ry = 0;
+
+    return ellipse;
+}
+
+/**
+ * This function will return a polyline struct, also used for polygons, when given a node
+ * the points are counted first so the struct and its points are one allocation, an odd number
+ * at the end has no pair and is left out
+ */
+Polyline* polylineAttributes(xmlNode *cur_node){
+
+    if (cur_node == NULL) return NULL;
+
+    // 1. count the points
+    xmlAttr *attr;
+    int numPoints = 0;
+    for (attr = cur_node->properties; attr != NULL; attr = attr->next) {
+        if (strcasecmp((char*)attr->name, "points") == 0 && attr->children != NULL){
+            numPoints = parsePoints((char*)attr->children->content, NULL, 0, NULL) / 2;
+        }
+    }
+
+    Polyline* poly = malloc(sizeof(Polyline) + sizeof(float) * 2 * numPoints);
+    if (poly == NULL){
+        return NULL;
+    }
+
+    poly->otherAttributes = initializeList(&attributeToString, &deleteAttribute, &compareAttributes);
+    poly->place = (ElementPlace){ SVG_IMG, 0, -1 };
+    poly->numPoints = numPoints;
+    poly->maxPoints = numPoints;
+
+    // 2. fill in the points and the other attributes
+    for (attr = cur_node->properties; attr != NULL; attr = attr->next) {
+        xmlNode *value = attr->children;
+        char *attrName = (char*)(attr->name);
+        char *cont = (char*)(value->content);
+
+        if (strcasecmp(attrName, "points") == 0) parsePoints(cont, poly->points, 2 * numPoints, NULL);
+        else insertBack(poly->otherAttributes, (void*)otherAttributes (attrName, cont));
+    }
+
+    return poly;
+}
+
+/*
+    creates the struct for a line, ellipse, polyline or polygon node and adds it to the list, which is created if it is NULL
+    the shape is read at the place, which then counts it for the next one like addRawElement
+*/
+bool addShapeNode(xmlNode* cur_node, List** list, elementType type, ElementPlace* place){
+
+    if (cur_node == NULL || list == NULL || place == NULL) return false;
+
+    void* shape = NULL;
+    if (type == LINE) shape = lineAttributes(cur_node);
+    else if (type == ELLIPSE) shape = ellipseAttributes(cur_node);
+    else if (type == POLYLINE || type == POLYGON) shape = polylineAttributes(cur_node);
+    if (shape == NULL) return false;
+
+    *shapePlace(shape, type) = *place;
+    ++place->position;
+
+    if (*list == NULL) *list = initShapeList(type);
+    insertBack(*list, shape);
+
+    return true;
+}
+
+// Functions to find the shapes in the groups, and count them and their attributes:
+
+// the lists returned by getShapes do not own the shapes
+void dummyDeleteShape(void* data){}
+
+// like getElementGroups, adds the shapes of the type in the groups and their subgroups to dest
+void collectShapes(List* groupList, List* dest, elementType type){
+
+    if (groupList == NULL || dest == NULL) return;
+
+    void* elemG;
+    ListIterator iterG = createIterator(groupList);
+    while ((elemG = nextElement(&iterG)) != NULL){
+
+        Group* group = (Group*) elemG;
+        List** list = groupShapeList(group, type);
+
+        if (list != NULL && *list != NULL){
+            void* elem;
+            ListIterator iter = createIterator(*list);
+            while ((elem = nextElement(&iter)) != NULL){
+                insertBack(dest, elem);
+            }
+        }
+
+        collectShapes(group->groups, dest, type);
+    }
+}
+
+// the shapes of the type in the svg and in all its groups, the same order as getRects
+List* getShapes(const SVG* img, elementType type){
+
+    if (img == NULL) return NULL;
+
+    List** list = svgShapeList((SVG*)img, type);
+    if (list == NULL) return NULL;
+
+    List* shapes = NULL;
+    if (type == LINE) shapes = initializeList(&lineToString, &dummyDeleteShape, &compareLines);
+    else if (type == ELLIPSE) shapes = initializeList(&ellipseToString, &dummyDeleteShape, &compareEllipses);
+    else shapes = initializeList(&polylineToString, &dummyDeleteShape, &comparePolylines);
+
+    if (*list != NULL){
+        void* elem;
+        ListIterator iter = createIterator(*list);
+        while ((elem = nextElement(&iter)) != NULL){
+            insertBack(shapes, elem);
+        }
+    }
+
+    collectShapes(img->groups, shapes, type);
+
+    return shapes;
+}
+
+List* shapeOtherAttributes(void* shape, elementType type){
+
+    if (shape == NULL) return NULL;
+    if (type == RECT) return ((Rectangle*)shape)->otherAttributes;
+    if (type == CIRC) return ((Circle*)shape)->otherAttributes;
+    if (type == PATH) return ((Path*)shape)->otherAttributes;
+    if (type == GROUP) return ((Group*)shape)->otherAttributes;
+    if (type == LINE) return ((Line*)shape)->otherAttributes;
+    if (type == ELLIPSE) return ((Ellipse*)shape)->otherAttributes;
+    if (type == POLYLINE || type == POLYGON) return ((Polyline*)shape)->otherAttributes;
+    return NULL;
+}
+
+// where a line, ellipse, polyline or polygon was read, NULL for the other types
+ElementPlace* shapePlace(void* shape, elementType type){
+
+    if (shape == NULL) return NULL;
+    if (type == LINE) return &((Line*)shape)->place;
+    if (type == ELLIPSE) return &((Ellipse*)shape)->place;
+    if (type == POLYLINE || type == POLYGON) return &((Polyline*)shape)->place;
+    return NULL;
+}
+
+// the number of other attributes in a shape list, like getRectAttrLen
+int getShapeAttrLen(List* list, elementType type){
+
+    if (list == NULL) return 0;
+
+    int count = 0;
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        count += getLength(shapeOtherAttributes(elem, type));
+    }
+
+    return count;
+}
+
+int getShapesAttrLen(List* lines, List* ellipses, List* polylines, List* polygons){
+
+    return getShapeAttrLen(lines, LINE) + getShapeAttrLen(ellipses, ELLIPSE) +
+           getShapeAttrLen(polylines, POLYLINE) + getShapeAttrLen(polygons, POLYGON);
+}
+
+// the number of shapes and groups directly in the group, the length compared by numGroupsWithLen
+int numGroupChildren(const Group* group){
+
+    if (group == NULL) return 0;
+
+    int count = getLength(group->rectangles) + getLength(group->circles) + getLength(group->paths) + getLength(group->groups);
+    if (group->lines != NULL) count += getLength(group->lines);
+    if (group->ellipses != NULL) count += getLength(group->ellipses);
+    if (group->polylines != NULL) count += getLength(group->polylines);
+    if (group->polygons != NULL) count += getLength(group->polygons);
+
+    return count;
+}
+
+// String representation helper functions:
+
+void appendLineString(StringBuilder* builder, const Line* line){
+
+    appendFormat(builder, "x1 = \"%f\"\ny1 = \"%f\"\nx2 = \"%f\"\ny2 = \"%f\"\nunits = \"%s\"\n", line->x1, line->y1, line->x2, line->y2, line->units);
+    appendAttrListString(builder, line->otherAttributes);
+    appendString(builder, "\n");
+}
+
+void appendEllipseString(StringBuilder* builder, const Ellipse* ellipse){
+
+    appendFormat(builder, "cx = \"%f\"\ncy = \"%f\"\nrx = \"%f\"\nry = \"%f\"\nunits = \"%s\"\n", ellipse->cx, ellipse->cy, ellipse->rx, ellipse->ry, ellipse->units);
+    appendAttrListString(builder, ellipse->otherAttributes);
+    appendString(builder, "\n");
+}
+
+void appendPolylineString(StringBuilder* builder, const Polyline* poly){
+
+    appendString(builder, "points = \"");
+    appendPoints(builder, poly, 6);
+    appendString(builder, "\"\n");
+    appendAttrListString(builder, poly->otherAttributes);
+    appendString(builder, "\n");
+}
+
+/*
+    the label, the shapes like appendRectListString and the end, only when the list has shapes,
+    so the string of an svg without any is the same as before they were parsed
+*/
+void appendShapeListString(StringBuilder* builder, List* list, elementType type, const char* label, const char* end){
+
+    if (list == NULL || getLength(list) == 0) return;
+
+    appendString(builder, label);
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        appendString(builder, "\n");
+        if (type == LINE) appendLineString(builder, (Line*)elem);
+        else if (type == ELLIPSE) appendEllipseString(builder, (Ellipse*)elem);
+        else appendPolylineString(builder, (Polyline*)elem);
+    }
+
+    appendString(builder, end);
+}
+
+// writes the points as "x,y x,y ...", each number with formatNumber
+void appendPoints(StringBuilder* builder, const Polyline* poly, int precision){
+
+    char number[SVG_NUMBER_LENGTH];
+
+    for (int i = 0; i < poly->numPoints; ++i){
+        if (i > 0) appendChar(builder, ' ');
+        formatNumber(number, sizeof(number), poly->points[2 * i], precision);
+        appendString(builder, number);
+        appendChar(builder, ',');
+        formatNumber(number, sizeof(number), poly->points[2 * i + 1], precision);
+        appendString(builder, number);
+    }
+}
+
+/*
+    the points attribute of a polyline or polygon, caller must free the string
+    the schema only takes whole numbers for the points, so they are written with SVG_PRECISION_SHORTEST by the
+    writer and the xml tree whatever the precision of the options, any points read from a valid file are written back the same
+*/
+char* pointsToString(const Polyline* poly, int precision){
+
+    if (poly == NULL) return NULL;
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 16 * poly->numPoints + 1) == false) return NULL;
+    appendPoints(&builder, poly, precision);
+    return finishBuilder(&builder);
+}
+
+char* shapeToJSON(void* shape, elementType type){
+
+    if (type == LINE) return lineToJSON((Line*)shape);
+    if (type == ELLIPSE) return ellipseToJSON((Ellipse*)shape);
+    if (type == POLYLINE || type == POLYGON) return polylineToJSON((Polyline*)shape);
+    return NULL;
+}
+
+// a JSON array of the shapes in the list, [] for NULL
+char* shapeListToJSON(const List* list, elementType type){
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 64) == false) return NULL;
+    appendChar(&builder, '[');
+
+    if (list != NULL){
+        int index = 0;
+        void* elem;
+        ListIterator iter = createIterator((List*)list);
+        while ((elem = nextElement(&iter)) != NULL){
+
+            char* currShape = shapeToJSON(elem, type);
+            if (currShape == NULL){
+                freeBuilder(&builder);
+                return NULL; // cannot allocate string
+            }
+
+            if (index > 0) appendChar(&builder, ',');
+            appendString(&builder, currShape);
+            free(currShape);
+            ++index;
+        }
+    }
+
+    appendChar(&builder, ']');
+    return finishBuilder(&builder);
+}
+
+// Functions to check for validity:
+
+// validates single line struct, the coordinates may be negative
+bool validLineStruct(Line* line){
+
+    if (line == NULL) return false;
+
+    if (checkString(line->units) == false) return false;
+    if (checkInvalid(line->x1) == false || checkInvalid(line->y1) == false) return false;
+    if (checkInvalid(line->x2) == false || checkInvalid(line->y2) == false) return false;
+
+    if (line->otherAttributes == NULL) return false;
+    if ((isListEmpty(line->otherAttributes) == 0) && (validAttrListStruct(line->otherAttributes) == false)) return false;
+
+    return true;
+}
+
+// validates single ellipse struct, the radii must be >= 0
+bool validEllipseStruct(Ellipse* ellipse){
+
+    if (ellipse == NULL) return false;
+
+    if (checkString(ellipse->units) == false) return false;
+    if (checkInvalid(ellipse->cx) == false || checkInvalid(ellipse->cy) == false) return false;
+    if (checkRange(ellipse->rx) == false || checkRange(ellipse->ry) == false) return false;
+
+    if (ellipse->otherAttributes == NULL) return false;
+    if ((isListEmpty(ellipse->otherAttributes) == 0) && (validAttrListStruct(ellipse->otherAttributes) == false)) return false;
+
+    return true;
+}
+
+// validates single polyline or polygon struct
+bool validPolylineStruct(Polyline* poly){
+
+    if (poly == NULL) return false;
+
+    if (poly->numPoints < 0) return false;
+    for (int i = 0; i < 2 * poly->numPoints; ++i){
+        if (checkInvalid(poly->points[i]) == false) return false;
+    }
+
+    if (poly->otherAttributes == NULL) return false;
+    if ((isListEmpty(poly->otherAttributes) == 0) && (validAttrListStruct(poly->otherAttributes) == false)) return false;
+
+    return true;
+}
+
+bool validShapeStruct(void* shape, elementType type){
+
+    if (type == LINE) return validLineStruct((Line*)shape);
+    if (type == ELLIPSE) return validEllipseStruct((Ellipse*)shape);
+    if (type == POLYLINE || type == POLYGON) return validPolylineStruct((Polyline*)shape);
+    return false;
+}
+
+// validates the structs in a shape list, a NULL list has no shapes and is valid
+bool validShapeListStruct(List* list, elementType type){
+
+    if (list == NULL) return true;
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        if (validShapeStruct(elem, type) == false) return false;
+    }
+
+    return true;
+}
+
+// Function to write a shape list to a node in the xml tree:
+
+/*
+    given a list of lines, ellipses, polylines or polygons, this function creates a new node for each struct,
+    adds the properties/attributes in the node, and adds that node to the parent node given
+    the list may be NULL
+*/
+void addShapeListToParentNode(List* list, elementType type, xmlNodePtr* parent, bool* valid){
+
+    if (list == NULL || *parent == NULL) return;
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        if (valid != NULL && validShapeStruct(elem, type) == false) *valid = false;
+
+        // 1. the node, added to the parent (svg or group)
+        xmlNodePtr node = xmlNewChild(*parent, NULL, BAD_CAST shapeElementName(type), NULL);
+
+        // 2. adding its contents, in the units of the shape
+        if (type == LINE){
+            Line* line = (Line*) elem;
+            float numbers[4] = { line->x1, line->y1, line->x2, line->y2 };
+            const char* names[4] = { "x1", "y1", "x2", "y2" };
+            for (int i = 0; i < 4; ++i){
+                char* value = unitsWithNumber(numbers[i], line->units);
+                xmlNewProp(node, BAD_CAST names[i], BAD_CAST value);
+                free(value);
+            }
+        }
+        else if (type == ELLIPSE){
+            Ellipse* ellipse = (Ellipse*) elem;
+            float numbers[4] = { ellipse->cx, ellipse->cy, ellipse->rx, ellipse->ry };
+            const char* names[4] = { "cx", "cy", "rx", "ry" };
+            for (int i = 0; i < 4; ++i){
+                char* value = unitsWithNumber(numbers[i], ellipse->units);
+                xmlNewProp(node, BAD_CAST names[i], BAD_CAST value);
+                free(value);
+            }
+        }
+        else{
+            char* points = pointsToString((Polyline*)elem, SVG_PRECISION_SHORTEST);
+            xmlNewProp(node, BAD_CAST "points", BAD_CAST points);
+            free(points);
+        }
+
+        // 3. adding the other attributes
+        addAttrListToParentNode(shapeOtherAttributes(elem, type), &node, valid);
+    }
+}
+
+// Functions to change the shapes:
+
+/*
+    makes room for the number of points, the polyline is reallocated when it has less room, so the caller must replace
+    the polyline pointer wherever it is kept with the one returned
+    @return NULL, with the polyline not changed, if it cannot be reallocated
+*/
+Polyline* reservePoints(Polyline* poly, int numPoints){
+
+    if (poly == NULL || numPoints < 0) return NULL;
+    if (numPoints <= poly->maxPoints) return poly;
+
+    int maxPoints = poly->maxPoints + poly->maxPoints / 2; // grows by half at least, like growCapacity
+    if (maxPoints < numPoints) maxPoints = numPoints;
+
+    Polyline* newPoly = realloc(poly, sizeof(Polyline) + sizeof(float) * 2 * maxPoints);
+    if (newPoly == NULL) return NULL;
+
+    newPoly->maxPoints = maxPoints;
+    return newPoly;
+}
+
+/*
+    like changeValueInRect, sets the attribute of the shape at the index in the list when it is one of its
+    coordinates or sizes, otherwise changes or appends it in the other attributes
+    a polyline with more new points than it has room for is reallocated in its node
+*/
+bool changeValueInShape(List* list, elementType type, int index, Attribute* newAttribute){
+
+    if (list == NULL || newAttribute == NULL) return false;
+
+    Node* node = getNodeAt(list, index);
+    if (node == NULL) return false;
+    void* shape = node->data;
+
+    char* name = newAttribute->name;
+    bool geometry = true;
+    bool valid = false;
+
+    if (type == LINE){
+        Line* line = (Line*) shape;
+        if (strcasecmp(name, "x1") == 0) valid = changeCoor(&(line->x1), newAttribute->value);
+        else if (strcasecmp(name, "y1") == 0) valid = changeCoor(&(line->y1), newAttribute->value);
+        else if (strcasecmp(name, "x2") == 0) valid = changeCoor(&(line->x2), newAttribute->value);
+        else if (strcasecmp(name, "y2") == 0) valid = changeCoor(&(line->y2), newAttribute->value);
+        else geometry = false;
+    }
+    else if (type == ELLIPSE){
+        Ellipse* ellipse = (Ellipse*) shape;
+        if (strcasecmp(name, "cx") == 0) valid = changeCoor(&(ellipse->cx), newAttribute->value);
+        else if (strcasecmp(name, "cy") == 0) valid = changeCoor(&(ellipse->cy), newAttribute->value);
+        else if (strcasecmp(name, "rx") == 0) valid = changeDimen(&(ellipse->rx), newAttribute->value);
+        else if (strcasecmp(name, "ry") == 0) valid = changeDimen(&(ellipse->ry), newAttribute->value);
+        else geometry = false;
+    }
+    else if (type == POLYLINE || type == POLYGON){
+        Polyline* poly = (Polyline*) shape;
+        if (strcasecmp(name, "points") == 0){
+            // the whole value must be pairs of numbers
+            const char* end = NULL;
+            int count = parsePoints(newAttribute->value, NULL, 0, &end);
+            while (end != NULL && isspace((unsigned char)*end)) ++end;
+            if (count % 2 == 0 && end != NULL && *end == '\0'){
+                poly = reservePoints(poly, count / 2);
+                if (poly != NULL){
+                    node->data = poly;
+                    poly->numPoints = parsePoints(newAttribute->value, poly->points, count, NULL) / 2;
+                    valid = true;
+                }
+            }
+        }
+        else geometry = false;
+    }
+    else{
+        return false;
+    }
+
+    // changeValueInAttr is in charge of freeing the attribute depending on whether it is changed or appended
+    if (geometry == false) return changeValueInAttr(shapeOtherAttributes(shape, type), newAttribute);
+
+    if (valid == false) return false;
+    deleteAttribute((void*) newAttribute);
+    return true;
+}
+
+/*
+    scales the size of a shape and keeps where it starts, the same way scaleRectangles scales the width and height:
+    a line keeps its first point, a polyline or polygon keeps its first point, and an ellipse keeps its center
+    rectangles and circles are scaled here too, so one function can scale any shape except paths, see scalePathData
+*/
+void scaleShape(void* shape, elementType type, float scaleValue){
+
+    if (shape == NULL) return;
+
+    if (type == RECT){
+        Rectangle* rect = (Rectangle*) shape;
+        rect->width = rect->width * scaleValue;
+        rect->height = rect->height * scaleValue;
+    }
+    else if (type == CIRC){
+        Circle* circ = (Circle*) shape;
+        circ->r = circ->r * scaleValue;
+    }
+    else if (type == LINE){
+        Line* line = (Line*) shape;
+        line->x2 = line->x1 + (line->x2 - line->x1) * scaleValue;
+        line->y2 = line->y1 + (line->y2 - line->y1) * scaleValue;
+    }
+    else if (type == ELLIPSE){
+        Ellipse* ellipse = (Ellipse*) shape;
+        ellipse->rx = ellipse->rx * scaleValue;
+        ellipse->ry = ellipse->ry * scaleValue;
+    }
+    else if (type == POLYLINE || type == POLYGON){
+        Polyline* poly = (Polyline*) shape;
+        for (int i = 1; i < poly->numPoints; ++i){
+            poly->points[2 * i] = poly->points[0] + (poly->points[2 * i] - poly->points[0]) * scaleValue;
+            poly->points[2 * i + 1] = poly->points[1] + (poly->points[2 * i + 1] - poly->points[1]) * scaleValue;
+        }
+    }
+}
+
+// scales every shape of the type in the svg and its groups, the svg must be validated after
+bool scaleShapes(SVG* img, elementType type, float scaleValue){
+
+    if (img == NULL) return false;
+
+    AreaChange areaChange;
+    PathChange pathChange;
+    beginAreaChange(img, type, NULL, &areaChange);
+    beginPathChange(img, type, NULL, &pathChange);
+    touchSVG(img);
+
+    // the paths are written again from their commands, so they are scaled in their lists
+    if (type == PATH){
+        bool valid = scalePathList(img->paths, scaleValue) && scaleGroupPaths(img->groups, scaleValue);
+        endAreaChange(&areaChange); // the areas of the rectangles and circles are the same
+        pathChange.current = false; // every path has new data, the counts are made again when they are next queried
+        endPathChange(&pathChange);
+        return valid;
+    }
+    endPathChange(&pathChange); // the data of the paths are the same
+
+    List* shapes = NULL;
+    if (type == RECT) shapes = getRects(img);
+    else if (type == CIRC) shapes = getCircles(img);
+    else if (type == LINE || type == ELLIPSE || type == POLYLINE || type == POLYGON) shapes = getShapes(img, type);
+    if (shapes == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(shapes);
+    while ((elem = nextElement(&iter)) != NULL){
+        scaleShape(elem, type, scaleValue);
+    }
+    freeList(shapes);
+
+    // every shape of the type has a new area, so the type is counted again in the area histogram
+    if ((type == RECT || type == CIRC) && areaChange.current) areaChange.current = recountAreas(img, type);
+    endAreaChange(&areaChange);
+    return true;
+}
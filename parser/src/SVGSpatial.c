@@ -0,0 +1,672 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGShapes.h"
+#include "SVGTransform.h"
+#include "SVGElementPath.h"
+#include "SVGStringBuilder.h"
+#include "SVGBounds.h"
+#include "SVGSpatial.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
+
+// the attributes that move or resize a shape, a change to any other attribute keeps the index
+static const char* geometryAttributes[] = {"x", "y", "width", "height", "cx", "cy", "r", "rx", "ry", "x1", "y1", "x2", "y2", "points", "d", "transform"};
+
+// an entry or a node with its box, while the tree is packed or a node is split
+typedef struct {
+    Bounds box;
+    float centreX;
+    float centreY;
+    int entry;
+    SpatialNode* node;
+} PackItem;
+
+// marks a change to the geometry of the shapes, the index is made again when it is next queried
+void touchSVG(SVG* img){
+
+    if (img != NULL) ++img->version;
+}
+
+bool geometryAttribute(const char* name){
+
+    if (name == NULL) return true;
+
+    for (size_t i = 0; i < sizeof(geometryAttributes) / sizeof(geometryAttributes[0]); ++i){
+        if (strcasecmp(name, geometryAttributes[i]) == 0) return true;
+    }
+
+    return false;
+}
+
+/*
+    called after a shape was added to the end of its list in the group, or in the svg when the group is NULL
+    the shape is inserted into the index when it was up to date, so adding shapes does not make it again
+*/
+void shapeAdded(SVG* img, Group* group, elementType type, void* element){
+
+    if (img == NULL) return;
+
+    bool current = (img->spatial != NULL && img->spatial->version == img->version);
+    bool areasCurrent = areaIndexCurrent(img);
+    bool pathsCurrent = pathCountsCurrent(img);
+    touchSVG(img);
+
+    countShapeArea(img, type, element, areasCurrent);
+    countPathData(img, type, element, pathsCurrent);
+    if (current == false) return;
+
+    // 1. every group was put in the index when it was made, even the groups with no shapes
+    SpatialIndex* index = img->spatial;
+    int groupIndex = -1;
+    for (int i = 0; i < index->numGroups && groupIndex < 0; ++i){
+        if (index->groups[i].group == group) groupIndex = i;
+    }
+
+    // 2. the shape is the last of its list
+    List* list = containerList(img, group, type);
+    if (groupIndex < 0 || list == NULL) return;
+
+    if (insertSpatialEntry(index, groupIndex, type, getLength(list) - 1, element)) index->version = img->version;
+}
+
+static SpatialNode* newSpatialNode(bool leaf){
+
+    SpatialNode* node = malloc(sizeof(SpatialNode));
+    if (node == NULL) return NULL;
+
+    emptyBounds(&node->box);
+    node->leaf = leaf;
+    node->count = 0;
+    return node;
+}
+
+static void addNodeChild(SpatialNode* node, const PackItem* item){
+
+    if (node->leaf) node->children.entries[node->count] = item->entry;
+    else node->children.nodes[node->count] = item->node;
+
+    ++node->count;
+    unionBounds(&node->box, &item->box);
+}
+
+static void setPackItem(PackItem* item, const Bounds* box, int entry, SpatialNode* node){
+
+    item->box = *box;
+    item->centreX = (box->minX + box->maxX) / 2;
+    item->centreY = (box->minY + box->maxY) / 2;
+    item->entry = entry;
+    item->node = node;
+}
+
+static int compareCentreX(const void* first, const void* second){
+
+    float a = ((const PackItem*)first)->centreX;
+    float b = ((const PackItem*)second)->centreX;
+    return (a > b) - (a < b);
+}
+
+static int compareCentreY(const void* first, const void* second){
+
+    float a = ((const PackItem*)first)->centreY;
+    float b = ((const PackItem*)second)->centreY;
+    return (a > b) - (a < b);
+}
+
+static int compareInts(const void* first, const void* second){
+
+    int a = *(const int*)first;
+    int b = *(const int*)second;
+    return (a > b) - (a < b);
+}
+
+/*
+    packs one level of the tree by sort-tile-recursive, the items are sorted by x into slices of
+    slices * SPATIAL_NODE_SIZE items, every slice by y, and every run of SPATIAL_NODE_SIZE items is a node
+    @return the nodes, which the caller must free (not the nodes in it), or NULL if they cannot be allocated
+*/
+static SpatialNode** packLevel(PackItem* items, int count, bool leaf, int* numNodes){
+
+    int nodes = (count + SPATIAL_NODE_SIZE - 1) / SPATIAL_NODE_SIZE;
+    int slices = (int)ceil(sqrt((double)nodes));
+    int sliceSize = slices * SPATIAL_NODE_SIZE;
+
+    SpatialNode** level = malloc(sizeof(SpatialNode*) * (nodes > 0 ? nodes : 1));
+    if (level == NULL) return NULL;
+
+    qsort(items, count, sizeof(PackItem), compareCentreX);
+
+    *numNodes = 0;
+    for (int start = 0; start < count; start += sliceSize){
+        int sliceCount = (count - start < sliceSize) ? count - start : sliceSize;
+        qsort(items + start, sliceCount, sizeof(PackItem), compareCentreY);
+
+        for (int i = 0; i < sliceCount; ++i){
+            if (i % SPATIAL_NODE_SIZE == 0){
+                SpatialNode* node = newSpatialNode(leaf);
+                if (node == NULL){
+                    for (int j = 0; j < *numNodes; ++j) deleteSpatialNode(level[j]);
+                    free(level);
+                    return NULL;
+                }
+                level[(*numNodes)++] = node;
+            }
+            addNodeChild(level[*numNodes - 1], &items[start + i]);
+        }
+    }
+
+    return level;
+}
+
+// packs the entries that have a box into a tree, from the leaves up to one root
+static SpatialNode* packSpatialTree(const SpatialIndex* index){
+
+    PackItem* items = malloc(sizeof(PackItem) * (index->numEntries > 0 ? index->numEntries : 1));
+    if (items == NULL) return NULL;
+
+    // 1. the leaves, a shape with nothing to draw cannot be found by a query and is left out
+    int count = 0;
+    for (int i = 0; i < index->numEntries; ++i){
+        if (boundsEmpty(&index->entries[i].box) == false) setPackItem(&items[count++], &index->entries[i].box, i, NULL);
+    }
+    if (count == 0){
+        free(items);
+        return newSpatialNode(true);
+    }
+
+    int numNodes;
+    SpatialNode** level = packLevel(items, count, true, &numNodes);
+
+    // 2. every level above has one node for every SPATIAL_NODE_SIZE nodes of the level below
+    while (level != NULL && numNodes > 1){
+        for (int i = 0; i < numNodes; ++i) setPackItem(&items[i], &level[i]->box, -1, level[i]);
+        count = numNodes;
+        free(level);
+
+        level = packLevel(items, count, false, &numNodes);
+        if (level == NULL){
+            // the nodes of the level below are still in items
+            for (int i = 0; i < count; ++i) deleteSpatialNode(items[i].node);
+        }
+    }
+    free(items);
+    if (level == NULL) return NULL;
+
+    SpatialNode* root = level[0];
+    free(level);
+    return root;
+}
+
+static int addSpatialGroup(SpatialIndex* index, Group* group, const char* path, const float matrix[6]){
+
+    if (index->numGroups == index->maxGroups){
+        int maxGroups = (index->maxGroups == 0) ? 8 : index->maxGroups * 2;
+        SpatialGroup* groups = realloc(index->groups, sizeof(SpatialGroup) * maxGroups);
+        if (groups == NULL) return -1;
+        index->groups = groups;
+        index->maxGroups = maxGroups;
+    }
+
+    SpatialGroup* spatialGroup = &index->groups[index->numGroups];
+    spatialGroup->path = malloc(strlen(path) + 1);
+    if (spatialGroup->path == NULL) return -1;
+
+    strcpy(spatialGroup->path, path);
+    spatialGroup->group = group;
+    memcpy(spatialGroup->matrix, matrix, sizeof(float) * 6);
+
+    return index->numGroups++;
+}
+
+static bool addSpatialEntry(SpatialIndex* index, int group, elementType type, int elementIndex, void* element){
+
+    if (index->numEntries == index->maxEntries){
+        int maxEntries = (index->maxEntries == 0) ? 64 : index->maxEntries * 2;
+        SpatialEntry* entries = realloc(index->entries, sizeof(SpatialEntry) * maxEntries);
+        if (entries == NULL) return false;
+        index->entries = entries;
+        index->maxEntries = maxEntries;
+    }
+
+    // the box of the shape in its own numbers, moved by its transform and the transforms of its groups
+    SpatialEntry* entry = &index->entries[index->numEntries++];
+    Bounds local;
+    shapeBounds(element, type, &local);
+    elementMatrix(shapeOtherAttributes(element, type), index->groups[group].matrix, entry->matrix);
+    transformBounds(&local, entry->matrix, &entry->box);
+
+    entry->type = type;
+    entry->index = elementIndex;
+    entry->group = group;
+    entry->element = element;
+    return true;
+}
+
+// adds the shapes of the svg or the group, then its groups one after the other
+static bool indexContainer(SpatialIndex* index, SVG* img, Group* group, const char* path, const float matrix[6]){
+
+    int groupIndex = addSpatialGroup(index, group, path, matrix);
+    if (groupIndex < 0) return false;
+
+    // 1. the shapes, in the order of the types
+    for (elementType type = CIRC; type <= POLYGON; ++type){
+        if (type == GROUP) continue;
+
+        List* list = containerList(img, group, type);
+        if (list == NULL) continue;
+
+        int elementIndex = 0;
+        void* elem;
+        ListIterator iter = createIterator(list);
+        while ((elem = nextElement(&iter)) != NULL){
+            if (addSpatialEntry(index, groupIndex, type, elementIndex++, elem) == false) return false;
+        }
+    }
+
+    // 2. the groups, with their transforms after the transforms of the groups they are in
+    List* groups = (group == NULL) ? img->groups : group->groups;
+    if (groups == NULL) return true;
+
+    int child = 0;
+    void* elem;
+    ListIterator iter = createIterator(groups);
+    while ((elem = nextElement(&iter)) != NULL){
+        Group* childGroup = (Group*)elem;
+        float childMatrix[6];
+        elementMatrix(childGroup->otherAttributes, matrix, childMatrix);
+
+        char* childPath = malloc(strlen(path) + 16);
+        if (childPath == NULL) return false;
+        sprintf(childPath, "%s%sg%d", path, (path[0] == '\0') ? "" : "/", child++);
+
+        bool valid = indexContainer(index, img, childGroup, childPath, childMatrix);
+        free(childPath);
+        if (valid == false) return false;
+    }
+
+    return true;
+}
+
+// makes the index of the svg as it is now, the caller keeps it in the svg or frees it with deleteSpatialIndex
+SpatialIndex* buildSpatialIndex(SVG* img){
+
+    if (img == NULL) return NULL;
+
+    SpatialIndex* index = calloc(1, sizeof(SpatialIndex));
+    if (index == NULL) return NULL;
+    index->version = img->version;
+
+    float identity[6];
+    identityMatrix(identity);
+
+    if (indexContainer(index, img, NULL, "", identity) == false || (index->root = packSpatialTree(index)) == NULL){
+        deleteSpatialIndex(index);
+        return NULL;
+    }
+
+    return index;
+}
+
+// the index of the svg, made again when a change to the svg since it was made has made it out of date
+SpatialIndex* getSpatialIndex(SVG* img){
+
+    if (img == NULL) return NULL;
+    if (img->spatial != NULL && img->spatial->version == img->version) return img->spatial;
+
+    deleteSpatialIndex(img->spatial);
+    img->spatial = buildSpatialIndex(img);
+    return img->spatial;
+}
+
+static float boundsArea(const Bounds* bounds){
+
+    if (boundsEmpty(bounds)) return 0;
+    return (bounds->maxX - bounds->minX) * (bounds->maxY - bounds->minY);
+}
+
+/*
+    splits a full node and the item that did not fit by the middle of their centres along the longer side of
+    their box, the node keeps the first half
+    @return the node with the second half, or NULL if it cannot be allocated
+*/
+static SpatialNode* splitSpatialNode(SpatialNode* node, const PackItem* extra, const SpatialEntry* entries){
+
+    SpatialNode* sibling = newSpatialNode(node->leaf);
+    if (sibling == NULL) return NULL;
+
+    // 1. the children and the new item
+    PackItem items[SPATIAL_NODE_SIZE + 1];
+    Bounds all = node->box;
+    for (int i = 0; i < node->count; ++i){
+        if (node->leaf) setPackItem(&items[i], &entries[node->children.entries[i]].box, node->children.entries[i], NULL);
+        else setPackItem(&items[i], &node->children.nodes[i]->box, -1, node->children.nodes[i]);
+    }
+    items[node->count] = *extra;
+    unionBounds(&all, &extra->box);
+
+    // 2. the halves
+    int count = node->count + 1;
+    qsort(items, count, sizeof(PackItem), (all.maxX - all.minX >= all.maxY - all.minY) ? compareCentreX : compareCentreY);
+
+    node->count = 0;
+    emptyBounds(&node->box);
+    for (int i = 0; i < count; ++i){
+        addNodeChild((i < count / 2) ? node : sibling, &items[i]);
+    }
+
+    return sibling;
+}
+
+/*
+    inserts the item under the node, through the child whose box grows the least
+    @return the new node when the node was split, which the caller adds next to it, or NULL
+*/
+static SpatialNode* insertSpatialItem(SpatialNode* node, const PackItem* item, const SpatialEntry* entries, bool* failed){
+
+    // 1. a leaf takes the entry, an inner node takes a node that was split below it
+    if (node->leaf == false){
+        int best = 0;
+        float bestGrowth = INFINITY;
+        float bestArea = INFINITY;
+        for (int i = 0; i < node->count; ++i){
+            Bounds grown = node->children.nodes[i]->box;
+            unionBounds(&grown, &item->box);
+            float area = boundsArea(&node->children.nodes[i]->box);
+            float growth = boundsArea(&grown) - area;
+            if (growth < bestGrowth || (growth == bestGrowth && area < bestArea)){
+                best = i;
+                bestGrowth = growth;
+                bestArea = area;
+            }
+        }
+
+        SpatialNode* split = insertSpatialItem(node->children.nodes[best], item, entries, failed);
+        unionBounds(&node->box, &item->box);
+        if (split == NULL) return NULL;
+
+        PackItem splitItem;
+        setPackItem(&splitItem, &split->box, -1, split);
+        if (node->count < SPATIAL_NODE_SIZE){
+            addNodeChild(node, &splitItem);
+            return NULL;
+        }
+
+        // the children were split across two nodes, so the box of this one is found again
+        SpatialNode* sibling = splitSpatialNode(node, &splitItem, entries);
+        if (sibling == NULL){
+            deleteSpatialNode(split);
+            *failed = true;
+        }
+        return sibling;
+    }
+
+    // 2. the entry fits in the leaf, or the leaf is split
+    if (node->count < SPATIAL_NODE_SIZE){
+        addNodeChild(node, item);
+        return NULL;
+    }
+
+    SpatialNode* sibling = splitSpatialNode(node, item, entries);
+    if (sibling == NULL) *failed = true;
+    return sibling;
+}
+
+/*
+    adds a shape to the entries and to the tree, the group is an index into the groups of the index
+    @return false if it cannot be allocated, the index must then be made again
+*/
+bool insertSpatialEntry(SpatialIndex* index, int group, elementType type, int elementIndex, void* element){
+
+    if (index == NULL || index->root == NULL || group < 0 || group >= index->numGroups) return false;
+    if (addSpatialEntry(index, group, type, elementIndex, element) == false) return false;
+
+    int entry = index->numEntries - 1;
+    if (boundsEmpty(&index->entries[entry].box)) return true;
+
+    PackItem item;
+    setPackItem(&item, &index->entries[entry].box, entry, NULL);
+
+    // 1. the tree grows at the root, when the root was split
+    bool failed = false;
+    SpatialNode* split = insertSpatialItem(index->root, &item, index->entries, &failed);
+    if (split != NULL){
+        SpatialNode* root = newSpatialNode(false);
+        if (root == NULL){
+            deleteSpatialNode(split);
+            return false;
+        }
+
+        PackItem rootItem;
+        setPackItem(&rootItem, &index->root->box, -1, index->root);
+        addNodeChild(root, &rootItem);
+        setPackItem(&rootItem, &split->box, -1, split);
+        addNodeChild(root, &rootItem);
+        index->root = root;
+    }
+
+    return failed == false;
+}
+
+void deleteSpatialNode(SpatialNode* node){
+
+    if (node == NULL) return;
+
+    if (node->leaf == false){
+        for (int i = 0; i < node->count; ++i) deleteSpatialNode(node->children.nodes[i]);
+    }
+    free(node);
+}
+
+void deleteSpatialIndex(SpatialIndex* index){
+
+    if (index == NULL) return;
+
+    for (int i = 0; i < index->numGroups; ++i) free(index->groups[i].path);
+    free(index->groups);
+    free(index->entries);
+    deleteSpatialNode(index->root);
+    free(index);
+}
+
+// the result array, grown by doubling like the StringBuilder
+typedef struct {
+    int* entries;
+    int count;
+    int capacity;
+    bool failed;
+} SpatialResult;
+
+static void addResult(SpatialResult* result, int entry){
+
+    if (result->failed) return;
+
+    if (result->count == result->capacity){
+        int capacity = (result->capacity == 0) ? 16 : result->capacity * 2;
+        int* entries = realloc(result->entries, sizeof(int) * capacity);
+        if (entries == NULL){
+            result->failed = true;
+            return;
+        }
+        result->entries = entries;
+        result->capacity = capacity;
+    }
+
+    result->entries[result->count++] = entry;
+}
+
+// the entries under the node whose boxes meet the region, or that the point hits when region is a point
+static void searchSpatialNode(const SpatialIndex* index, const SpatialNode* node, const Bounds* region, bool point, SpatialResult* result){
+
+    if (boundsIntersect(&node->box, region) == false) return;
+
+    for (int i = 0; i < node->count; ++i){
+        if (node->leaf == false){
+            searchSpatialNode(index, node->children.nodes[i], region, point, result);
+            continue;
+        }
+
+        int entry = node->children.entries[i];
+        if (boundsIntersect(&index->entries[entry].box, region) == false) continue;
+        if (point && entryHit(&index->entries[entry], region->minX, region->minY) == false) continue;
+        addResult(result, entry);
+    }
+}
+
+// the result in the order of the entries, the shapes of the svg first, then the shapes of every group in order
+static int* finishResult(SpatialResult* result, int* count){
+
+    if (result->failed){
+        free(result->entries);
+        return NULL;
+    }
+
+    if (result->count > 1) qsort(result->entries, result->count, sizeof(int), compareInts);
+    *count = result->count;
+
+    // an empty result is not NULL, so it is not taken as a failure
+    return (result->entries != NULL) ? result->entries : calloc(1, sizeof(int));
+}
+
+/*
+    the shapes whose boxes meet the region, the edges count
+    @return the indices of their entries in getSpatialIndex(img), which the caller must free, or NULL if the index
+    cannot be made
+*/
+int* queryRegion(SVG* img, const Bounds* region, int* count){
+
+    if (img == NULL || region == NULL || count == NULL) return NULL;
+
+    SpatialIndex* index = getSpatialIndex(img);
+    if (index == NULL) return NULL;
+
+    SpatialResult result = {NULL, 0, 0, false};
+    searchSpatialNode(index, index->root, region, false, &result);
+    return finishResult(&result, count);
+}
+
+// the shapes under the point, like queryRegion
+int* hitTest(SVG* img, float x, float y, int* count){
+
+    if (img == NULL || count == NULL) return NULL;
+
+    SpatialIndex* index = getSpatialIndex(img);
+    if (index == NULL) return NULL;
+
+    Bounds point = {x, y, x, y};
+    SpatialResult result = {NULL, 0, 0, false};
+    searchSpatialNode(index, index->root, &point, true, &result);
+    return finishResult(&result, count);
+}
+
+/*
+    true if the point is on the shape, the point is moved back into the numbers of the shape so a rectangle,
+    circle or ellipse is tested exactly even when it is rotated, and the other shapes are tested against their box
+*/
+bool entryHit(const SpatialEntry* entry, float x, float y){
+
+    if (boundsContain(&entry->box, x, y) == false) return false;
+
+    float inverse[6];
+    if (invertMatrix(entry->matrix, inverse) == false) return true;
+
+    float point[2] = {x, y};
+    transformPoints(inverse, point, 1);
+
+    if (entry->type == RECT){
+        Rectangle* rect = (Rectangle*)entry->element;
+        return point[0] >= rect->x && point[0] <= rect->x + rect->width && point[1] >= rect->y && point[1] <= rect->y + rect->height;
+    }
+    if (entry->type == CIRC){
+        Circle* circle = (Circle*)entry->element;
+        float dx = point[0] - circle->cx;
+        float dy = point[1] - circle->cy;
+        return dx * dx + dy * dy <= circle->r * circle->r;
+    }
+    if (entry->type == ELLIPSE){
+        Ellipse* ellipse = (Ellipse*)entry->element;
+        if (ellipse->rx <= 0 || ellipse->ry <= 0) return false;
+        float dx = (point[0] - ellipse->cx) / ellipse->rx;
+        float dy = (point[1] - ellipse->cy) / ellipse->ry;
+        return dx * dx + dy * dy <= 1;
+    }
+
+    Bounds local;
+    shapeBounds(entry->element, entry->type, &local);
+    return boundsContain(&local, point[0], point[1]);
+}
+
+// the element path of the entry, like "g0/g2/rect3", which the caller must free
+char* spatialEntryPath(const SpatialIndex* index, int entry){
+
+    if (index == NULL || entry < 0 || entry >= index->numEntries) return NULL;
+
+    const SpatialEntry* spatialEntry = &index->entries[entry];
+    const char* groupPath = index->groups[spatialEntry->group].path;
+    const char* name = pathElementName(spatialEntry->type);
+
+    char* path = malloc(strlen(groupPath) + strlen(name) + 16);
+    if (path == NULL) return NULL;
+
+    sprintf(path, "%s%s%s%d", groupPath, (groupPath[0] == '\0') ? "" : "/", name, spatialEntry->index);
+    return path;
+}
+
+// [{"path":"g0/rect1","type":"rect","bounds":{"x":1.00,"y":2.00,"w":3.00,"h":4.00}},...]
+char* spatialResultToJSON(const SpatialIndex* index, const int* entries, int count){
+
+    if (index == NULL || entries == NULL) return NULL;
+
+    StringBuilder builder;
+    if (initBuilder(&builder, 64 + 96 * count) == false) return NULL;
+    appendChar(&builder, '[');
+
+    for (int i = 0; i < count; ++i){
+        char* path = spatialEntryPath(index, entries[i]);
+        if (path == NULL){
+            freeBuilder(&builder);
+            return NULL;
+        }
+
+        appendFormat(&builder, "%s{\"path\":\"%s\",\"type\":\"%s\",\"bounds\":", (i == 0) ? "" : ",", path, pathElementName(index->entries[entries[i]].type));
+        appendBoundsJSON(&builder, &index->entries[entries[i]].box);
+        appendChar(&builder, '}');
+        free(path);
+    }
+
+    appendChar(&builder, ']');
+    return finishBuilder(&builder);
+}
+
+// the shapes that meet the rectangle, as the JSON of spatialResultToJSON
+char* queryRegionToJSON(SVG* img, float x, float y, float width, float height){
+
+    if (width < 0 || height < 0) return NULL;
+
+    Bounds region = {x, y, x + width, y + height};
+    int count;
+    int* entries = queryRegion(img, &region, &count);
+    if (entries == NULL) return NULL;
+
+    char* json = spatialResultToJSON(img->spatial, entries, count);
+    free(entries);
+    return json;
+}
+
+// the shapes under the point, as the JSON of spatialResultToJSON
+char* hitTestToJSON(SVG* img, float x, float y){
+
+    int count;
+    int* entries = hitTest(img, x, y, &count);
+    if (entries == NULL) return NULL;
+
+    char* json = spatialResultToJSON(img->spatial, entries, count);
+    free(entries);
+    return json;
+}
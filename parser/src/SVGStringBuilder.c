@@ -0,0 +1,208 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SVGStringBuilder.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+bool initBuilder(StringBuilder* builder, size_t capacity){
+
+    if (builder == NULL) return false;
+
+    if (capacity < 16) capacity = 16;
+
+    builder->data = malloc(capacity);
+    builder->length = 0;
+    builder->capacity = capacity;
+    builder->failed = (builder->data == NULL);
+    if (builder->failed) return false;
+
+    builder->data[0] = '\0';
+    return true;
+}
+
+// makes sure there is room for extra more characters and the \0
+bool reserveBuilder(StringBuilder* builder, size_t extra){
+
+    if (builder->failed) return false;
+
+    size_t needed = builder->length + extra + 1;
+    if (needed <= builder->capacity) return true;
+
+    size_t capacity = builder->capacity;
+    while (capacity < needed) capacity *= 2;
+
+    char* data = realloc(builder->data, capacity);
+    if (data == NULL){
+        builder->failed = true;
+        return false;
+    }
+
+    builder->data = data;
+    builder->capacity = capacity;
+    return true;
+}
+
+void appendBytes(StringBuilder* builder, const char* bytes, size_t length){
+
+    if (reserveBuilder(builder, length) == false) return;
+
+    memcpy(builder->data + builder->length, bytes, length);
+    builder->length += length;
+    builder->data[builder->length] = '\0';
+}
+
+void appendString(StringBuilder* builder, const char* string){
+
+    appendBytes(builder, string, strlen(string));
+}
+
+void appendChar(StringBuilder* builder, char c){
+
+    if (reserveBuilder(builder, 1) == false) return;
+
+    builder->data[builder->length++] = c;
+    builder->data[builder->length] = '\0';
+}
+
+// printf into the builder, formats straight into the free space and only grows when it does not fit
+void appendFormat(StringBuilder* builder, const char* format, ...){
+
+    if (builder->failed) return;
+
+    va_list args;
+    va_start(args, format);
+    size_t space = builder->capacity - builder->length;
+    int length = vsnprintf(builder->data + builder->length, space, format, args);
+    va_end(args);
+
+    if (length < 0){
+        builder->data[builder->length] = '\0';
+        builder->failed = true;
+        return;
+    }
+
+    if ((size_t)length >= space){
+        // did not fit, grow and format again
+        builder->data[builder->length] = '\0';
+        if (reserveBuilder(builder, length) == false) return;
+
+        va_start(args, format);
+        vsnprintf(builder->data + builder->length, length + 1, format, args);
+        va_end(args);
+    }
+
+    builder->length += length;
+}
+
+char* finishBuilder(StringBuilder* builder){
+
+    if (builder->failed){
+        freeBuilder(builder);
+        return NULL;
+    }
+
+    char* string = builder->data;
+    builder->data = NULL;
+    builder->length = 0;
+    builder->capacity = 0;
+    return string;
+}
+
+void freeBuilder(StringBuilder* builder){
+
+    free(builder->data);
+    builder->data = NULL;
+    builder->length = 0;
+    builder->capacity = 0;
+}
+
+/*
+    returns the number of characters at the start of the string that can be copied into a JSON string as they are,
+    the characters that must be escaped are the quote, the backslash, and the control characters below 0x20
+    32 (AVX2) or 16 (SSE2) characters are checked at a time, and the rest one at a time
+*/
+size_t cleanJSONSpan(const char* string, size_t length){
+
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    while (i + 32 <= length){
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(string + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk)); // chunk <= 0x1F
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+        if (mask != 0) return i + __builtin_ctz(mask);
+        i += 32;
+    }
+#elif defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (i + 16 <= length){
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(string + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk)); // chunk <= 0x1F
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+        if (mask != 0) return i + __builtin_ctz(mask);
+        i += 16;
+    }
+#endif
+
+    while (i < length){
+        unsigned char c = (unsigned char)string[i];
+        if (c == '"' || c == '\\' || c < 0x20) return i;
+        ++i;
+    }
+
+    return length;
+}
+
+/*
+    appends the contents of a JSON string (without the surrounding quotes), the clean spans between the
+    characters that need escaping are copied with a single memcpy each
+*/
+void appendJSONEscaped(StringBuilder* builder, const char* string, size_t length){
+
+    // reserve for the common case of nothing to escape, escapes grow the builder as needed
+    if (reserveBuilder(builder, length) == false) return;
+
+    size_t i = 0;
+    while (i < length){
+
+        // 1. copy everything up to the next character that needs escaping
+        size_t span = cleanJSONSpan(string + i, length - i);
+        appendBytes(builder, string + i, span);
+        i += span;
+        if (i == length) break;
+
+        // 2. escape the character
+        unsigned char c = (unsigned char)string[i];
+        switch (c){
+            case '"': appendBytes(builder, "\\\"", 2); break;
+            case '\\': appendBytes(builder, "\\\\", 2); break;
+            case '\n': appendBytes(builder, "\\n", 2); break;
+            case '\r': appendBytes(builder, "\\r", 2); break;
+            case '\t': appendBytes(builder, "\\t", 2); break;
+            case '\b': appendBytes(builder, "\\b", 2); break;
+            case '\f': appendBytes(builder, "\\f", 2); break;
+            default: appendFormat(builder, "\\u%04x", c); break;
+        }
+        ++i;
+    }
+}
+
+void appendJSONString(StringBuilder* builder, const char* string){
+
+    appendJSONEscaped(builder, string, strlen(string));
+}
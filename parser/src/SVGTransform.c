@@ -0,0 +1,645 @@
+// Name: Haifaa Abushaaban
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelper.h"
+#include "SVGFormat.h"
+#include "SVGShapes.h"
+#include "SVGStringBuilder.h"
+#include "SVGPathData.h"
+#include "SVGTransform.h"
+#include "SVGSpatial.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void identityMatrix(float matrix[6]){
+
+    matrix[0] = 1;
+    matrix[1] = 0;
+    matrix[2] = 0;
+    matrix[3] = 1;
+    matrix[4] = 0;
+    matrix[5] = 0;
+}
+
+// result is first * second, the matrix that moves by second and then by first. result may be first or second
+void multiplyMatrix(const float first[6], const float second[6], float result[6]){
+
+    float product[6];
+    product[0] = first[0] * second[0] + first[2] * second[1];
+    product[1] = first[1] * second[0] + first[3] * second[1];
+    product[2] = first[0] * second[2] + first[2] * second[3];
+    product[3] = first[1] * second[2] + first[3] * second[3];
+    product[4] = first[0] * second[4] + first[2] * second[5] + first[4];
+    product[5] = first[1] * second[4] + first[3] * second[5] + first[5];
+
+    memcpy(result, product, sizeof(product));
+}
+
+// @return false if the matrix flattens the shapes to a line or a point, and has no inverse
+bool invertMatrix(const float matrix[6], float result[6]){
+
+    float det = matrix[0] * matrix[3] - matrix[1] * matrix[2];
+    if (det == 0 || isfinite(det) == 0) return false;
+
+    float inverse[6];
+    inverse[0] = matrix[3] / det;
+    inverse[1] = -matrix[1] / det;
+    inverse[2] = -matrix[2] / det;
+    inverse[3] = matrix[0] / det;
+    inverse[4] = (matrix[2] * matrix[5] - matrix[3] * matrix[4]) / det;
+    inverse[5] = (matrix[1] * matrix[4] - matrix[0] * matrix[5]) / det;
+
+    memcpy(result, inverse, sizeof(inverse));
+    return true;
+}
+
+// the rotate(angle) of svg, in degrees, a multiple of 90 degrees gives exact 0s and 1s so the rectangles can still be moved
+void rotationMatrix(float angle, float matrix[6]){
+
+    identityMatrix(matrix);
+
+    float cosine;
+    float sine;
+    float quarters = angle / 90;
+    if (quarters == floorf(quarters) && fabsf(quarters) < 1e6){
+        const float cosines[4] = {1, 0, -1, 0};
+        int quarter = (((int)quarters % 4) + 4) % 4;
+        cosine = cosines[quarter];
+        sine = cosines[(quarter + 3) % 4];
+    }
+    else {
+        double radians = angle * SVG_PI / 180;
+        cosine = (float)cos(radians);
+        sine = (float)sin(radians);
+    }
+
+    matrix[0] = cosine;
+    matrix[1] = sine;
+    matrix[2] = -sine;
+    matrix[3] = cosine;
+}
+
+// the matrix that scales, then rotates about the origin, then translates
+void composeMatrix(float translateX, float translateY, float angle, float scaleValue, float matrix[6]){
+
+    float rotation[6];
+    rotationMatrix(angle, rotation);
+
+    float scale[6];
+    identityMatrix(scale);
+    scale[0] = scaleValue;
+    scale[3] = scaleValue;
+
+    multiplyMatrix(rotation, scale, matrix);
+    matrix[4] += translateX;
+    matrix[5] += translateY;
+}
+
+/*
+    reads a transform attribute, like "translate(10 20) rotate(45)", into one matrix
+    @return false if the text is not a list of matrix, translate, scale, rotate, skewX and skewY
+*/
+bool parseTransform(const char* transform, float matrix[6]){
+
+    if (transform == NULL || matrix == NULL) return false;
+
+    identityMatrix(matrix);
+    const char* c = transform;
+
+    while (true){
+
+        // 1. the spaces and commas between the transforms
+        while (pathSpace(*c) || *c == ',') ++c;
+        if (*c == '\0') return true;
+
+        // 2. the name
+        char name[16];
+        int nameLength = 0;
+        while (isalpha((unsigned char)*c)){
+            if (nameLength == sizeof(name) - 1) return false;
+            name[nameLength++] = *c++;
+        }
+        name[nameLength] = '\0';
+
+        while (pathSpace(*c)) ++c;
+        if (*c != '(') return false;
+        ++c;
+
+        // 3. the numbers in the brackets
+        float numbers[6];
+        int count = 0;
+        while (true){
+            while (pathSpace(*c) || *c == ',') ++c;
+            if (*c == ')') break;
+            if (count == 6 || readPathNumber(&c, &numbers[count]) == false) return false;
+            ++count;
+        }
+        ++c;
+
+        // 4. the matrix of the transform, put after the ones before it
+        float step[6];
+        identityMatrix(step);
+        if (strcmp(name, "matrix") == 0 && count == 6){
+            memcpy(step, numbers, sizeof(step));
+        }
+        else if (strcmp(name, "translate") == 0 && (count == 1 || count == 2)){
+            step[4] = numbers[0];
+            step[5] = (count == 2) ? numbers[1] : 0;
+        }
+        else if (strcmp(name, "scale") == 0 && (count == 1 || count == 2)){
+            step[0] = numbers[0];
+            step[3] = (count == 2) ? numbers[1] : numbers[0];
+        }
+        else if (strcmp(name, "rotate") == 0 && (count == 1 || count == 3)){
+            rotationMatrix(numbers[0], step);
+            if (count == 3){ // about the point cx, cy
+                step[4] = numbers[1] - step[0] * numbers[1] - step[2] * numbers[2];
+                step[5] = numbers[2] - step[1] * numbers[1] - step[3] * numbers[2];
+            }
+        }
+        else if (strcmp(name, "skewX") == 0 && count == 1){
+            step[2] = (float)tan(numbers[0] * SVG_PI / 180);
+        }
+        else if (strcmp(name, "skewY") == 0 && count == 1){
+            step[1] = (float)tan(numbers[0] * SVG_PI / 180);
+        }
+        else {
+            return false;
+        }
+
+        multiplyMatrix(matrix, step, matrix);
+    }
+}
+
+// true if the matrix keeps the edges of a rectangle along the x and y axes
+bool axisAlignedMatrix(const float matrix[6]){
+
+    return matrix[1] == 0 && matrix[2] == 0;
+}
+
+// true if the matrix keeps the edges along the axes or swaps them, like a turn of 90 degrees
+bool rightAngleMatrix(const float matrix[6]){
+
+    return axisAlignedMatrix(matrix) || (matrix[0] == 0 && matrix[3] == 0);
+}
+
+// true if the matrix only rotates, flips, scales the same on both axes and translates, so circles stay circles
+bool similarityMatrix(const float matrix[6]){
+
+    return (matrix[0] == matrix[3] && matrix[1] == -matrix[2]) || (matrix[0] == -matrix[3] && matrix[1] == matrix[2]);
+}
+
+/*
+    moves the x, y pairs of xy by the matrix, x' = a x + c y + e and y' = b x + d y + f
+    the pairs are moved 4 (AVX2) or 2 (SSE2) at a time: the x y x y of the pairs are multiplied by a d a d,
+    the same pairs swapped to y x y x are multiplied by c b c b, and e f e f is added. The rest are moved one at a time
+    with the same operations in the same order, so every point is moved the same way
+*/
+void transformPoints(const float matrix[6], float* xy, int numPoints){
+
+    if (matrix == NULL || xy == NULL || numPoints <= 0) return;
+
+    const float a = matrix[0], b = matrix[1], c = matrix[2], d = matrix[3], e = matrix[4], f = matrix[5];
+    int length = 2 * numPoints;
+    int i = 0;
+
+#if defined(__AVX2__)
+    const __m256 diagonal = _mm256_setr_ps(a, d, a, d, a, d, a, d);
+    const __m256 cross = _mm256_setr_ps(c, b, c, b, c, b, c, b);
+    const __m256 shift = _mm256_setr_ps(e, f, e, f, e, f, e, f);
+    while (i + 8 <= length){
+        __m256 points = _mm256_loadu_ps(xy + i);
+        __m256 swapped = _mm256_permute_ps(points, _MM_SHUFFLE(2, 3, 0, 1));
+        __m256 moved = _mm256_add_ps(_mm256_mul_ps(points, diagonal), _mm256_mul_ps(swapped, cross));
+        _mm256_storeu_ps(xy + i, _mm256_add_ps(moved, shift));
+        i += 8;
+    }
+#elif defined(__SSE2__)
+    const __m128 diagonal = _mm_setr_ps(a, d, a, d);
+    const __m128 cross = _mm_setr_ps(c, b, c, b);
+    const __m128 shift = _mm_setr_ps(e, f, e, f);
+    while (i + 4 <= length){
+        __m128 points = _mm_loadu_ps(xy + i);
+        __m128 swapped = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 moved = _mm_add_ps(_mm_mul_ps(points, diagonal), _mm_mul_ps(swapped, cross));
+        _mm_storeu_ps(xy + i, _mm_add_ps(moved, shift));
+        i += 4;
+    }
+#endif
+
+    while (i < length){
+        float x = xy[i];
+        float y = xy[i + 1];
+        xy[i] = (x * a + y * c) + e;
+        xy[i + 1] = (y * d + x * b) + f;
+        i += 2;
+    }
+}
+
+// the value of the transform attribute in the list, or NULL if there is none
+const char* transformAttribute(List* attrList){
+
+    if (attrList == NULL) return NULL;
+
+    void* elem;
+    ListIterator iter = createIterator(attrList);
+    while ((elem = nextElement(&iter)) != NULL){
+        Attribute* attr = (Attribute*) elem;
+        if (strcasecmp(attr->name, "transform") == 0) return attr->value;
+    }
+
+    return NULL;
+}
+
+/*
+    puts matrix(a b c d e f) in front of the transform attribute of the element, so the element is drawn with its
+    own transform and then moved by the matrix, the attribute is added if the element has none
+    the new value is longer, so the attribute may be reallocated in its node
+*/
+bool composeTransformAttribute(List* attrList, const float matrix[6]){
+
+    if (attrList == NULL || matrix == NULL) return false;
+
+    // 1. find the node of the transform the element already has, its data is replaced below
+    Node* node = attrList->head;
+    while (node != NULL && strcasecmp(((Attribute*) node->data)->name, "transform") != 0) node = node->next;
+
+    // 2. the new value, with the fewest digits for the numbers
+    StringBuilder builder;
+    if (initBuilder(&builder, 64) == false) return false;
+
+    appendString(&builder, "matrix(");
+    for (int i = 0; i < 6; ++i){
+        char buffer[SVG_NUMBER_LENGTH];
+        formatNumber(buffer, sizeof(buffer), matrix[i], SVG_PRECISION_SHORTEST);
+        if (i > 0) appendChar(&builder, ' ');
+        appendString(&builder, buffer);
+    }
+    appendChar(&builder, ')');
+
+    if (node != NULL && ((Attribute*) node->data)->value[0] != '\0'){
+        appendChar(&builder, ' ');
+        appendString(&builder, ((Attribute*) node->data)->value);
+    }
+
+    char* value = finishBuilder(&builder);
+    if (value == NULL) return false;
+
+    // 3. change the attribute, or add it at the end of the list
+    Attribute* attr = (node != NULL) ? setAttributeValue((Attribute*) node->data, value) : otherAttributes("transform", value);
+    free(value);
+    if (attr == NULL) return false;
+
+    if (node != NULL) node->data = attr;
+    else insertBack(attrList, (void*) attr);
+
+    return true;
+}
+
+/*
+    true if the numbers of the shape can show it moved by the matrix, a rectangle or an ellipse only when its edges stay along
+    the axes (maybe swapped), a circle only when it stays a circle, and no shape with units or a transform of its own
+*/
+bool exactShape(void* shape, elementType type, const float matrix[6]){
+
+    if (shape == NULL || matrix == NULL) return false;
+    if (transformAttribute(shapeOtherAttributes(shape, type)) != NULL) return false;
+
+    if (type == RECT) return ((Rectangle*)shape)->units[0] == '\0' && rightAngleMatrix(matrix);
+    if (type == CIRC) return ((Circle*)shape)->units[0] == '\0' && similarityMatrix(matrix);
+    if (type == ELLIPSE) return ((Ellipse*)shape)->units[0] == '\0' && rightAngleMatrix(matrix);
+    if (type == LINE) return ((Line*)shape)->units[0] == '\0';
+    if (type == POLYLINE || type == POLYGON) return true;
+
+    return false;
+}
+
+// the points of the shape that the matrix moves, x and y are next to each other in all the structs
+float* shapePoints(void* shape, elementType type, int* numPoints){
+
+    *numPoints = 1;
+    if (type == RECT) return &(((Rectangle*)shape)->x);
+    if (type == CIRC) return &(((Circle*)shape)->cx);
+    if (type == ELLIPSE) return &(((Ellipse*)shape)->cx);
+
+    if (type == LINE){
+        *numPoints = 2;
+        return &(((Line*)shape)->x1);
+    }
+
+    *numPoints = ((Polyline*)shape)->numPoints;
+    return ((Polyline*)shape)->points;
+}
+
+// the schema only takes whole numbers of up to 4 digits for the points of polylines and polygons
+bool wholePoints(const float* xy, int numPoints){
+
+    for (int i = 0; i < 2 * numPoints; ++i){
+        if (xy[i] != floorf(xy[i]) || fabsf(xy[i]) > 9999) return false;
+    }
+
+    return true;
+}
+
+/*
+    moves the numbers of the path data by the matrix, the numbers of a run of segments that are all absolute points,
+    or all relative vectors, are moved by one call of transformPoints
+    horizontal and vertical lines can only be moved when the matrix keeps the axes, and arcs when it keeps their shape
+    @return false, with the path data not changed, if the path data cannot show the moved path exactly
+*/
+bool transformPathData(PathData* pathData, const float matrix[6]){
+
+    if (pathData == NULL || matrix == NULL) return false;
+
+    bool aligned = axisAlignedMatrix(matrix);
+    bool similar = similarityMatrix(matrix);
+    float det = matrix[0] * matrix[3] - matrix[1] * matrix[2];
+    const float linear[6] = {matrix[0], matrix[1], matrix[2], matrix[3], 0, 0};
+
+    // 1. check every segment before any number is changed
+    const float* numbers = pathData->coords;
+    for (int i = 0; i < pathData->numCommands; ++i){
+        char command = toupper((unsigned char)pathData->commands[i]);
+        if ((command == 'H' || command == 'V') && aligned == false) return false;
+        if (command == 'A' && similar == false && (aligned == false || fmodf(numbers[2], 90) != 0)) return false;
+        numbers += numArgs(pathData->commands[i]);
+    }
+
+    // 2. move the numbers, the first move to is a point even when it is relative
+    float* coords = pathData->coords;
+    int i = 0;
+    if (pathData->numCommands > 0 && pathData->commands[0] == 'm'){
+        transformPoints(matrix, coords, 1);
+        coords += 2;
+        i = 1;
+    }
+
+    while (i < pathData->numCommands){
+
+        char command = pathData->commands[i];
+        char upper = toupper((unsigned char)command);
+
+        if (upper == 'H'){
+            coords[0] = (command == 'H') ? coords[0] * matrix[0] + matrix[4] : coords[0] * matrix[0];
+            coords += 1;
+            ++i;
+        }
+        else if (upper == 'V'){
+            coords[0] = (command == 'V') ? coords[0] * matrix[3] + matrix[5] : coords[0] * matrix[3];
+            coords += 1;
+            ++i;
+        }
+        else if (upper == 'A'){
+            // the radii and the angle of the ellipse, the sweep turns the other way when the matrix flips
+            if (similar){
+                float scale = sqrtf(fabsf(det));
+                float turn = (float)(atan2(matrix[1], matrix[0]) * 180 / SVG_PI);
+                coords[0] *= scale;
+                coords[1] *= scale;
+                coords[2] = fmodf((det < 0) ? turn - coords[2] : coords[2] + turn, 360);
+            }
+            else {
+                bool sideways = fmodf(fabsf(coords[2]), 180) == 90;
+                coords[0] *= fabsf(sideways ? matrix[3] : matrix[0]);
+                coords[1] *= fabsf(sideways ? matrix[0] : matrix[3]);
+            }
+            if (det < 0) coords[4] = 1 - coords[4];
+            transformPoints((command == 'A') ? matrix : linear, coords + 5, 1);
+            coords += 7;
+            ++i;
+        }
+        else {
+            // a run of segments of pairs, close paths have no numbers and go in any run
+            bool relative = islower((unsigned char)command);
+            int length = 0;
+            while (i < pathData->numCommands){
+                char next = pathData->commands[i];
+                char nextUpper = toupper((unsigned char)next);
+                if (nextUpper == 'H' || nextUpper == 'V' || nextUpper == 'A') break;
+                if (nextUpper != 'Z' && (islower((unsigned char)next) != 0) != relative) break;
+                length += numArgs(next);
+                ++i;
+            }
+            transformPoints(relative ? linear : matrix, coords, length / 2);
+            coords += length;
+        }
+    }
+
+    return true;
+}
+
+/*
+    moves every path in the list, the paths that can be moved exactly are written again from their parse,
+    the others get the matrix in their transform
+    @return false if a path cannot be read, or changed
+*/
+bool transformPathList(List* pathList, const float matrix[6]){
+
+    if (pathList == NULL || matrix == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(pathList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Path* path = (Path*) elem;
+        if (transformAttribute(path->otherAttributes) == NULL){
+            PathData* pathData = getPathData(path);
+            if (pathData == NULL) return false;
+
+            if (transformPathData(pathData, matrix)){
+                if (updatePath(path) == false) return false;
+                continue;
+            }
+        }
+
+        if (composeTransformAttribute(path->otherAttributes, matrix) == false) return false;
+    }
+
+    return true;
+}
+
+/*
+    moves every shape of the type in the list, the points of all the shapes that can be moved exactly are copied into
+    one buffer and moved by one call of transformPoints, then copied back and the sizes are scaled
+    the other shapes get the matrix in their transform
+    the lists of lines, ellipses, polylines and polygons may be NULL, which is the same as empty
+*/
+bool transformList(List* list, elementType type, const float matrix[6]){
+
+    if (matrix == NULL) return false;
+    if (list == NULL) return (type != RECT && type != CIRC && type != PATH);
+    if (type == PATH) return transformPathList(list, matrix);
+
+    // 1. count the points
+    int numPoints = 0;
+    int shapePointCount = 0;
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        if (exactShape(elem, type, matrix) == false) continue;
+        shapePoints(elem, type, &shapePointCount);
+        numPoints += shapePointCount;
+    }
+
+    // 2. copy them into one buffer and move them
+    float* buffer = malloc(sizeof(float) * 2 * numPoints + 1);
+    if (buffer == NULL) return false;
+
+    float* xy = buffer;
+    iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        if (exactShape(elem, type, matrix) == false) continue;
+        float* points = shapePoints(elem, type, &shapePointCount);
+        memcpy(xy, points, sizeof(float) * 2 * shapePointCount);
+        xy += 2 * shapePointCount;
+    }
+
+    transformPoints(matrix, buffer, numPoints);
+
+    // 3. copy the points back, or put the matrix in the transform
+    float det = matrix[0] * matrix[3] - matrix[1] * matrix[2];
+    xy = buffer;
+    iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        void* shape = elem;
+        bool exact = exactShape(shape, type, matrix);
+        float* points = exact ? shapePoints(shape, type, &shapePointCount) : NULL;
+        if (exact && (type == POLYLINE || type == POLYGON) && wholePoints(xy, shapePointCount) == false){
+            exact = false; // the moved points are skipped
+            xy += 2 * shapePointCount;
+        }
+
+        if (exact == false){
+            if (composeTransformAttribute(shapeOtherAttributes(shape, type), matrix) == false){
+                free(buffer);
+                return false;
+            }
+            continue;
+        }
+
+        memcpy(points, xy, sizeof(float) * 2 * shapePointCount);
+        xy += 2 * shapePointCount;
+
+        if (type == RECT){
+            // the width goes along x' = a w or y' = b w, the height along x' = c h or y' = d h,
+            // and the corner moved is no longer the top left one when they go the negative way
+            Rectangle* rect = (Rectangle*) shape;
+            float width = rect->width;
+            float height = rect->height;
+            rect->x += fminf(0, matrix[0] * width) + fminf(0, matrix[2] * height);
+            rect->y += fminf(0, matrix[1] * width) + fminf(0, matrix[3] * height);
+            rect->width = fabsf(matrix[0]) * width + fabsf(matrix[2]) * height;
+            rect->height = fabsf(matrix[1]) * width + fabsf(matrix[3]) * height;
+        }
+        else if (type == CIRC){
+            Circle* circ = (Circle*) shape;
+            circ->r = circ->r * sqrtf(fabsf(det));
+        }
+        else if (type == ELLIPSE){
+            Ellipse* ellipse = (Ellipse*) shape;
+            float rx = ellipse->rx;
+            ellipse->rx = fabsf(matrix[0]) * rx + fabsf(matrix[2]) * ellipse->ry;
+            ellipse->ry = fabsf(matrix[1]) * rx + fabsf(matrix[3]) * ellipse->ry;
+        }
+    }
+
+    free(buffer);
+    return true;
+}
+
+// moves the shapes of the lists, lists is indexed by elementType, like lists[RECT], with the groups in lists[GROUP]
+bool transformElements(List* lists[], const float matrix[6], unsigned elementMask){
+
+    if (lists == NULL || matrix == NULL) return false;
+
+    for (elementType type = CIRC; type <= POLYGON; ++type){
+        if (type == GROUP || (elementMask & SVG_ELEMENT_MASK(type)) == 0) continue;
+        if (transformList(lists[type], type, matrix) == false) return false;
+    }
+
+    return transformGroups(lists[GROUP], matrix, elementMask);
+}
+
+/*
+    moves the groups as a whole when GROUP is in the mask, otherwise moves the shapes in them
+    the shapes of a group with a transform T are moved by T^-1 * matrix * T, so after T they are moved by the matrix
+*/
+bool transformGroups(List* groupList, const float matrix[6], unsigned elementMask){
+
+    if (groupList == NULL || matrix == NULL) return false;
+
+    void* elem;
+    ListIterator iter = createIterator(groupList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Group* group = (Group*) elem;
+        if (elementMask & SVG_ELEMENT_MASK(GROUP)){
+            if (composeTransformAttribute(group->otherAttributes, matrix) == false) return false;
+            continue;
+        }
+
+        float local[6];
+        memcpy(local, matrix, sizeof(local));
+
+        const char* transform = transformAttribute(group->otherAttributes);
+        if (transform != NULL){
+            float groupMatrix[6];
+            float inverse[6];
+            if (parseTransform(transform, groupMatrix) == false || invertMatrix(groupMatrix, inverse) == false) return false;
+            multiplyMatrix(inverse, matrix, local);
+            multiplyMatrix(local, groupMatrix, local);
+        }
+
+        List* lists[POLYGON + 1] = {NULL};
+        lists[RECT] = group->rectangles;
+        lists[CIRC] = group->circles;
+        lists[PATH] = group->paths;
+        lists[GROUP] = group->groups;
+        lists[LINE] = group->lines;
+        lists[ELLIPSE] = group->ellipses;
+        lists[POLYLINE] = group->polylines;
+        lists[POLYGON] = group->polygons;
+
+        if (transformElements(lists, local, elementMask) == false) return false;
+    }
+
+    return true;
+}
+
+bool transformSVG(SVG* img, const float matrix[6], unsigned elementMask){
+
+    if (img == NULL || matrix == NULL) return false;
+
+    for (int i = 0; i < 6; ++i){
+        if (isfinite(matrix[i]) == 0) return false;
+    }
+
+    // nothing moves, the paths are not written again
+    if (matrix[0] == 1 && matrix[1] == 0 && matrix[2] == 0 && matrix[3] == 1 && matrix[4] == 0 && matrix[5] == 0) return true;
+    touchSVG(img);
+
+    List* lists[POLYGON + 1] = {NULL};
+    lists[RECT] = img->rectangles;
+    lists[CIRC] = img->circles;
+    lists[PATH] = img->paths;
+    lists[GROUP] = img->groups;
+    lists[LINE] = img->lines;
+    lists[ELLIPSE] = img->ellipses;
+    lists[POLYLINE] = img->polylines;
+    lists[POLYGON] = img->polygons;
+
+    return transformElements(lists, matrix, elementMask);
+}
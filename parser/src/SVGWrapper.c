@@ -1,8 +1,17 @@
 #include "SVGParser.h"
 #include "SVGHelper.h"
 #include "SVGHelperA2.h"
+#include "SVGHelperJSON.h"
+#include "SVGPatch.h"
+#include "SVGShapes.h"
+#include "SVGTransform.h"
+#include "SVGJournal.h"
+#include "SVGElementPath.h"
+#include "SVGSpatial.h"
+#include "SVGSelector.h"
 #include "LinkedListAPI.h"
 #include <strings.h>
+#include <time.h>
 
 bool validFile(char* filename){
 
@@ -112,6 +121,110 @@ char* getGroupsJSON(char* filename){
 
 }
 
+/**
+    The getLinesJSON, getEllipsesJSON, getPolylinesJSON and getPolygonsJSON functions are created for the svg view panel,
+    like getRectsJSON they return the shapes that are directly in the svg
+*/
+char* getLinesJSON(char* filename){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* linesString = lineListToJSON(img->lines);
+
+    deleteSVG(img);
+    return linesString;
+
+}
+
+char* getEllipsesJSON(char* filename){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* ellipsesString = ellipseListToJSON(img->ellipses);
+
+    deleteSVG(img);
+    return ellipsesString;
+
+}
+
+char* getPolylinesJSON(char* filename){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* polylinesString = polylineListToJSON(img->polylines);
+
+    deleteSVG(img);
+    return polylinesString;
+
+}
+
+char* getPolygonsJSON(char* filename){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* polygonsString = polylineListToJSON(img->polygons);
+
+    deleteSVG(img);
+    return polygonsString;
+
+}
+
+/**
+    The get...JSONRange functions are created for the svg view panel so that it can page
+    through the components of large files, only the page that is shown is converted to JSON
+*/
+char* getRectsJSONRange(char* filename, int offset, int limit){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* rectsString = listToJSONRange(img->rectangles, RECT, offset, limit);
+
+    deleteSVG(img);
+    return rectsString;
+
+}
+
+char* getCircsJSONRange(char* filename, int offset, int limit){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* circsString = listToJSONRange(img->circles, CIRC, offset, limit);
+
+    deleteSVG(img);
+    return circsString;
+
+}
+
+char* getPathsJSONRange(char* filename, int offset, int limit){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* pathsString = listToJSONRange(img->paths, PATH, offset, limit);
+
+    deleteSVG(img);
+    return pathsString;
+
+}
+
+char* getGroupsJSONRange(char* filename, int offset, int limit){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* groupsString = listToJSONRange(img->groups, GROUP, offset, limit);
+
+    deleteSVG(img);
+    return groupsString;
+
+}
+
 char* getAttributesJSON(char* filename, char* componentType, int index){
 
     // 1. create the svg structure
@@ -164,36 +277,58 @@ char* getAttributesJSON(char* filename, char* componentType, int index){
         // 4. get the list of other attributes
         otherAttributesString = attrListToJSON(group->otherAttributes);
     }
+    else if (componentTypeNamed(componentType) != SVG_IMG){
+        // the lines, ellipses, polylines and polygons, their list may be NULL
+        elementType type = componentTypeNamed(componentType);
+        List* list = *svgShapeList(img, type);
+        void* elem = (list == NULL) ? NULL : getElementAt(list, index);
+
+        otherAttributesString = attrListToJSON(shapeOtherAttributes(elem, type));
+    }
 
     deleteSVG(img);
     return otherAttributesString;
 
 }
 
+/**
+    The getShapesBinary function is created for the svg view panel, it returns all the shapes
+    in the binary format from SVGBinary.h so the server does not have to parse JSON strings
+    the server must give the buffer back to freeBinary once it has copied it
+*/
+void* getShapesBinary(char* filename){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    unsigned char* shapes = SVGtoBinary(img, NULL);
+
+    deleteSVG(img);
+    return shapes;
+}
+
+void freeBinary(void* data){
+
+    free(data);
+}
+
 bool changeTitle(char* filename, char* newValue){
 
     if (newValue == NULL) return false;
 
-    // 1. create svg
+    // 1. validate the title
+    if (validChar(newValue) == 0 || strlen(newValue) > 256) return false;
+
+    // 2. replace only the bytes of the old title in the file when it can be done safely
+    if (patchTitleDesc(filename, "title", newValue, "uploads/svg.xsd")) return true;
+
+    // 3. otherwise create svg, update the title
     SVG* img = createValidSVG(filename, "uploads/svg.xsd");
     if (img == NULL) return false;
-
-    // 2. validate the title. If valid, update the title
-    if (validChar(newValue) == 0 || strlen(newValue) > 256){
-        deleteSVG(img);
-        return false;
-    }
     strcpy(img->title, newValue);
 
-    // 3. validate change
-    bool valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
-        deleteSVG(img);
-        return false;
-    }
-
-    // 4. overwrite changes to file
-    valid = writeSVG(img, filename);
+    // 4. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
@@ -203,26 +338,19 @@ bool changeDescr(char* filename, char* newValue){
 
     if (newValue == NULL) return false;
 
-    // 1. create svg
+    // 1. validate the description
+    if (validChar(newValue) == 0 || strlen(newValue) > 256) return false;
+
+    // 2. replace only the bytes of the old description in the file when it can be done safely
+    if (patchTitleDesc(filename, "desc", newValue, "uploads/svg.xsd")) return true;
+
+    // 3. otherwise create svg, update the description
     SVG* img = createValidSVG(filename, "uploads/svg.xsd");
     if (img == NULL) return false;
-
-    // 2. validate the title. If valid, update the title
-    if (validChar(newValue) == 0 || strlen(newValue) > 256){
-        deleteSVG(img);
-        return false;
-    }
     strcpy(img->description, newValue);
 
-    // 3. validate change
-    bool valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
-        deleteSVG(img);
-        return false;
-    }
-
-    // 4. overwrite changes to file
-    valid = writeSVG(img, filename);
+    // 4. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
@@ -251,15 +379,8 @@ bool scaleRectangles(char* filename, float scaleValue){
 
     freeList(rectangles);
 
-    // 3. validate change
-    bool valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
-        deleteSVG(img);
-        return false;
-    }
-
-    // 4. overwrite changes to file
-    valid = writeSVG(img, filename);
+    // 3. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
@@ -288,15 +409,71 @@ bool scaleCircles(char* filename, float scaleValue){
 
     freeList(circles);
 
-    // 3. validate change
-    bool valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
+    // 3. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+
+}
+
+/**
+    The scalePaths function is the same as scaleRectangles for paths, each path is scaled about its first point
+    and its data is written again in the shortest form
+*/
+bool scalePaths(char* filename, float scaleValue){
+
+    return scalePrimitives(filename, "Path", scaleValue);
+
+}
+
+/**
+    The transformComponents function scales every shape by scaleValue, rotates it by angle degrees about the origin
+    and then translates it, all with one matrix, so the file is read, validated and written once for all three
+*/
+bool transformComponents(char* filename, float translateX, float translateY, float angle, float scaleValue){
+
+    // 1. create svg
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return false;
+
+    // 2. move the shapes of the svg and its groups
+    float matrix[6];
+    composeMatrix(translateX, translateY, angle, scaleValue, matrix);
+    if (transformSVG(img, matrix, SVG_SHAPES_MASK) == false){
         deleteSVG(img);
         return false;
     }
 
-    // 4. overwrite changes to file
-    valid = writeSVG(img, filename);
+    // 3. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+
+}
+
+/**
+    The scalePrimitives function scales any of the shapes, given the same names as setNewAttributes,
+    rectangles and circles are scaled the same way as scaleRectangles and scaleCircles
+*/
+bool scalePrimitives(char* filename, char* componentType, float scaleValue){
+
+    elementType type = componentTypeNamed(componentType);
+    if (type == SVG_IMG || type == GROUP) return false;
+
+    // 1. create svg
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return false;
+
+    // 2. scale every shape of the type, in the svg and the groups
+    if (scaleShapes(img, type, scaleValue) == false){
+        deleteSVG(img);
+        return false;
+    }
+
+    // 3. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
@@ -319,20 +496,22 @@ bool setNewAttributes(char* filename, char* componentType, int componentNumber,
         return false;
     }
 
-    // 2. create svg based on file
+    // 2. identify component type
+    elementType elem = componentTypeNamed(componentType);
+
+    // 3. replace only the bytes of the old value in the file when the attribute is already there
+    if (patchAttribute(filename, elem, componentNumber, newName, newValue, "uploads/svg.xsd")){
+        deleteAttribute((void*)newAttribute);
+        return true;
+    }
+
+    // create svg based on file
     SVG* img = createValidSVG(filename, "uploads/svg.xsd");
     if (img == NULL){
         deleteAttribute((void*)newAttribute);
         return false;
     }
 
-    // 3. identify component type
-    elementType elem;
-    if (strcasecmp(componentType, "Rectangle") == 0) elem = RECT;
-    else if (strcasecmp(componentType, "Circle") == 0) elem = CIRC;
-    else if (strcasecmp(componentType, "Path") == 0) elem = PATH;
-    else if (strcasecmp(componentType, "Group") == 0) elem = GROUP;
-
     // 4. call c function to set or add attribute value in the file
     valid = setAttribute(img, elem, componentNumber, newAttribute);
     if (valid == false){
@@ -341,18 +520,11 @@ bool setNewAttributes(char* filename, char* componentType, int componentNumber,
         return false;
     }
 
-    // 5. validate change
-    valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
-        deleteSVG(img);
-        return false;
-    }
-
-    // 6. overwrite changes to file
-    valid = writeSVG(img, filename);
+    // 5. validate change and overwrite changes to file, with one xml tree
+    valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
-    // 7. memory management
-    // 7. if the return vaue is false, will display error in the console
+    // 6. memory management
+    // 6. if the return vaue is false, will display error in the console
     deleteSVG(img);
     return valid;
 }
@@ -365,15 +537,8 @@ bool createFile(char* filename, char* svg){
     SVG* img = JSONtoSVG(svg);
     if (img == NULL) return false;
 
-    // 2. validate against restrictions
-    valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
-        deleteSVG(img);
-        return false;
-    }
-
-    // 3. write to file
-    valid = writeSVG(img, filename);
+    // 2. validate against restrictions and write to file, with one xml tree
+    valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
@@ -404,15 +569,8 @@ bool addCircle(char* filename, char* circle){
     // 4. add to svg
     addComponent(img, CIRC, (void*)circ);
 
-    // 5. validate change
-    valid = validateSVG(img, "uploads/svg.xsd");
-    if (valid == false){
-        deleteSVG(img);
-        return false;
-    }
-
-    // 6. write updates to file
-    valid = writeSVG(img, filename);
+    // 5. validate change and overwrite changes to file, with one xml tree
+    valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
@@ -443,16 +601,247 @@ bool addRectangle(char* filename, char* rectangle){
     // 4. add to svg
     addComponent(img, RECT, (void*)rect);
 
-    // 5. validate change
-    valid = validateSVG(img, "uploads/svg.xsd");
+    // 5. validate change and overwrite changes to file, with one xml tree
+    valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+}
+
+/**
+    The addShapesJSON function adds every shape in a JSON array to an svg file
+    with a single validation and a single write, instead of one write per shape.
+    Each shape may target a top level group with a "group" index, otherwise it is added to the svg.
+    If any shape is invalid the file is not changed.
+*/
+bool addShapesJSON(char* filename, char* shapes){
+
+    if (shapes == NULL) return false;
+
+    bool valid = true;
+
+    // 1. create svg based on file
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return false;
+
+    // 2. create every shape given the JSON array and add it to the svg
+    if (addJSONShapes(img, shapes) == false){
+        deleteSVG(img);
+        return false;
+    }
+
+    // 3. validate all the changes and write updates to file once, with one xml tree
+    valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+}
+
+/**
+    The applyEditsJSON function applies a JSON array of edits (see applyJSONEdit) in order to one svg,
+    then validates and writes the file once. If any edit fails or the result is not valid, the file is not changed
+*/
+bool applyEditsJSON(char* filename, char* edits){
+
+    if (edits == NULL) return false;
+
+    // 1. create svg based on file
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return false;
+
+    // 2. apply every edit to the struct, the struct is thrown away when one fails
+    if (applyJSONEdits(img, edits) == false){
+        deleteSVG(img);
+        return false;
+    }
+
+    // 3. validate all the changes and write updates to file once, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+}
+
+/**
+    The journalEditsJSON function checks a JSON array of edits like applyEditsJSON, then appends them to the
+    journal of the file instead of writing the whole file. The file is written, and the journal removed,
+    when the journal is bigger than SVG_JOURNAL_MAX_BYTES or older than SVG_JOURNAL_MAX_SECONDS
+    @return -1 if the edits were not added, 0 if they were, 1 if they were but the file could not be written,
+    the edits then stay in the journal and the file is written by a later edit or by compactJournal
+*/
+int journalEditsJSON(char* filename, char* edits){
+
+    if (edits == NULL) return -1;
+
+    // 1. create svg based on file, with the edits already in the journal
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return -1;
+
+    // 2. all the edits must apply and leave a valid svg before any of them are written
+    bool valid = applyJSONEdits(img, edits) && validateSVG(img, "uploads/svg.xsd");
+
+    // 3. append them, and compact the journal into the file when it is too big or too old
+    time_t now = time(NULL);
+    if (valid) valid = appendJournal(filename, edits, now);
+    bool written = (valid == false || journalNeedsCompaction(filename, now) == false || validateAndWriteSVG(img, "uploads/svg.xsd", filename));
+
+    deleteSVG(img);
+    if (valid == false) return -1;
+    return (written) ? 0 : 1;
+}
+
+// writes the edits in the journal into the file, and removes the journal
+bool compactJournal(char* filename){
+
+    if (filename == NULL) return false;
+    if (journalExists(filename) == false) return true;
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return false;
+
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+}
+
+// the edits in the journal of the file, for the MODIFICATION table
+char* getJournalJSON(char* filename){
+
+    return journalToJSON(filename);
+}
+
+// the other attributes of the element at a path like "g0/g2/rect3", "" for the svg itself
+char* getAttributesAtPathJSON(char* filename, char* elementPath){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    ElementPath resolved;
+    char* otherAttributesString = NULL;
+    if (resolveElementPath(img, elementPath, &resolved)){
+        otherAttributesString = attrListToJSON(elementPathAttributes(img, &resolved));
+    }
+
+    deleteSVG(img);
+    return otherAttributesString;
+}
+
+/**
+    The setNewAttributesAtPath function is setNewAttributes for an element at any depth, named by an element path
+    like "g0/g2/rect3" instead of a component type and an index
+*/
+bool setNewAttributesAtPath(char* filename, char* elementPath, char* newName, char* newValue){
+
+    // 1. create new attribute value, and validate it
+    Attribute* newAttribute = otherAttributes(newName, newValue);
+    if (newAttribute == NULL) return false;
+    if (validAttrStruct(newAttribute) == false){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    // 2. create svg based on file
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL){
+        deleteAttribute((void*)newAttribute);
+        return false;
+    }
+
+    // 3. set or add the attribute of the element at the path
+    if (setAttributeAtPath(img, elementPath, newAttribute) == false){
+        deleteAttribute((void*)newAttribute);
+        deleteSVG(img);
+        return false;
+    }
+
+    // 4. validate change and overwrite changes to file, with one xml tree
+    bool valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
+
+    deleteSVG(img);
+    return valid;
+}
+
+// adds a shape, a JSON object like the ones of addShapesJSON, to the svg or the group at an element path
+bool addShapeAtPath(char* filename, char* elementPath, char* shape){
+
+    if (elementPath == NULL || shape == NULL) return false;
+
+    // 1. create the shape given the JSON string
+    elementType type;
+    void* newElement = JSONtoShape(shape, &type);
+    if (newElement == NULL) return false;
+
+    // 2. create svg based on file
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    bool valid = (img != NULL) && addComponentAtPath(img, elementPath, type, newElement);
     if (valid == false){
+        if (type == RECT) deleteRectangle(newElement);
+        else if (type == CIRC) deleteCircle(newElement);
+        else deletePath(newElement);
         deleteSVG(img);
         return false;
     }
 
-    // 6. write updates to file
-    valid = writeSVG(img, filename);
+    // 3. validate change and overwrite changes to file, with one xml tree
+    valid = validateAndWriteSVG(img, "uploads/svg.xsd", filename);
 
     deleteSVG(img);
     return valid;
 }
+
+/**
+    The queryRegionJSON function finds the shapes of the svg and of all its groups whose boxes meet a rectangle
+    of the svg, with the R-tree of SVGSpatial.h. Every shape is named by its element path
+    @return a JSON array like [{"path":"g0/rect1","type":"rect","bounds":{"x":1.00,"y":2.00,"w":3.00,"h":4.00}}]
+*/
+char* queryRegionJSON(char* filename, float x, float y, float width, float height){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* json = queryRegionToJSON(img, x, y, width, height);
+
+    deleteSVG(img);
+    return json;
+}
+
+// the shapes under a point of the svg, in the format of queryRegionJSON
+char* hitTestJSON(char* filename, float x, float y){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* json = hitTestToJSON(img, x, y);
+
+    deleteSVG(img);
+    return json;
+}
+
+/**
+    The selectCount and selectJSON functions run a selector like "g > rect[width>10][fill=red]" over the svg and all
+    its groups (see SVGSelector.h), so the server can ask for any set of elements with one function
+    @return the number of elements found, or -1 if the file or the selector is not valid
+*/
+int selectCount(char* filename, char* selector){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return -1;
+
+    int count = countSelectorMatches(img, selector);
+
+    deleteSVG(img);
+    return count;
+}
+
+// the elements found by the selector, as a JSON array like [{"path":"g0/rect1","type":"rect"}]
+char* selectJSON(char* filename, char* selector){
+
+    SVG* img = createValidSVG(filename, "uploads/svg.xsd");
+    if (img == NULL) return NULL;
+
+    char* json = selectToJSON(img, selector);
+
+    deleteSVG(img);
+    return json;
+}
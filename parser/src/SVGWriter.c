@@ -0,0 +1,707 @@
+// Name: Haifaa Abushaaban
+
+#define _POSIX_C_SOURCE 200809L // open, write, fsync, mkstemp, strdup
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGWriter.h"
+#include "SVGCompress.h"
+#include "SVGFormat.h"
+#include "SVGShapes.h"
+
+// durability of every write, and the files written in SVG_SYNC_BATCHED mode that have not been synced yet
+static writeDurability durability = SVG_SYNC_FILE;
+static char** pendingSyncs = NULL;
+static int numPendingSyncs = 0;
+static time_t firstPendingSync = 0;
+
+void setWriteDurability(int newDurability){
+
+    if (newDurability < SVG_SYNC_NONE || newDurability > SVG_SYNC_FULL) return;
+
+    // the pending files were written with the promise that they get synced
+    if (newDurability != SVG_SYNC_BATCHED) syncSVGWrites();
+
+    durability = newDurability;
+}
+
+bool syncSVGWrites(void){
+
+    bool synced = true;
+
+    for (int i = 0; i < numPendingSyncs; ++i){
+        if (syncFile(pendingSyncs[i]) == false) synced = false;
+        if (syncDirectory(pendingSyncs[i]) == false) synced = false;
+        free(pendingSyncs[i]);
+    }
+
+    free(pendingSyncs);
+    pendingSyncs = NULL;
+    numPendingSyncs = 0;
+
+    return synced;
+}
+
+// remembers a file for the next syncSVGWrites, and runs it when the batch is full or old enough
+void addPendingSync(const char* fileName){
+
+    // 1. a file edited many times in a row only needs one sync
+    bool found = false;
+    for (int i = 0; i < numPendingSyncs && found == false; ++i){
+        if (strcmp(pendingSyncs[i], fileName) == 0) found = true;
+    }
+
+    // 2. add it to the batch, if there is no memory for it sync it now instead
+    if (found == false){
+        char** newSyncs = realloc(pendingSyncs, (numPendingSyncs + 1) * sizeof(char*));
+        char* name = strdup(fileName);
+        if (newSyncs == NULL || name == NULL){
+            free(name);
+            if (newSyncs != NULL) pendingSyncs = newSyncs;
+            syncFile(fileName);
+            syncDirectory(fileName);
+            return;
+        }
+        pendingSyncs = newSyncs;
+        if (numPendingSyncs == 0) firstPendingSync = time(NULL);
+        pendingSyncs[numPendingSyncs++] = name;
+    }
+
+    // 3. sync the batch
+    if (numPendingSyncs >= SVG_SYNC_BATCH_SIZE || time(NULL) - firstPendingSync >= SVG_SYNC_BATCH_SECONDS){
+        syncSVGWrites();
+    }
+}
+
+bool syncFile(const char* fileName){
+
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    bool synced = (fsync(fd) == 0);
+    close(fd);
+
+    return synced;
+}
+
+// fsyncs the directory the file is in, which makes a rename in it durable
+bool syncDirectory(const char* fileName){
+
+    const char* slash = strrchr(fileName, '/');
+    char* dirName = (slash == NULL) ? strdup(".") : strndup(fileName, (slash == fileName) ? 1 : slash - fileName);
+    if (dirName == NULL) return false;
+
+    bool synced = syncFile(dirName);
+    free(dirName);
+
+    return synced;
+}
+
+// "dir/name.svg" -> "dir/.name.svg.XXXXXX", the template for mkstemp, hidden and without the .svg extension
+char* tempFileName(const char* fileName){
+
+    const char* slash = strrchr(fileName, '/');
+    size_t dirLength = (slash == NULL) ? 0 : slash - fileName + 1;
+
+    char* tempName = malloc(strlen(fileName) + 9); // the ., the .XXXXXX and \0
+    if (tempName == NULL) return NULL;
+
+    memcpy(tempName, fileName, dirLength);
+    sprintf(tempName + dirLength, ".%s.XXXXXX", fileName + dirLength);
+
+    return tempName;
+}
+
+/*
+    opens a new temp file next to fileName, closeWriter renames it over fileName once everything is written
+    the temp file gets the permissions of the file it replaces, or the usual ones for a new file
+*/
+bool openWriter(SVGWriter* writer, const char* fileName){
+
+    if (writer == NULL || fileName == NULL) return false;
+
+    writer->length = 0;
+    writer->fd = -1;
+    writer->gz = NULL;
+    writer->failed = true;
+    writer->options = getWriteOptions();
+    writer->inheritedSet = 0;
+    memset(writer->placedLists, 0, sizeof(writer->placedLists));
+    writer->fileName = strdup(fileName);
+    writer->tempName = tempFileName(fileName);
+    if (writer->fileName == NULL || writer->tempName == NULL){
+        freeWriterNames(writer);
+        return false;
+    }
+
+    writer->fd = mkstemp(writer->tempName);
+    if (writer->fd < 0){
+        freeWriterNames(writer);
+        return false;
+    }
+
+    struct stat fileStat;
+    mode_t mode;
+    if (stat(fileName, &fileStat) == 0){
+        mode = fileStat.st_mode & 07777;
+    }
+    else {
+        mode_t mask = umask(0);
+        umask(mask);
+        mode = 0666 & ~mask;
+    }
+    fchmod(writer->fd, mode);
+
+    // .svgz files are compressed through a second descriptor, so fd stays open for the fsync after zlib is done
+    if (compressedFileName(fileName)){
+        char gzMode[8];
+        if (getCompressionLevel() == Z_DEFAULT_COMPRESSION) strcpy(gzMode, "wb");
+        else sprintf(gzMode, "wb%d", getCompressionLevel());
+
+        int gzFd = dup(writer->fd);
+        if (gzFd >= 0) writer->gz = gzdopen(gzFd, gzMode);
+        if (writer->gz == NULL){
+            if (gzFd >= 0) close(gzFd);
+            close(writer->fd);
+            writer->fd = -1;
+            unlink(writer->tempName);
+            freeWriterNames(writer);
+            return false;
+        }
+        gzbuffer(writer->gz, SVG_WRITER_BUFFER_SIZE);
+    }
+
+    writer->failed = false;
+    return true;
+}
+
+// writes bytes to the file, through zlib for a compressed file, retrying short writes
+void writeToFile(SVGWriter* writer, const char* bytes, size_t length){
+
+    while (writer->failed == false && length > 0){
+
+        if (writer->gz != NULL){
+            unsigned int chunk = (length > SVG_WRITER_BUFFER_SIZE) ? SVG_WRITER_BUFFER_SIZE : length;
+            int ret = gzwrite(writer->gz, bytes, chunk);
+            if (ret <= 0){
+                writer->failed = true;
+            }
+            else {
+                bytes += ret;
+                length -= ret;
+            }
+            continue;
+        }
+
+        ssize_t ret = write(writer->fd, bytes, length);
+        if (ret < 0){
+            if (errno == EINTR) continue;
+            writer->failed = true;
+        }
+        else {
+            bytes += ret;
+            length -= ret;
+        }
+    }
+}
+
+// writes out everything in the buffer
+void flushWriter(SVGWriter* writer){
+
+    writeToFile(writer, writer->buffer, writer->length);
+    writer->length = 0;
+}
+
+/*
+    flushes and closes the temp file, then renames it over the file, syncing it as the durability asks
+    if any write failed the temp file is removed and the original file is left as it was
+*/
+bool closeWriter(SVGWriter* writer){
+
+    if (writer->fd < 0) return false;
+
+    // 1. flush and close the temp file, zlib writes the end of the compressed data when it is closed
+    flushWriter(writer);
+    if (writer->gz != NULL){
+        if (gzclose(writer->gz) != Z_OK) writer->failed = true;
+        writer->gz = NULL;
+    }
+    if (writer->failed == false && durability >= SVG_SYNC_FILE && fsync(writer->fd) != 0) writer->failed = true;
+    if (close(writer->fd) != 0) writer->failed = true;
+    writer->fd = -1;
+
+    // 2. replace the file
+    if (writer->failed == false && rename(writer->tempName, writer->fileName) != 0) writer->failed = true;
+    if (writer->failed){
+        unlink(writer->tempName);
+        freeWriterNames(writer);
+        return false;
+    }
+
+    // 3. make the rename durable
+    if (durability == SVG_SYNC_FULL) syncDirectory(writer->fileName);
+    else if (durability == SVG_SYNC_BATCHED) addPendingSync(writer->fileName);
+
+    freeWriterNames(writer);
+    return true;
+}
+
+void freeWriterNames(SVGWriter* writer){
+
+    free(writer->fileName);
+    free(writer->tempName);
+    writer->fileName = NULL;
+    writer->tempName = NULL;
+}
+
+void writeBytes(SVGWriter* writer, const char* bytes, size_t length){
+
+    if (writer->failed) return;
+
+    // large strings (long path data) go straight to the file instead of through the buffer
+    if (length >= SVG_WRITER_BUFFER_SIZE){
+        flushWriter(writer);
+        writeToFile(writer, bytes, length);
+        return;
+    }
+
+    if (writer->length + length > SVG_WRITER_BUFFER_SIZE) flushWriter(writer);
+
+    memcpy(writer->buffer + writer->length, bytes, length);
+    writer->length += length;
+}
+
+void writeString(SVGWriter* writer, const char* string){
+
+    writeBytes(writer, string, strlen(string));
+}
+
+/*
+    writes a string with the characters that cannot appear in xml replaced, the same way libxml2 does:
+    < > & everywhere, \r as a character reference, and in attribute values also " \n \t
+    the spans between those characters are written with one writeBytes each
+*/
+void writeEscaped(SVGWriter* writer, const char* string, bool attribute){
+
+    const char* start = string;
+    const char* cur = string;
+
+    for (; *cur != '\0'; ++cur){
+
+        const char* entity = NULL;
+        switch (*cur){
+            case '<': entity = "&lt;"; break;
+            case '>': entity = "&gt;"; break;
+            case '&': entity = "&amp;"; break;
+            case '\r': entity = "&#13;"; break;
+            case '"': if (attribute) entity = "&quot;"; break;
+            case '\n': if (attribute) entity = "&#10;"; break;
+            case '\t': if (attribute) entity = "&#9;"; break;
+            default: break;
+        }
+
+        if (entity != NULL){
+            writeBytes(writer, start, cur - start);
+            writeString(writer, entity);
+            start = cur + 1;
+        }
+    }
+
+    writeBytes(writer, start, cur - start);
+}
+
+void writeIndent(SVGWriter* writer, int depth){
+
+    if (writer->options.indent == false) return;
+
+    static const char spaces[] = "                                ";
+
+    int length = depth * 2;
+    while (length > 0){
+        int chunk = (length < (int)sizeof(spaces) - 1) ? length : (int)sizeof(spaces) - 1;
+        writeBytes(writer, spaces, chunk);
+        length -= chunk;
+    }
+}
+
+// ends the line of an element, without indent the elements are written with nothing between them
+void writeNewline(SVGWriter* writer){
+
+    if (writer->options.indent) writeBytes(writer, "\n", 1);
+}
+
+// writes name="value" with a space before it
+void writeAttribute(SVGWriter* writer, const char* name, const char* value){
+
+    writeBytes(writer, " ", 1);
+    writeString(writer, name);
+    writeBytes(writer, "=\"", 2);
+    writeEscaped(writer, value, true);
+    writeBytes(writer, "\"", 1);
+}
+
+// same format as unitsWithNumber, without allocating the string
+void writeNumberAttribute(SVGWriter* writer, const char* name, float number, const char* units){
+
+    char value[SVG_NUMBER_LENGTH];
+    formatNumber(value, sizeof(value), number, writer->options.precision);
+
+    writeBytes(writer, " ", 1);
+    writeString(writer, name);
+    writeBytes(writer, "=\"", 2);
+    writeString(writer, value);
+    writeEscaped(writer, units, true);
+    writeBytes(writer, "\"", 1);
+}
+
+// writes <name>text</name> on its own line, used for the title and description
+void writeTextElement(SVGWriter* writer, const char* name, const char* text, int depth){
+
+    writeIndent(writer, depth);
+    writeBytes(writer, "<", 1);
+    writeString(writer, name);
+    writeBytes(writer, ">", 1);
+    writeEscaped(writer, text, false);
+    writeBytes(writer, "</", 2);
+    writeString(writer, name);
+    writeBytes(writer, ">", 1);
+    writeNewline(writer);
+}
+
+void writeAttrList(SVGWriter* writer, List* list){
+
+    if (list == NULL) return;
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        Attribute* attr = (Attribute*) elem;
+        if (writer->options.dropDefaults && isDefaultAttribute(attr->name, attr->value, writer->inheritedSet)) continue;
+        writeAttribute(writer, attr->name, attr->value);
+    }
+}
+
+void writeRectList(SVGWriter* writer, List* rectList, int depth){
+
+    if (rectList == NULL) return;
+
+    PlacedCursor placed = placedCursor(writer, RECT);
+    int index = 0;
+
+    void* elem;
+    ListIterator iter = createIterator(rectList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Rectangle* rect = (Rectangle*) elem;
+
+        writeIndent(writer, depth);
+        writeBytes(writer, "<rect", 5);
+        // x and y are 0 when they are left out
+        bool dropZero = writer->options.dropDefaults;
+        if (dropZero == false || rect->x != 0) writeNumberAttribute(writer, "x", rect->x, rect->units);
+        if (dropZero == false || rect->y != 0) writeNumberAttribute(writer, "y", rect->y, rect->units);
+        writeNumberAttribute(writer, "width", rect->width, rect->units);
+        writeNumberAttribute(writer, "height", rect->height, rect->units);
+        writeAttrList(writer, rect->otherAttributes);
+        writeBytes(writer, "/>", 2);
+        writeNewline(writer);
+        writePlacedAfter(writer, &placed, index++, depth);
+    }
+    writePlacedAfter(writer, &placed, INT_MAX, depth);
+}
+
+void writeCircList(SVGWriter* writer, List* circList, int depth){
+
+    if (circList == NULL) return;
+
+    PlacedCursor placed = placedCursor(writer, CIRC);
+    int index = 0;
+
+    void* elem;
+    ListIterator iter = createIterator(circList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Circle* circ = (Circle*) elem;
+
+        writeIndent(writer, depth);
+        writeBytes(writer, "<circle", 7);
+        bool dropZero = writer->options.dropDefaults;
+        if (dropZero == false || circ->cx != 0) writeNumberAttribute(writer, "cx", circ->cx, circ->units);
+        if (dropZero == false || circ->cy != 0) writeNumberAttribute(writer, "cy", circ->cy, circ->units);
+        writeNumberAttribute(writer, "r", circ->r, circ->units);
+        writeAttrList(writer, circ->otherAttributes);
+        writeBytes(writer, "/>", 2);
+        writeNewline(writer);
+        writePlacedAfter(writer, &placed, index++, depth);
+    }
+    writePlacedAfter(writer, &placed, INT_MAX, depth);
+}
+
+void writePathList(SVGWriter* writer, List* pathList, int depth){
+
+    if (pathList == NULL) return;
+
+    PlacedCursor placed = placedCursor(writer, PATH);
+    int index = 0;
+
+    void* elem;
+    ListIterator iter = createIterator(pathList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Path* path = (Path*) elem;
+
+        writeIndent(writer, depth);
+        writeBytes(writer, "<path", 5);
+        writeAttribute(writer, "d", path->data);
+        writeAttrList(writer, path->otherAttributes);
+        writeBytes(writer, "/>", 2);
+        writeNewline(writer);
+        writePlacedAfter(writer, &placed, index++, depth);
+    }
+    writePlacedAfter(writer, &placed, INT_MAX, depth);
+}
+
+// a line, ellipse, polyline or polygon
+void writeShape(SVGWriter* writer, void* shape, elementType type, int depth){
+
+    bool dropZero = writer->options.dropDefaults;
+
+    writeIndent(writer, depth);
+    writeBytes(writer, "<", 1);
+    writeString(writer, shapeElementName(type));
+
+    if (type == LINE){
+        // the coordinates are 0 when they are left out
+        Line* line = (Line*) shape;
+        if (dropZero == false || line->x1 != 0) writeNumberAttribute(writer, "x1", line->x1, line->units);
+        if (dropZero == false || line->y1 != 0) writeNumberAttribute(writer, "y1", line->y1, line->units);
+        if (dropZero == false || line->x2 != 0) writeNumberAttribute(writer, "x2", line->x2, line->units);
+        if (dropZero == false || line->y2 != 0) writeNumberAttribute(writer, "y2", line->y2, line->units);
+    }
+    else if (type == ELLIPSE){
+        Ellipse* ellipse = (Ellipse*) shape;
+        if (dropZero == false || ellipse->cx != 0) writeNumberAttribute(writer, "cx", ellipse->cx, ellipse->units);
+        if (dropZero == false || ellipse->cy != 0) writeNumberAttribute(writer, "cy", ellipse->cy, ellipse->units);
+        writeNumberAttribute(writer, "rx", ellipse->rx, ellipse->units);
+        writeNumberAttribute(writer, "ry", ellipse->ry, ellipse->units);
+    }
+    else{
+        char* points = pointsToString((Polyline*)shape, SVG_PRECISION_SHORTEST); // the same as the xml tree, see pointsToString
+        if (points == NULL) writer->failed = true;
+        else writeAttribute(writer, "points", points);
+        free(points);
+    }
+
+    writeAttrList(writer, shapeOtherAttributes(shape, type));
+    writeBytes(writer, "/>", 2);
+    writeNewline(writer);
+}
+
+// the lines, ellipses, polylines and polygons that were not read from a file, the others are written in their place
+void writeShapeList(SVGWriter* writer, List* list, elementType type, int depth){
+
+    if (list == NULL) return;
+
+    void* elem;
+    ListIterator iter = createIterator(list);
+    while ((elem = nextElement(&iter)) != NULL){
+        if (shapePlace(elem, type)->position < 0) writeShape(writer, elem, type, depth);
+    }
+}
+
+// where the element of a placed list was read, the raw elements are the first list
+static const ElementPlace* placeOf(void* elem, int list){
+
+    if (list == 0) return &((RawElement*) elem)->place;
+    return shapePlace(elem, LINE + list - 1);
+}
+
+// the next element of the placed list that comes after a child of the type, NULL when there are no more
+static void nextPlaced(PlacedCursor* cursor, int list){
+
+    void* elem;
+    while ((elem = nextElement(&cursor->iters[list])) != NULL){
+        const ElementPlace* place = placeOf(elem, list);
+        if (place->afterType == cursor->type && place->position >= 0){
+            cursor->next[list] = elem;
+            return;
+        }
+    }
+    cursor->next[list] = NULL;
+}
+
+// the elements of the placed lists of the svg or group being written that come after the children of the type
+PlacedCursor placedCursor(const SVGWriter* writer, elementType type){
+
+    PlacedCursor cursor = { .type = type };
+
+    for (int list = 0; list < SVG_PLACED_LISTS; ++list){
+        cursor.next[list] = NULL;
+        if (writer->placedLists[list] == NULL) continue;
+
+        cursor.iters[list] = createIterator(writer->placedLists[list]);
+        nextPlaced(&cursor, list);
+    }
+    return cursor;
+}
+
+/*
+    the elements with a place are written after the child of the type at index, with the ones after the children
+    before it that are not written yet, in the order they were read: the raw elements as they were read, each on its
+    own line, and the shapes like writeShape
+*/
+void writePlacedAfter(SVGWriter* writer, PlacedCursor* cursor, int index, int depth){
+
+    while (true){
+
+        // 1. the first one read of the next ones of the lists that go after the child
+        int first = -1;
+        for (int list = 0; list < SVG_PLACED_LISTS; ++list){
+            void* elem = cursor->next[list];
+            if (elem == NULL || placeOf(elem, list)->afterIndex > index) continue;
+            if (first < 0 || placeOf(elem, list)->position < placeOf(cursor->next[first], first)->position) first = list;
+        }
+        if (first < 0) return;
+
+        // 2. write it
+        if (first == 0){
+            RawElement* raw = (RawElement*) cursor->next[0];
+            writeIndent(writer, depth);
+            writeBytes(writer, raw->xml, raw->length);
+            writeNewline(writer);
+        }
+        else {
+            writeShape(writer, cursor->next[first], LINE + first - 1, depth);
+        }
+        nextPlaced(cursor, first);
+    }
+}
+
+// the lists of the svg or group whose children are written next with elements that have a place
+static void setPlacedLists(SVGWriter* writer, List* rawElements, List* lines, List* ellipses, List* polylines, List* polygons){
+
+    writer->placedLists[0] = rawElements;
+    writer->placedLists[1] = lines;
+    writer->placedLists[2] = ellipses;
+    writer->placedLists[3] = polylines;
+    writer->placedLists[4] = polygons;
+}
+
+// recursive, like addGroupListToParentNode, an empty group is written as <g/>
+void writeGroupList(SVGWriter* writer, List* groupList, int depth){
+
+    if (groupList == NULL) return;
+
+    PlacedCursor placed = placedCursor(writer, GROUP);
+    int index = 0;
+
+    void* elem;
+    ListIterator iter = createIterator(groupList);
+    while ((elem = nextElement(&iter)) != NULL){
+
+        Group* group = (Group*) elem;
+
+        writeIndent(writer, depth);
+        writeBytes(writer, "<g", 2);
+        writeAttrList(writer, group->otherAttributes);
+
+        if (numGroupChildren(group) == 0 && (group->otherElements == NULL || getLength(group->otherElements) == 0)){
+            writeBytes(writer, "/>", 2);
+            writeNewline(writer);
+            writePlacedAfter(writer, &placed, index++, depth);
+            continue;
+        }
+
+        writeBytes(writer, ">", 1);
+        writeNewline(writer);
+
+        // the children inherit what the group sets, as long as they are written, and the placed lists are the group's
+        unsigned parentSet = writer->inheritedSet;
+        List* parentLists[SVG_PLACED_LISTS];
+        memcpy(parentLists, writer->placedLists, sizeof(parentLists));
+        writer->inheritedSet = inheritedAttributeSet(group->otherAttributes, parentSet);
+        setPlacedLists(writer, group->otherElements, group->lines, group->ellipses, group->polylines, group->polygons);
+        PlacedCursor firstPlaced = placedCursor(writer, SVG_IMG);
+        writePlacedAfter(writer, &firstPlaced, INT_MAX, depth + 1);
+        writeRectList(writer, group->rectangles, depth + 1);
+        writeCircList(writer, group->circles, depth + 1);
+        writePathList(writer, group->paths, depth + 1);
+        writeShapeList(writer, group->lines, LINE, depth + 1);
+        writeShapeList(writer, group->ellipses, ELLIPSE, depth + 1);
+        writeShapeList(writer, group->polylines, POLYLINE, depth + 1);
+        writeShapeList(writer, group->polygons, POLYGON, depth + 1);
+        writeGroupList(writer, group->groups, depth + 1);
+        writer->inheritedSet = parentSet;
+        memcpy(writer->placedLists, parentLists, sizeof(parentLists));
+
+        writeIndent(writer, depth);
+        writeBytes(writer, "</g>", 4);
+        writeNewline(writer);
+        writePlacedAfter(writer, &placed, index++, depth);
+    }
+    writePlacedAfter(writer, &placed, INT_MAX, depth);
+}
+
+/*
+    writes the whole document in the same order as createXMLFromStruct:
+    the svg attributes, then the title, description, rectangles, circles, paths, lines, ellipses, polylines, polygons
+    and groups, with each raw element and each shape read from a file after the child it was read after
+*/
+void writeSVGStruct(SVGWriter* writer, const SVG* img){
+
+    writeString(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+
+    writeBytes(writer, "<svg", 4);
+    writeAttribute(writer, "xmlns", img->namespace);
+    writeAttrList(writer, img->otherAttributes);
+
+    bool hasChildren = (strlen(img->title) != 0) || (strlen(img->description) != 0) ||
+                       getLength(img->rectangles) != 0 || getLength(img->circles) != 0 || getLength(img->paths) != 0 || getLength(img->groups) != 0 ||
+                       (img->otherElements != NULL && getLength(img->otherElements) != 0) ||
+                       (img->lines != NULL && getLength(img->lines) != 0) || (img->ellipses != NULL && getLength(img->ellipses) != 0) ||
+                       (img->polylines != NULL && getLength(img->polylines) != 0) || (img->polygons != NULL && getLength(img->polygons) != 0);
+    if (hasChildren == false){
+        writeBytes(writer, "/>\n", 3);
+        return;
+    }
+
+    writeBytes(writer, ">", 1);
+    writeNewline(writer);
+    writer->inheritedSet = inheritedAttributeSet(img->otherAttributes, documentInheritedSet(img));
+    setPlacedLists(writer, img->otherElements, img->lines, img->ellipses, img->polylines, img->polygons);
+
+    // the elements after the title and desc are counted by how many of them they were read after
+    PlacedCursor placed = placedCursor(writer, SVG_IMG);
+    int texts = 0;
+    writePlacedAfter(writer, &placed, texts, 1);
+    if (strlen(img->title) != 0){
+        writeTextElement(writer, "title", img->title, 1);
+        writePlacedAfter(writer, &placed, ++texts, 1);
+    }
+    if (strlen(img->description) != 0){
+        writeTextElement(writer, "desc", img->description, 1);
+        writePlacedAfter(writer, &placed, ++texts, 1);
+    }
+    writePlacedAfter(writer, &placed, INT_MAX, 1);
+
+    writeRectList(writer, img->rectangles, 1);
+    writeCircList(writer, img->circles, 1);
+    writePathList(writer, img->paths, 1);
+    writeShapeList(writer, img->lines, LINE, 1);
+    writeShapeList(writer, img->ellipses, ELLIPSE, 1);
+    writeShapeList(writer, img->polylines, POLYLINE, 1);
+    writeShapeList(writer, img->polygons, POLYGON, 1);
+    writeGroupList(writer, img->groups, 1);
+    setPlacedLists(writer, NULL, NULL, NULL, NULL, NULL);
+    writeBytes(writer, "</svg>\n", 7);
+}
@@ -0,0 +1,374 @@
+// Name: Haifaa Abushaaban
+
+#define _POSIX_C_SOURCE 200809L // mkdtemp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "LinkedListAPI.h"
+#include "SVGParser.h"
+#include "SVGHelperJSON.h"
+#include "SVGPathData.h"
+#include "SVGJournal.h"
+#include "SVGElementPath.h"
+#include "SVGSelector.h"
+#include "SVGPatch.h"
+#include "SVGAreaIndex.h"
+#include "SVGPathStore.h"
+
+/*
+    Tests of the parts of the parser that read and write their own formats: the JSON the server sends, the path
+    data, the records of the edit journal, element paths, selectors and the byte spans of a patch.
+    Each one is given malformed input, and what it writes is read back. Built and run by "make test".
+*/
+
+static int checks = 0;
+static int failures = 0;
+static char tempDir[] = "/tmp/svgtestsXXXXXX";
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+static void check(bool passed, const char* text, int line){
+
+    ++checks;
+    if (passed) return;
+
+    ++failures;
+    printf("FAILED line %d: %s\n", line, text);
+}
+
+// true if the string is not NULL and is the expected text, the string is freed
+static bool sameString(char* string, const char* expected){
+
+    bool same = (string != NULL && strcmp(string, expected) == 0);
+    if (string != NULL && same == false) printf("    got: %s\n", string);
+    free(string);
+    return same;
+}
+
+// writes the text into a file in the temp directory, the caller must free the name
+static char* tempFile(const char* name, const char* text){
+
+    char* fileName = malloc(strlen(tempDir) + strlen(name) + 2); // 1 for / and 1 for null
+    if (fileName == NULL) return NULL;
+    sprintf(fileName, "%s/%s", tempDir, name);
+
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL){
+        free(fileName);
+        return NULL;
+    }
+    fputs(text, file);
+    fclose(file);
+    return fileName;
+}
+
+static const char* sampleSVG =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"100\">\n"
+    "  <title>sample</title>\n"
+    "  <rect x=\"1\" y=\"2\" width=\"20\" height=\"10\" fill=\"red\"/>\n"
+    "  <circle cx=\"5\" cy=\"5\" r=\"2\"/>\n"
+    "  <path d=\"M0 0L10 10\"/>\n"
+    "  <g id=\"outer\">\n"
+    "    <rect x=\"0\" y=\"0\" width=\"5\" height=\"4\"/>\n"
+    "    <g><rect x=\"0\" y=\"0\" width=\"20\" height=\"10\" fill=\"blue\"/><path d=\"m0 0l10 10\"/></g>\n"
+    "  </g>\n"
+    "</svg>\n";
+
+// 1. the JSON reader
+static void testJSON(void){
+
+    const char* object = "{\"name\":\"a\\\"b\\u00e9\",\"n\":12.5,\"list\":[1,{\"x\":2}],\"inner\":{\"k\":\"v\"},\"t\":true}";
+
+    CHECK(sameString(getJSONValue(object, "name"), "a\"b\xc3\xa9"));
+    CHECK(sameString(getJSONValue(object, "list"), "[1,{\"x\":2}]"));
+    CHECK(sameString(getJSONValue(object, "inner"), "{\"k\":\"v\"}"));
+    CHECK(sameString(getJSONValue(object, "t"), "true"));
+    CHECK(getJSONValue(object, "k") == NULL); // only the keys of the object itself
+    CHECK(getJSONValue(object, "missing") == NULL);
+
+    float number = 0;
+    int integer = 0;
+    CHECK(getJSONFloat(object, "n", &number) && number == 12.5f);
+    CHECK(getJSONInt(object, "name", &integer) == false);
+
+    // the objects of an array, one at a time
+    const char* array = "[ {\"a\":1} , {\"b\":\"}\"} ]";
+    const char* cursor = array;
+    CHECK(sameString(nextJSONObject(&cursor), "{\"a\":1}"));
+    CHECK(sameString(nextJSONObject(&cursor), "{\"b\":\"}\"}"));
+    CHECK(nextJSONObject(&cursor) == NULL);
+
+    // malformed input
+    const char* badEscape = "\"a\\qb\"";
+    const char* loneSurrogate = "\"\\ud800\"";
+    const char* shortHex = "\"\\u12\"";
+    CHECK(copyJSONString(badEscape, badEscape + strlen(badEscape)) == NULL);
+    CHECK(copyJSONString(loneSurrogate, loneSurrogate + strlen(loneSurrogate)) == NULL);
+    CHECK(copyJSONString(shortHex, shortHex + strlen(shortHex)) == NULL);
+    CHECK(getJSONValue("{\"a\":", "a") == NULL);
+    CHECK(getJSONValue("{\"a\" 1}", "a") == NULL);
+    CHECK(getJSONValue("", "a") == NULL);
+
+    // a surrogate pair is one character
+    const char* pair = "\"\\ud83d\\ude00\"";
+    CHECK(sameString(copyJSONString(pair, pair + strlen(pair)), "\xf0\x9f\x98\x80"));
+}
+
+// the path data is read back from the text it is written as
+static bool pathRoundTrip(const char* data, const char* expected){
+
+    PathData* first = parsePathData(data);
+    if (first == NULL) return false;
+
+    char* text = pathDataToString(first);
+    PathData* second = (text != NULL) ? parsePathData(text) : NULL;
+
+    bool same = (second != NULL && first->numCommands == second->numCommands && first->numCoords == second->numCoords);
+    same = same && memcmp(first->commands, second->commands, first->numCommands) == 0;
+    for (int i = 0; same && i < first->numCoords; ++i){
+        same = (first->coords[i] == second->coords[i]);
+    }
+    same = same && sameString(text, expected);
+
+    free(first);
+    free(second);
+    return same;
+}
+
+// 2. the path data tokenizer and shortest serializer
+static void testPathData(void){
+
+    CHECK(pathRoundTrip("M 10,20 L 30 40 L 50 60 Z", "M10 20 30 40 50 60Z"));
+    CHECK(pathRoundTrip("m1.5.5l-2-3h4v-1e1z", "m1.5.5-2-3h4v-10z"));
+    CHECK(pathRoundTrip("M0 0C1 2 3 4 5 6S7 8 9 10Q1 1 2 2T3 3", "M0 0C1 2 3 4 5 6S7 8 9 10Q1 1 2 2T3 3"));
+    CHECK(pathRoundTrip("M0 0A5 5 0 1 0 10 10a1 1 0 0 1 2 2", "M0 0A5 5 0 1 0 10 10a1 1 0 0 1 2 2"));
+
+    PathData* pathData = parsePathData("M0 0L10 10 20 20");
+    CHECK(pathData != NULL && pathData->numCommands == 3 && pathData->numCoords == 6);
+    CHECK(pathData != NULL && strncmp(pathData->commands, "MLL", 3) == 0);
+    free(pathData);
+
+    // malformed input
+    CHECK(parsePathData("L10 10") == NULL);         // must start with a move to
+    CHECK(parsePathData("M10") == NULL);            // a number short
+    CHECK(parsePathData("M0 0X1 1") == NULL);       // no such command
+    CHECK(parsePathData("M0 0A1 1 0 2 0 5 5") == NULL); // a flag is 0 or 1
+    CHECK(parsePathData("M0 0L1") == NULL);
+}
+
+// the svg of the file with the records of its journal applied, like createValidSVG
+static SVG* journaledSVG(const char* fileName, int* applied){
+
+    SVG* img = createSVG(fileName);
+    *applied = (img != NULL) ? replayJournal(img, fileName) : -1;
+    return img;
+}
+
+// 3. the records of the edit journal
+static void testJournal(void){
+
+    char* fileName = tempFile("journal.svg", sampleSVG);
+    CHECK(fileName != NULL);
+    if (fileName == NULL) return;
+
+    const char* edits = "[{\"op\":\"title\",\"value\":\"changed\"},{\"op\":\"add\",\"type\":\"circle\",\"cx\":1,\"cy\":2,\"r\":3}]";
+    CHECK(appendJournal(fileName, edits, 1000));
+    CHECK(appendJournal(fileName, "[{\"op\":\"bogus\"}]", 1000) == false);
+    CHECK(appendJournal(fileName, "[{\"op\":\"title\",\"value\":\"x\"}", 1000) == false); // the array is not closed
+
+    // every record is read back as it was written
+    char* name = journalName(fileName);
+    FILE* file = fopen(name, "rb");
+    CHECK(file != NULL);
+    if (file != NULL){
+        JournalRecord record;
+        CHECK(sameString(readJournalRecord(file, &record), "{\"op\":\"title\",\"value\":\"changed\"}"));
+        CHECK(record.op == JOURNAL_TITLE && record.time == 1000);
+        CHECK(sameString(readJournalRecord(file, &record), "{\"op\":\"add\",\"type\":\"circle\",\"cx\":1,\"cy\":2,\"r\":3}"));
+        CHECK(record.op == JOURNAL_ADD);
+        CHECK(readJournalRecord(file, &record) == NULL);
+        fclose(file);
+    }
+    CHECK(journalStarted(fileName) == 1000);
+    CHECK(journalValidLength(fileName) == journalSize(fileName));
+
+    // the edits are applied to the svg they were made for
+    int applied = 0;
+    SVG* img = journaledSVG(fileName, &applied);
+    CHECK(img != NULL && applied == 2);
+    if (img != NULL){
+        CHECK(strcmp(img->title, "changed") == 0);
+        CHECK(getLength(img->circles) == 2);
+        deleteSVG(img);
+    }
+
+    // a record that was cut off ends the journal, and the next edits are written over it
+    long whole = journalSize(fileName);
+    file = fopen(name, "ab");
+    if (file != NULL){
+        fwrite("SVGJ garbage", 1, 12, file);
+        fclose(file);
+    }
+    CHECK(journalValidLength(fileName) == whole);
+    CHECK(appendJournal(fileName, "[{\"op\":\"description\",\"value\":\"d\"}]", 1001));
+    img = journaledSVG(fileName, &applied);
+    CHECK(img != NULL && applied == 3 && strcmp(img->description, "d") == 0 && getLength(img->circles) == 2);
+    deleteSVG(img);
+
+    // once the svg is written with the edits the records are skipped, even when the journal is left behind
+    char* kept = journalName(name);
+    img = journaledSVG(fileName, &applied);
+    CHECK(rename(name, kept) == 0);
+    CHECK(img != NULL && writeSVG(img, fileName));
+    deleteSVG(img);
+    CHECK(rename(kept, name) == 0);
+    img = journaledSVG(fileName, &applied);
+    CHECK(img != NULL && applied == 0 && strcmp(img->title, "changed") == 0 && getLength(img->circles) == 2);
+    deleteSVG(img);
+    CHECK(sameString(journalToJSON(fileName), "[]"));
+
+    CHECK(journalOpNamed("Scale") == JOURNAL_SCALE && journalOpNamed("nothing") == JOURNAL_UNKNOWN);
+    CHECK(removeJournal(fileName) && journalExists(fileName) == false);
+
+    remove(fileName);
+    free(kept);
+    free(name);
+    free(fileName);
+}
+
+// 4. the element path resolver
+static void testElementPath(SVG* img){
+
+    ElementPath resolved;
+    CHECK(resolveElementPath(img, "", &resolved) && resolved.type == SVG_IMG && resolved.element == img);
+    CHECK(resolveElementPath(img, "svg", &resolved) && resolved.type == SVG_IMG);
+    CHECK(resolveElementPath(img, "rect0", &resolved) && resolved.type == RECT && resolved.parent == NULL);
+    CHECK(resolved.element == getFromFront(img->rectangles));
+
+    CHECK(resolveElementPath(img, "g0/g0/path0", &resolved) && resolved.type == PATH && resolved.index == 0);
+    CHECK(resolved.parent != NULL && resolved.element == getFromFront(resolved.parent->paths));
+    CHECK(resolveElementPath(img, "g0/rect0", &resolved) && ((Rectangle*)resolved.element)->width == 5);
+
+    // malformed paths, and elements that are not there
+    CHECK(resolveElementPath(img, "rect1", &resolved) == false);
+    CHECK(resolveElementPath(img, "rect0/circle0", &resolved) == false); // only a group has children
+    CHECK(resolveElementPath(img, "g0//rect0", &resolved) == false);
+    CHECK(resolveElementPath(img, "rect", &resolved) == false);
+    CHECK(resolveElementPath(img, "rect-1", &resolved) == false);
+    CHECK(resolveElementPath(img, "square0", &resolved) == false);
+}
+
+// 5. the selector compiler
+static void testSelector(SVG* img){
+
+    CHECK(countSelectorMatches(img, "rect") == 3);
+    CHECK(countSelectorMatches(img, "rect[width>10]") == 2);
+    CHECK(countSelectorMatches(img, "g > rect[fill=blue]") == 1);
+    CHECK(countSelectorMatches(img, "svg > rect") == 1);
+    CHECK(countSelectorMatches(img, "g g path, circle") == 2);
+    CHECK(countSelectorMatches(img, "g[id^=out]") == 1);
+    CHECK(countSelectorMatches(img, "rect[area=200]") == 2);
+    CHECK(countSelectorMatches(img, "*[fill]") == 2);
+    CHECK(sameString(selectToJSON(img, "g rect[fill='blue']"), "[{\"path\":\"g0/g0/rect0\",\"type\":\"rect\"}]"));
+
+    Selector* selector = compileSelector("g > rect, path");
+    CHECK(selector != NULL && selector->numChains == 2);
+    CHECK(selector != NULL && selector->typeMask == (SVG_ELEMENT_MASK(RECT) | SVG_ELEMENT_MASK(PATH)));
+    CHECK(selector != NULL && selector->chains[0].numSteps == 2 && selector->chains[0].steps[1].child);
+    deleteSelector(selector);
+
+    // malformed selectors
+    CHECK(compileSelector("") == NULL);
+    CHECK(compileSelector("rect[") == NULL);
+    CHECK(compileSelector("rect[width>]") == NULL);
+    CHECK(compileSelector("square") == NULL);
+    CHECK(compileSelector("rect,") == NULL);
+    CHECK(compileSelector("> rect") == NULL);
+    CHECK(countSelectorMatches(img, "rect[x=\"1]") < 0);
+}
+
+// 6. the byte span scanner of a patch
+static void testPatchSpans(void){
+
+    SVGSpans spans;
+    spans.data = sampleSVG;
+    spans.length = strlen(sampleSVG);
+    spans.targetType = RECT;
+    spans.targetIndex = 0;
+    CHECK(scanSVGSpans(&spans));
+    CHECK(spans.numTitles == 1 && spans.numDescs == 0 && spans.title.selfClosing == false && spans.title.simple);
+    CHECK(strncmp(sampleSVG + spans.title.content.start, "sample", spans.title.content.end - spans.title.content.start) == 0);
+    CHECK(spans.targetFound && spans.target.selfClosing);
+
+    ByteSpan value;
+    CHECK(findAttributeSpan(sampleSVG, &(spans.target), "fill", &value));
+    CHECK(value.end - value.start == 5 && strncmp(sampleSVG + value.start, "\"red\"", 5) == 0);
+    CHECK(findAttributeSpan(sampleSVG, &(spans.target), "stroke", &value) == false);
+
+    // the groups are numbered like the struct, the first group is the outer one
+    spans.targetType = GROUP;
+    spans.targetIndex = 1;
+    CHECK(scanSVGSpans(&spans) && spans.targetFound == false);
+    spans.targetIndex = 0;
+    CHECK(scanSVGSpans(&spans) && spans.targetFound && findAttributeSpan(sampleSVG, &(spans.target), "id", &value));
+
+    // files the scan does not handle
+    const char* doctype = "<?xml version=\"1.0\"?><!DOCTYPE svg [<!ENTITY e \"x\">]><svg xmlns=\"http://www.w3.org/2000/svg\"/>";
+    const char* latin = "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><svg xmlns=\"http://www.w3.org/2000/svg\"/>";
+    const char* unclosed = "<svg xmlns=\"http://www.w3.org/2000/svg\"><title>t</title>";
+    const char* inputs[] = { doctype, latin, unclosed, "" };
+    for (int i = 0; i < 4; ++i){
+        spans.data = inputs[i];
+        spans.length = strlen(inputs[i]);
+        spans.targetType = SVG_IMG;
+        spans.targetIndex = -1;
+        CHECK(scanSVGSpans(&spans) == false);
+    }
+}
+
+// 7. a repeated query reads the index it made, it is not made again
+static void testIndexes(SVG* img){
+
+    AreaIndex* areas = getAreaIndex(img);
+    CHECK(areas != NULL && areaIndexCurrent(img));
+    CHECK(numRectsWithArea(img, 200) == 2 && numCirclesWithArea(img, 12.57) == 1);
+    CHECK(getAreaIndex(img) == areas && areaIndexCurrent(img));
+
+    PathCounts* counts = getPathCounts(img);
+    CHECK(counts != NULL && pathCountsCurrent(img));
+    CHECK(numPathsWithdata(img, "M0 0L10 10") == 2);
+    CHECK(getPathCounts(img) == counts && pathCountsCurrent(img));
+}
+
+int main(void){
+
+    if (mkdtemp(tempDir) == NULL){
+        printf("could not make a temp directory\n");
+        return 1;
+    }
+
+    testJSON();
+    testPathData();
+    testJournal();
+    testPatchSpans();
+
+    char* fileName = tempFile("sample.svg", sampleSVG);
+    SVG* img = (fileName != NULL) ? createSVG(fileName) : NULL;
+    CHECK(img != NULL);
+    if (img != NULL){
+        testElementPath(img);
+        testSelector(img);
+        testIndexes(img);
+        deleteSVG(img);
+    }
+    if (fileName != NULL) remove(fileName);
+    free(fileName);
+    rmdir(tempDir);
+
+    printf("%d of %d checks passed\n", checks - failures, checks);
+    return (failures == 0) ? 0 : 1;
+}
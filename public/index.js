@@ -169,6 +169,79 @@ jQuery(document).ready(function() {
         });
     };
 
+    document.getElementById('sPath').onclick = function () {
+        let newScale = parseFloat(document.getElementById('scaleValue').value);
+        if (isNaN(newScale)){
+            alert("Not a number");
+            return;
+        }
+        let selectedVal = jQuery("#svg").children("option:selected").val();
+        let fileName = "uploads/" + selectedVal;
+        jQuery.ajax({
+            type: 'get',
+            dataType: 'json',
+            url: '/scalePaths',
+            data: {
+              info: fileName,
+              newScale: newScale
+            },
+            success: function (data) {
+                if (data.success == false){
+                    console.log("Scaling paths was not successful, no changes made to file");
+                    alert("Change not successful");
+                }
+                else{
+                    alert("Change successful");
+                    location.reload(true);
+                }
+            },
+            fail: function(error) {
+                alert(error);
+            }
+        });
+    };
+
+    document.getElementById('transformAll').onclick = function () {
+        let newScale = parseFloat(document.getElementById('scaleValue').value);
+        let translateX = parseFloat(document.getElementById('translateX').value);
+        let translateY = parseFloat(document.getElementById('translateY').value);
+        let angle = parseFloat(document.getElementById('rotateAngle').value);
+        if (isNaN(newScale)){
+            newScale = 1; // only rotate and translate
+        }
+        if (isNaN(translateX) || isNaN(translateY) || isNaN(angle)){
+            alert("Not a number");
+            return;
+        }
+        let selectedVal = jQuery("#svg").children("option:selected").val();
+        let fileName = "uploads/" + selectedVal;
+        jQuery.ajax({
+            type: 'get',
+            dataType: 'json',
+            url: '/transformComponents',
+            data: {
+              info: fileName,
+              translateX: translateX,
+              translateY: translateY,
+              angle: angle,
+              newScale: newScale
+            },
+            success: function (data) {
+                if (data.success == false){
+                    console.log("Transforming shapes was not successful, no changes made to file");
+                    alert("Change not successful");
+                }
+                else{
+                    alert("Change successful");
+                    location.reload(true);
+                }
+            },
+            fail: function(error) {
+                alert(error);
+            }
+        });
+    };
+
     document.getElementById('viewAttr').onclick = function () {
 
         // 1. if no otherAttributes, alert
@@ -535,14 +608,28 @@ function loadFileLog(data){
             jQuery("#svg").append(newOption);
             jQuery("#svgShape").append(newOption);
 
-            // c. place in a row in a table
-            let newRow = "<tr><td><a href=\"" + data.info[i].fileName + "\" download><img src=\"" + data.info[i].fileName + "\" class=\"logImage\" /></a></td><td><a href=\"" + data.info[i].fileName + "\" download>" + file + "</a></td><td>" + data.info[i].fileSize + "KB</td><td>" + data.info[i].numbers.numRect + "</td><td>" + data.info[i].numbers.numCirc + "</td><td>" + data.info[i].numbers.numPaths + "</td><td>" + data.info[i].numbers.numGroups + "</td></tr>";
+            // c. place in a row in a table, compressed files also show the size of the svg in them
+            let size = data.info[i].fileSize + "KB";
+            if (data.info[i].uncompressedSize != data.info[i].fileSize) {
+                size += " (" + data.info[i].uncompressedSize + "KB uncompressed)";
+            }
+            let newRow = "<tr><td><a href=\"" + data.info[i].fileName + "\" download><img src=\"" + framedImage(data.info[i].fileName, data.info[i].numbers.bounds) + "\" class=\"logImage\" /></a></td><td><a href=\"" + data.info[i].fileName + "\" download>" + file + "</a></td><td>" + size + "</td><td>" + data.info[i].numbers.numRect + "</td><td>" + data.info[i].numbers.numCirc + "</td><td>" + data.info[i].numbers.numPaths + "</td><td>" + data.info[i].numbers.numGroups + "</td></tr>";
             jQuery("#fileLog").append(newRow);
         }
     }
 
 }
 
+// The image of a file shown around the box of its shapes, the box comes from the parser so nothing is measured here
+function framedImage(fileName, bounds){
+
+    if (bounds == null || bounds.w <= 0 || bounds.h <= 0) {
+        return fileName;
+    }
+    return fileName + "#svgView(viewBox(" + bounds.x + "," + bounds.y + "," + bounds.w + "," + bounds.h + "))";
+
+}
+
 function viewSVG(fileName){
 
     jQuery("#fileChange").html("Edit " + fileName.split('/').pop());
@@ -553,7 +640,8 @@ function viewSVG(fileName){
         dataType: 'json',       //Data type - we will use JSON for almost everything
         url: '/fileInfo',       //The server endpoint we are connecting to
         data: {
-          info: fileName
+          info: fileName,
+          shapes: false         //The components are loaded a page at a time by loadComponentPages
         },
         success: function (data) {
 
@@ -564,11 +652,10 @@ function viewSVG(fileName){
             else{
                 // 2. place a table
                 // a. image, title description
-                let imageString = "<img src=\"" + fileName + "\" class=\"svgImage\"/>";
+                let imageString = "<img src=\"" + framedImage(fileName, data.info.bounds) + "\" class=\"svgImage\"/>";
                 jQuery("#svgViewImg").html(imageString);
                 jQuery("#titleText").html(data.info.title);
                 jQuery("#descText").html(data.info.description);
-                let table = "";
 
                 // 3. for the functionality part of other attributes
                 let selectionOA = "<label for=\"componentLabel\">Choose a component: </label><select id=\"components\"></select>";
@@ -579,54 +666,108 @@ function viewSVG(fileName){
                 let newOption = "<option value=\"SVG\">" + svg + "</option>";
                 jQuery("#components").append(newOption);
 */
-                // b. components to access
-                let rectIndex = 1;
-                for (let i of data.info.rectangles){
-                    let data = "Upper left corner: x = " + i.x + i.units + ", y = " + i.y + i.units + ", width = " + i.w + i.units + ", height = " + i.h + i.units;
-                    let otherAttrNum = i.numAttr;
-                    let newRow = "<tr><td>Rectangle " + rectIndex + "</td><td id=\"rect" + rectIndex + "D\">" + data + "</td><td id=\"rect" + rectIndex + "OA\">" + otherAttrNum + "</td></tr>";
-                    table = table + newRow;
-
-                    // only add those that have components
-                    let newOption = "<option value=\"rect" + rectIndex + "\">Rectangle " + rectIndex + "</option>";
-                    jQuery("#components").append(newOption);
-                    ++rectIndex;
-                }
-                let circIndex = 1;
-                for (let i of data.info.circles){
-                    let data = "Centre: cx = " + i.cx + i.units + ", cy = " + i.cy + i.units + ", r = " + i.r + i.units;
-                    let otherAttrNum = i.numAttr;
-                    let newRow = "<tr><td>Circle " + circIndex + "</td><td id=\"circ" + circIndex + "D\">" + data + "</td><td id=\"circ" + circIndex + "OA\">" + otherAttrNum + "</td></tr>";
-                    table = table + newRow;
-
-                    let newOption = "<option value=\"circ" + circIndex + "\">Circle " + circIndex + "</option>";
-                    jQuery("#components").append(newOption);
-                    ++circIndex;
+                // b. components to access, one page of each type, loaded in order so the drop down stays sorted
+                for (let component of componentOrder){
+                    jQuery("#" + componentViews[component].id + "BodySVG").html("");
                 }
-                let pathIndex = 1;
-                for (let i of data.info.paths){
-                    let data = "d = " + i.d;
-                    let otherAttrNum = i.numAttr;
-                    let newRow = "<tr><td>Path " + pathIndex + "</td><td id=\"path" + pathIndex + "D\">" + data + "</td><td id=\"path" + pathIndex + "OA\">" + otherAttrNum + "</td></tr>";
-                    table = table + newRow;
-
-                    let newOption = "<option value=\"path" + pathIndex + "\">Path " + pathIndex + "</option>";
+                loadComponentPages(fileName, 0, 0);
+            }
+        },
+        fail: function(error) {
+            alert(error);
+        }
+    });
+
+}
+
+// Number of components of each type shown before the "Show more" button
+const PAGE_SIZE = 50;
+
+// How each type of component is shown in the svg view panel
+const componentOrder = ["Rectangle", "Circle", "Path", "Group"];
+const componentViews = {
+    Rectangle: {
+        id: "rect",
+        summary: function (i) {
+            return "Upper left corner: x = " + i.x + i.units + ", y = " + i.y + i.units + ", width = " + i.w + i.units + ", height = " + i.h + i.units;
+        }
+    },
+    Circle: {
+        id: "circ",
+        summary: function (i) {
+            return "Centre: cx = " + i.cx + i.units + ", cy = " + i.cy + i.units + ", r = " + i.r + i.units;
+        }
+    },
+    Path: {
+        id: "path",
+        summary: function (i) {
+            return "d = " + i.d;
+        }
+    },
+    Group: {
+        id: "group",
+        summary: function (i) {
+            return i.children + " child elements";
+        }
+    }
+};
+
+// Loads the first page of every component type starting at componentOrder[typeIndex], one after the other
+function loadComponentPages(fileName, typeIndex, offset){
+
+    if (typeIndex >= componentOrder.length){
+        return;
+    }
+    loadComponentPage(fileName, componentOrder[typeIndex], offset, function () {
+        loadComponentPages(fileName, typeIndex + 1, 0);
+    });
+
+}
+
+// Adds a page of one type of component to the table and the drop down menu
+function loadComponentPage(fileName, component, offset, done){
+
+    let view = componentViews[component];
+    jQuery.ajax({
+        type: 'get',
+        dataType: 'json',
+        url: '/fileComponents',
+        data: {
+          info: fileName,
+          component: component,
+          offset: offset,
+          limit: PAGE_SIZE
+        },
+        success: function (data) {
+            if (data.page == null){
+                console.log("Error getting the " + component + " components");
+            }
+            else{
+                // 1. a row and an option for each component, numbered across pages
+                let table = "";
+                for (let i = 0; i < data.page.items.length; ++i){
+                    let index = data.page.offset + i + 1;
+                    let item = data.page.items[i];
+                    table = table + "<tr><td>" + component + " " + index + "</td><td id=\"" + view.id + index + "D\">" + view.summary(item) + "</td><td id=\"" + view.id + index + "OA\">" + item.numAttr + "</td></tr>";
+
+                    let newOption = "<option value=\"" + view.id + index + "\">" + component + " " + index + "</option>";
                     jQuery("#components").append(newOption);
-                    ++pathIndex;
                 }
-                let groupIndex = 1;
-                for (let i of data.info.groups){
-                    let data = i.children + " child elements";
-                    let otherAttrNum = i.numAttr;
-                    let newRow = "<tr><td>Group " + groupIndex + "</td><td id=\"group" + groupIndex + "D\">" + data + "</td><td id=\"group" + groupIndex + "OA\">" + otherAttrNum + "</td></tr>";
-                    table = table + newRow;
-
-                    let newOption = "<option value=\"group" + groupIndex + "\">Group " + groupIndex + "</option>";
-                    jQuery("#components").append(newOption);
-                    ++groupIndex;
+
+                // 2. a button for the next page, if there is one
+                let shown = data.page.offset + data.page.items.length;
+                if (shown < data.page.total){
+                    table = table + "<tr id=\"" + view.id + "More\"><td colspan=\"3\"><button type=\"button\">Show more (" + shown + " of " + data.page.total + ")</button></td></tr>";
                 }
+                jQuery("#" + view.id + "BodySVG").append(table);
 
-                jQuery("#dynamicBodySVG").html(table);
+                jQuery("#" + view.id + "More button").click(function () {
+                    jQuery("#" + view.id + "More").remove();
+                    loadComponentPage(fileName, component, shown, null);
+                });
+            }
+            if (done != null){
+                done();
             }
         },
         fail: function(error) {